@@ -0,0 +1,293 @@
+//
+//  BenchAlgorithm.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/Algorithm.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Algorithm benchmarks (data:: kernels against the std:: equivalents)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+template <Arithmetic Type_>
+std::vector<Type_> make_values(int64_t count)
+{
+    auto engine = std::mt19937{ 0x5eed };
+    auto values = std::vector<Type_>( count );
+
+    for ( auto& value : values ) {
+        value = static_cast<Type_>( engine() % 100 );
+    }
+
+    return values;
+}
+
+template <Arithmetic Type_>
+void set_counters(benchmark::State& state)
+{
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+    state.SetBytesProcessed( state.iterations() * state.range(0) * sizeof(Type_) );
+}
+
+//===------------------------------------------------------------------------===
+// • find (the value is absent, so the whole range is scanned)
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_find(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::find(values, Type_(101)) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_find(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::find(values.begin(), values.end(), Type_(101)) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • count
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_count(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::count(values, Type_(50)) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_count(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::count(values.begin(), values.end(), Type_(50)) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • min
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_min(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::min(values) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_min_element(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::min_element(values.begin(), values.end()) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • sum
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_sum(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::sum(values) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_accumulate(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::accumulate(values.begin(), values.end(), sum_type<Type_>{ 0 }) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • fill
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_fill(benchmark::State& state)
+{
+    auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        data::fill( values, Type_(7) );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_fill(benchmark::State& state)
+{
+    auto values = make_values<Type_>( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        std::fill( values.begin(), values.end(), Type_(7) );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • mismatch (the ranges are equal, so both are scanned)
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_mismatch(benchmark::State& state)
+{
+    const auto lhs = make_values<Type_>( state.range(0) );
+    const auto rhs = lhs;
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::mismatch(lhs, rhs) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_mismatch(benchmark::State& state)
+{
+    const auto lhs = make_values<Type_>( state.range(0) );
+    const auto rhs = lhs;
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::mismatch(lhs.begin(), lhs.end(), rhs.begin()) );
+    }
+
+    set_counters<Type_>(state);
+}
+
+//===------------------------------------------------------------------------===
+// • copy_if (about half of the elements are copied)
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+void BM_data_copy_if(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+    auto dest         = std::vector<Type_>( values.size() );
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( data::copy_if(values, Compare::less, Type_(50), dest.data()) );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters<Type_>(state);
+}
+
+template <Arithmetic Type_>
+void BM_std_copy_if(benchmark::State& state)
+{
+    const auto values = make_values<Type_>( state.range(0) );
+    auto dest         = std::vector<Type_>( values.size() );
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( std::copy_if(values.begin(), values.end(), dest.begin(), [](auto value) {
+            return value < Type_(50);
+        }) );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters<Type_>(state);
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration, from L1 resident to DRAM resident
+//===------------------------------------------------------------------------===
+
+#define DATA_BENCHMARK_ALGORITHM(name_)                                         \
+    BENCHMARK_TEMPLATE(name_, int32_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 24); \
+    BENCHMARK_TEMPLATE(name_, float)->RangeMultiplier(16)->Range(1 << 10, 1 << 24)
+
+DATA_BENCHMARK_ALGORITHM( BM_data_find );
+DATA_BENCHMARK_ALGORITHM( BM_std_find );
+DATA_BENCHMARK_ALGORITHM( BM_data_count );
+DATA_BENCHMARK_ALGORITHM( BM_std_count );
+DATA_BENCHMARK_ALGORITHM( BM_data_min );
+DATA_BENCHMARK_ALGORITHM( BM_std_min_element );
+DATA_BENCHMARK_ALGORITHM( BM_data_sum );
+DATA_BENCHMARK_ALGORITHM( BM_std_accumulate );
+DATA_BENCHMARK_ALGORITHM( BM_data_fill );
+DATA_BENCHMARK_ALGORITHM( BM_std_fill );
+DATA_BENCHMARK_ALGORITHM( BM_data_mismatch );
+DATA_BENCHMARK_ALGORITHM( BM_std_mismatch );
+DATA_BENCHMARK_ALGORITHM( BM_data_copy_if );
+DATA_BENCHMARK_ALGORITHM( BM_std_copy_if );
@@ -0,0 +1,262 @@
+//
+//  BenchAllocation.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/Allocation.hpp>
+
+#include <chrono>
+#include <memory>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Allocation benchmarks
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+constexpr auto max_buffer_length = uint32_t{ 1 << 30 };
+
+// • Divides the free region after the data atom into count 'vctr' atoms of
+//   length, in one pass rather than one first-fit reservation each
+//
+Atom* carve(Atom* data, uint32_t count, uint32_t length)
+{
+    auto first     = detail::next(data);
+    auto remainder = first->length - count * length;
+    auto previous  = data->length;
+    auto atom      = first;
+
+    assert( AtomID::free == first->identifier && count * length <= first->length );
+
+    for ( auto index = uint32_t{ 0 }; index < count; ++index )
+    {
+        *atom = { .length = length, .identifier = AtomID::vector, .previous = previous, .reserved = 0 };
+
+        previous = length;
+        atom     = detail::next(atom);
+    }
+
+    if ( 0 < remainder )
+    {
+        *atom = { .length = remainder, .identifier = AtomID::free, .previous = previous, .reserved = 0 };
+
+        previous = remainder;
+        atom     = detail::next(atom);
+    }
+
+    atom->previous = previous;
+
+    return first;
+}
+
+//===------------------------------------------------------------------------===
+// • format
+//===------------------------------------------------------------------------===
+
+void BM_format(benchmark::State& state)
+{
+    const auto contents_length = static_cast<uint32_t>( state.range(0) );
+
+    auto contents = std::make_unique_for_overwrite<uint8_t[]>(contents_length);
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( format(contents.get(), contents_length, 256) );
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • reserve_new, past free regions too small for it
+//===------------------------------------------------------------------------===
+
+void BM_reserve_new_fragmented(benchmark::State& state)
+{
+    const auto holes           = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = holes * 2 * 48 + 4096;
+
+    auto contents = std::make_unique_for_overwrite<uint8_t[]>(contents_length);
+    auto data     = format(contents.get(), contents_length);
+    auto atom     = carve(data, holes * 2, 48);
+
+    for ( auto index = uint32_t{ 0 }; index < holes; ++index )
+    {
+        auto next = detail::next( detail::next(atom) );
+
+        detail::free(atom);
+
+        atom = next;
+    }
+
+    for ( auto _ : state )
+    {
+        auto alloc = detail::reserve(data, 64, AtomID::vector);
+
+        benchmark::DoNotOptimize(alloc);
+
+        detail::free(alloc);
+    }
+
+    state.counters["holes"] = holes;
+}
+
+//===------------------------------------------------------------------------===
+// • reserve, growing in place or relocating, then shrinking back in place
+//===------------------------------------------------------------------------===
+
+void BM_reserve_in_place(benchmark::State& state)
+{
+    const auto contents_size   = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = 4 * contents_size + 4096;
+
+    auto contents = std::make_unique<uint8_t[]>(contents_length);
+    auto data     = format(contents.get(), contents_length);
+    auto alloc    = detail::reserve(data, contents_size, AtomID::vector);
+
+    for ( auto _ : state )
+    {
+        alloc = detail::reserve(data, alloc, 2 * contents_size);
+        alloc = detail::reserve(data, alloc, contents_size);
+
+        benchmark::DoNotOptimize(alloc);
+    }
+
+    state.SetBytesProcessed( state.iterations() * contents_size );
+}
+
+void BM_reserve_relocating(benchmark::State& state)
+{
+    const auto contents_size   = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = 8 * contents_size + 4096;
+
+    auto contents = std::make_unique<uint8_t[]>(contents_length);
+    auto data     = format(contents.get(), contents_length);
+
+    // • Each in turn is followed by the other, so has to move to grow
+    //
+    auto alloc = detail::reserve(data, contents_size, AtomID::vector);
+    auto other = detail::reserve(data, contents_size, AtomID::vector);
+
+    for ( auto _ : state )
+    {
+        alloc = detail::reserve(data, alloc, 2 * contents_size);
+        alloc = detail::reserve(data, alloc, contents_size);
+
+        benchmark::DoNotOptimize(alloc);
+
+        std::swap(alloc, other);
+    }
+
+    state.SetBytesProcessed( state.iterations() * contents_size );
+}
+
+//===------------------------------------------------------------------------===
+// • free, with 0, 1 or 2 free neighbours to coalesce with
+//===------------------------------------------------------------------------===
+
+void BM_free_coalescing(benchmark::State& state)
+{
+    constexpr auto group_count  = uint32_t{ 4096 };
+    constexpr auto group_length = uint32_t{ 4 * 64 };
+
+    const auto neighbours      = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = group_count * group_length + 4096;
+
+    auto contents = std::make_unique<uint8_t[]>(contents_length);
+    auto allocs   = std::vector<Atom*>( group_count );
+
+    for ( auto _ : state )
+    {
+        // • Groups of [previous] [alloc] [next] [blocker], with the neighbours
+        //   of each alloc freed first
+        //
+        auto data = format(contents.get(), contents_length);
+        auto atom = carve(data, 4 * group_count, 64);
+
+        for ( auto group = uint32_t{ 0 }; group < group_count; ++group )
+        {
+            auto previous = atom;
+            auto alloc    = detail::next(previous);
+            auto next     = detail::next(alloc);
+
+            atom = detail::next( detail::next(next) );
+
+            if ( 1 <= neighbours ) {
+                detail::free(next);
+            }
+
+            if ( 2 <= neighbours ) {
+                detail::free(previous);
+            }
+
+            allocs[group] = alloc;
+        }
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        for ( auto alloc : allocs ) {
+            benchmark::DoNotOptimize( detail::free(alloc) );
+        }
+
+        const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        state.SetIterationTime( std::chrono::duration<double>(elapsed).count() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * group_count );
+}
+
+//===------------------------------------------------------------------------===
+// • validate_layout, of buffers of 1 KB atoms
+//===------------------------------------------------------------------------===
+
+void BM_validate_layout(benchmark::State& state)
+{
+    const auto contents_length = static_cast<uint32_t>( state.range(0) );
+
+    auto contents = std::make_unique_for_overwrite<uint8_t[]>(contents_length);
+    auto data     = format(contents.get(), contents_length);
+
+    const auto atom_count = ( contents_length - 2 * atom_header_length ) / 1024;
+
+    carve(data, atom_count, 1024);
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( validate_layout(contents.get(), contents_length) );
+    }
+
+    state.SetBytesProcessed( state.iterations() * int64_t{ contents_length } );
+    state.counters["atoms"] = atom_count;
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_format )->RangeMultiplier(32)->Range(1 << 12, max_buffer_length);
+BENCHMARK( BM_reserve_new_fragmented )->RangeMultiplier(16)->Range(1, 1 << 16);
+BENCHMARK( BM_reserve_in_place )->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK( BM_reserve_relocating )->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK( BM_free_coalescing )->DenseRange(0, 2)->UseManualTime();
+BENCHMARK( BM_validate_layout )->RangeMultiplier(32)->Range(1 << 12, max_buffer_length);
@@ -0,0 +1,112 @@
+//
+//  BenchHashTable.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/HashTable.hpp>
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • HashTable benchmarks (lookups against std::unordered_map)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct TableData
+{
+    HashTableRef<uint64_t, uint64_t>    table;
+};
+
+std::vector<uint64_t> make_keys(int64_t count)
+{
+    auto engine = std::mt19937_64{ 0x5eed };
+    auto keys   = std::vector<uint64_t>( count );
+
+    for ( auto& key : keys ) {
+        key = engine();
+    }
+
+    return keys;
+}
+
+void BM_hash_table_find(benchmark::State& state)
+{
+    const auto keys = make_keys( state.range(0) );
+
+    const auto contents_length = static_cast<uint32_t>( 64 * state.range(0) + 4096 );
+    auto contents              = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<TableData>(contents.get(), contents_length);
+
+    auto table = HashTable<uint64_t, uint64_t>{ root->table, data };
+
+    table.reserve( static_cast<uint32_t>(keys.size()) );
+
+    for ( auto key : keys ) {
+        table.insert_or_assign(key, key);
+    }
+
+    auto index = size_t{ 0 };
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( table.find( keys[index] ) );
+        index = ( index + 1 < keys.size() ) ? index + 1 : 0;
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void BM_unordered_map_find(benchmark::State& state)
+{
+    const auto keys = make_keys( state.range(0) );
+
+    auto table = std::unordered_map<uint64_t, uint64_t>{ };
+
+    for ( auto key : keys ) {
+        table.insert_or_assign(key, key);
+    }
+
+    auto index = size_t{ 0 };
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( table.find( keys[index] ) );
+        index = ( index + 1 < keys.size() ) ? index + 1 : 0;
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_hash_table_find )->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK( BM_unordered_map_find )->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
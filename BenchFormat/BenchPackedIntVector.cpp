@@ -0,0 +1,139 @@
+//
+//  BenchPackedIntVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/Algorithm.hpp>
+#include <Data/PackedIntVector.hpp>
+
+#include <memory>
+#include <random>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVector benchmarks (scans against Vector<uint32_t>)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct ColumnData
+{
+    VectorRef<uint32_t>     raw;
+    PackedIntVectorRef      packed;
+};
+
+std::vector<uint32_t> make_timestamps(int64_t count)
+{
+    auto engine     = std::mt19937{ 0x5eed };
+    auto dist       = std::uniform_int_distribution<uint32_t>{ 0, 30 };
+    auto timestamps = std::vector<uint32_t>( count );
+    auto timestamp  = uint32_t{ 1'700'000'000 };
+
+    for ( auto& value : timestamps ) {
+        value = ( timestamp += dist(engine) );
+    }
+
+    return timestamps;
+}
+
+void BM_vector_sum(benchmark::State& state)
+{
+    const auto values = make_timestamps( state.range(0) );
+
+    const auto contents_length = static_cast<uint32_t>( 4 * state.range(0) + 4096 );
+    auto contents              = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<ColumnData>(contents.get(), contents_length);
+
+    auto raw = Vector<uint32_t>{ root->raw, data };
+
+    raw.assign( values.begin(), values.end() );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( data::sum(raw) );
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+    state.SetBytesProcessed( state.iterations() * state.range(0) * sizeof(uint32_t) );
+}
+
+void BM_packed_int_vector_sum(benchmark::State& state)
+{
+    const auto values = make_timestamps( state.range(0) );
+
+    const auto contents_length = static_cast<uint32_t>( 4 * state.range(0) + 4096 );
+    auto contents              = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<ColumnData>(contents.get(), contents_length);
+
+    auto packed = PackedIntVector{ root->packed, data };
+
+    packed.assign(values);
+
+    for ( auto _ : state )
+    {
+        auto sum = uint64_t{ 0 };
+
+        packed.for_each_block( [&sum](auto values, auto ) {
+            sum += data::sum(values);
+        });
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+    state.SetBytesProcessed( state.iterations() * packed.packed_length() );
+}
+
+void BM_packed_int_vector_random_access(benchmark::State& state)
+{
+    const auto values = make_timestamps( state.range(0) );
+
+    const auto contents_length = static_cast<uint32_t>( 4 * state.range(0) + 4096 );
+    auto contents              = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<ColumnData>(contents.get(), contents_length);
+
+    auto packed = PackedIntVector{ root->packed, data };
+
+    packed.assign(values);
+
+    auto engine = std::mt19937{ 1 };
+    auto dist   = std::uniform_int_distribution<uint32_t>{ 0, packed.size() - 1 };
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( packed[dist(engine)] );
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_vector_sum )->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK( BM_packed_int_vector_sum )->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK( BM_packed_int_vector_random_access )->Arg(1 << 20);
@@ -0,0 +1,161 @@
+//
+//  BenchParallel.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/Parallel.hpp>
+
+#include <random>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Parallel benchmarks (parallel:: algorithms against serial std::)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+std::vector<float> make_values(int64_t count)
+{
+    auto engine = std::mt19937{ 0x5eed };
+    auto values = std::vector<float>( count );
+
+    for ( auto& value : values ) {
+        value = static_cast<float>( engine() % 100000 );
+    }
+
+    return values;
+}
+
+void set_counters(benchmark::State& state)
+{
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+
+//===------------------------------------------------------------------------===
+// • sort
+//===------------------------------------------------------------------------===
+
+void BM_parallel_sort(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+    auto sorted       = values;
+
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        sorted = values;
+        state.ResumeTiming();
+
+        parallel::sort( ThreadPool::shared(), sorted );
+    }
+
+    set_counters(state);
+}
+
+void BM_std_sort(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+    auto sorted       = values;
+
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        sorted = values;
+        state.ResumeTiming();
+
+        std::sort( sorted.begin(), sorted.end() );
+    }
+
+    set_counters(state);
+}
+
+//===------------------------------------------------------------------------===
+// • reduce
+//===------------------------------------------------------------------------===
+
+void BM_parallel_reduce(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( parallel::reduce(ThreadPool::shared(), values, 0.0) );
+    }
+
+    set_counters(state);
+}
+
+void BM_std_accumulate(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( std::accumulate(values.begin(), values.end(), 0.0) );
+    }
+
+    set_counters(state);
+}
+
+//===------------------------------------------------------------------------===
+// • inclusive_scan
+//===------------------------------------------------------------------------===
+
+void BM_parallel_inclusive_scan(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+    auto scanned      = values;
+
+    for ( auto _ : state )
+    {
+        parallel::inclusive_scan( ThreadPool::shared(), values, scanned );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters(state);
+}
+
+void BM_std_inclusive_scan(benchmark::State& state)
+{
+    const auto values = make_values( state.range(0) );
+    auto scanned      = values;
+
+    for ( auto _ : state )
+    {
+        std::inclusive_scan( values.begin(), values.end(), scanned.begin() );
+        benchmark::ClobberMemory();
+    }
+
+    set_counters(state);
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_parallel_sort )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
+BENCHMARK( BM_std_sort )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
+BENCHMARK( BM_parallel_reduce )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
+BENCHMARK( BM_std_accumulate )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
+BENCHMARK( BM_parallel_inclusive_scan )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
+BENCHMARK( BM_std_inclusive_scan )->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->UseRealTime();
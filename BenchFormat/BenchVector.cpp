@@ -0,0 +1,192 @@
+//
+//  BenchVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/Vector.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Vector benchmarks (against std::vector)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct ValueData
+{
+    VectorRef<uint32_t> values;
+};
+
+uint32_t contents_length_for(int64_t count)
+{
+    return static_cast<uint32_t>( 8 * count + 4096 );
+}
+
+//===------------------------------------------------------------------------===
+// • push_back, from empty
+//===------------------------------------------------------------------------===
+
+void BM_vector_push_back(benchmark::State& state)
+{
+    const auto count           = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = contents_length_for(count);
+
+    auto contents = std::make_unique<uint8_t[]>(contents_length);
+
+    for ( auto _ : state )
+    {
+        auto [data, root] = format_for_data<ValueData>(contents.get(), contents_length);
+
+        auto values = Vector<uint32_t>{ root->values, data };
+
+        for ( auto index = uint32_t{ 0 }; index < count; ++index ) {
+            values.push_back(index);
+        }
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * count );
+}
+
+void BM_std_vector_push_back(benchmark::State& state)
+{
+    const auto count = static_cast<uint32_t>( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        auto values = std::vector<uint32_t>{ };
+
+        for ( auto index = uint32_t{ 0 }; index < count; ++index ) {
+            values.push_back(index);
+        }
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * count );
+}
+
+//===------------------------------------------------------------------------===
+// • insert and erase in the middle, keeping the size
+//===------------------------------------------------------------------------===
+
+void BM_vector_insert(benchmark::State& state)
+{
+    const auto count           = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = contents_length_for(count);
+
+    auto contents     = std::make_unique<uint8_t[]>(contents_length);
+    auto [data, root] = format_for_data<ValueData>(contents.get(), contents_length);
+
+    auto values = Vector<uint32_t>{ root->values, data };
+
+    values.reserve(count + 1);
+    values.resize_for_overwrite(count);
+
+    for ( auto _ : state )
+    {
+        values.insert( values.begin() + count / 2, 1 );
+        values.pop_back();
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void BM_std_vector_insert(benchmark::State& state)
+{
+    const auto count = static_cast<uint32_t>( state.range(0) );
+
+    auto values = std::vector<uint32_t>( count );
+
+    values.reserve(count + 1);
+
+    for ( auto _ : state )
+    {
+        values.insert( values.begin() + count / 2, 1 );
+        values.pop_back();
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void BM_vector_erase(benchmark::State& state)
+{
+    const auto count           = static_cast<uint32_t>( state.range(0) );
+    const auto contents_length = contents_length_for(count);
+
+    auto contents     = std::make_unique<uint8_t[]>(contents_length);
+    auto [data, root] = format_for_data<ValueData>(contents.get(), contents_length);
+
+    auto values = Vector<uint32_t>{ root->values, data };
+
+    values.reserve(count);
+    values.resize_for_overwrite(count);
+
+    for ( auto _ : state )
+    {
+        values.erase( values.begin() + count / 2 );
+        values.push_back(1);
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void BM_std_vector_erase(benchmark::State& state)
+{
+    const auto count = static_cast<uint32_t>( state.range(0) );
+
+    auto values = std::vector<uint32_t>( count );
+
+    for ( auto _ : state )
+    {
+        values.erase( values.begin() + count / 2 );
+        values.push_back(1);
+
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_vector_push_back )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK( BM_std_vector_push_back )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK( BM_vector_insert )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK( BM_std_vector_insert )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK( BM_vector_erase )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK( BM_std_vector_erase )->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
@@ -0,0 +1,121 @@
+//
+//  BenchVectorView.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <Data/VectorView.hpp>
+
+#include <memory>
+#include <numeric>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • VectorView benchmarks (short reads against constructing a Vector)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+constexpr auto row_count  = uint32_t{ 1024 };
+constexpr auto row_length   = uint32_t{ 8 };
+
+struct RowData
+{
+    VectorRef<uint32_t>     rows[row_count];
+};
+
+struct Rows
+{
+    std::unique_ptr<uint8_t[]>  contents;
+    Atom*                       data;
+    RowData*                    root;
+};
+
+Rows make_rows(void)
+{
+    const auto contents_length = uint32_t{ 1 << 20 };
+
+    auto contents     = std::make_unique<uint8_t[]>(contents_length);
+    auto [data, root] = format_for_data<RowData>(contents.get(), contents_length);
+
+    for ( auto& ref : root->rows )
+    {
+        auto row = Vector<uint32_t>{ ref, data };
+
+        auto values = row.append_uninitialized(row_length);
+
+        std::iota( values.begin(), values.end(), 0u );
+    }
+
+    return { std::move(contents), data, root };
+}
+
+void BM_vector_read(benchmark::State& state)
+{
+    auto rows = make_rows();
+
+    for ( auto _ : state )
+    {
+        auto sum = uint32_t{ 0 };
+
+        for ( auto& ref : rows.root->rows )
+        {
+            const auto row = Vector<uint32_t>{ ref, rows.data };
+
+            sum += row[row_length / 2];
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed( state.iterations() * row_count );
+}
+
+void BM_vector_view_read(benchmark::State& state)
+{
+    auto rows = make_rows();
+
+    for ( auto _ : state )
+    {
+        auto sum = uint32_t{ 0 };
+
+        for ( const auto& ref : rows.root->rows )
+        {
+            const auto row = VectorView<uint32_t>{ ref, rows.data };
+
+            sum += row[row_length / 2];
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed( state.iterations() * row_count );
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • Registration
+//===------------------------------------------------------------------------===
+
+BENCHMARK( BM_vector_read );
+BENCHMARK( BM_vector_view_read );
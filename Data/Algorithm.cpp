@@ -0,0 +1,575 @@
+//
+//  Algorithm.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Algorithm.hpp>
+
+//===------------------------------------------------------------------------===
+// • Instruction sets
+//
+//      The kernels are written once with the GCC/Clang vector extensions and
+//      compiled for each vector width. Functions with a wider target inline the
+//      generic kernels, so they are only ever called after a CPU check
+//===------------------------------------------------------------------------===
+
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#define DATA_KERNELS_X86 1
+#else
+#define DATA_KERNELS_X86 0
+#endif
+
+#define DATA_KERNEL_INLINE [[gnu::always_inline]] inline
+
+// • Vectors are only passed between inlined kernels, never across an ABI boundary
+//
+#if defined ( __GNUC__ ) && !defined ( __clang__ )
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+//
+// • SIMD vectors
+//
+//===------------------------------------------------------------------------===
+
+template <typename Type_, uint32_t Width_>
+struct VectorOf
+{
+    typedef Type_ type __attribute__(( vector_size(Width_) ));
+};
+
+template <Arithmetic Type_, uint32_t Width_>
+struct Simd
+{
+    // • Types
+    //
+    enum : uint32_t
+    {
+        lanes = Width_ / sizeof(Type_)
+    };
+
+    using mask_type = std::conditional_t< 1 == sizeof(Type_), int8_t,
+                          std::conditional_t< 2 == sizeof(Type_), int16_t,
+                              std::conditional_t< 4 == sizeof(Type_), int32_t, int64_t > > >;
+
+    using sum_scalar = sum_type<Type_>;
+
+    using vector = typename VectorOf<Type_, Width_>::type;
+    using mask   = typename VectorOf<mask_type, Width_>::type;
+    using words  = typename VectorOf<uint64_t, Width_>::type;
+    using sums   = typename VectorOf<sum_scalar, lanes * sizeof(sum_scalar)>::type;
+
+    // • Utilities
+    //
+    DATA_KERNEL_INLINE static vector load(const Type_* values) noexcept
+    {
+        vector result;
+
+        std::memcpy( &result, values, sizeof(result) );
+
+        return result;
+    }
+
+    DATA_KERNEL_INLINE static void store(Type_* values, vector source) noexcept
+    {
+        std::memcpy( values, &source, sizeof(source) );
+    }
+
+    DATA_KERNEL_INLINE static vector splat(Type_ value) noexcept
+    {
+        return vector{ } + value;
+    }
+
+    DATA_KERNEL_INLINE static vector select(mask choose, vector lhs, vector rhs) noexcept
+    {
+        return reinterpret_cast<vector>( (reinterpret_cast<mask>(lhs) & choose)
+                                       | (reinterpret_cast<mask>(rhs) & ~choose) );
+    }
+
+    DATA_KERNEL_INLINE static bool any(mask source) noexcept
+    {
+        const auto bits = reinterpret_cast<words>(source);
+
+        auto result = uint64_t{ 0 };
+
+        for ( auto word = 0u; word < Width_ / sizeof(uint64_t); ++word ) {
+            result |= bits[word];
+        }
+
+        return 0 != result;
+    }
+
+    DATA_KERNEL_INLINE static bool all(mask source) noexcept
+    {
+        const auto bits = reinterpret_cast<words>(source);
+
+        auto result = ~uint64_t{ 0 };
+
+        for ( auto word = 0u; word < Width_ / sizeof(uint64_t); ++word ) {
+            result &= bits[word];
+        }
+
+        return ~uint64_t{ 0 } == result;
+    }
+
+    template <Compare Compare_>
+    DATA_KERNEL_INLINE static mask compare(vector lhs, vector rhs) noexcept
+    {
+        if constexpr ( Compare::equal == Compare_ )              return reinterpret_cast<mask>( lhs == rhs );
+        else if constexpr ( Compare::not_equal == Compare_ )     return reinterpret_cast<mask>( lhs != rhs );
+        else if constexpr ( Compare::less == Compare_ )          return reinterpret_cast<mask>( lhs <  rhs );
+        else if constexpr ( Compare::less_equal == Compare_ )    return reinterpret_cast<mask>( lhs <= rhs );
+        else if constexpr ( Compare::greater == Compare_ )       return reinterpret_cast<mask>( lhs >  rhs );
+        else                                                     return reinterpret_cast<mask>( lhs >= rhs );
+    }
+
+    template <Compare Compare_>
+    DATA_KERNEL_INLINE static bool compare(Type_ lhs, Type_ rhs) noexcept
+    {
+        if constexpr ( Compare::equal == Compare_ )              return lhs == rhs;
+        else if constexpr ( Compare::not_equal == Compare_ )     return lhs != rhs;
+        else if constexpr ( Compare::less == Compare_ )          return lhs <  rhs;
+        else if constexpr ( Compare::less_equal == Compare_ )    return lhs <= rhs;
+        else if constexpr ( Compare::greater == Compare_ )       return lhs >  rhs;
+        else                                                     return lhs >= rhs;
+    }
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Generic kernels
+//
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_, uint32_t Width_>
+struct Kernels
+{
+    using simd   = Simd<Type_, Width_>;
+    using vector = typename simd::vector;
+    using mask   = typename simd::mask;
+
+    enum : uint32_t
+    {
+        lanes = simd::lanes
+    };
+
+    // • Search
+    //
+    DATA_KERNEL_INLINE static uint32_t find(const Type_* values, uint32_t count, Type_ value) noexcept
+    {
+        const auto splat = simd::splat(value);
+
+        auto index = uint32_t{ 0 };
+
+        for ( ; lanes <= count - index; index += lanes )
+        {
+            if ( simd::any( simd::template compare<Compare::equal>( simd::load(values + index), splat ) ) ) {
+                break;
+            }
+        }
+
+        for ( ; index < count; ++index )
+        {
+            if ( values[index] == value ) {
+                return index;
+            }
+        }
+
+        return count;
+    }
+
+    template <Compare Compare_>
+    DATA_KERNEL_INLINE static uint32_t count(const Type_* values, uint32_t count, Type_ value) noexcept
+    {
+        // • Each match is -1 in the mask, so subtracting counts matches per lane,
+        //   flushed before the narrowest lanes could overflow
+        //
+        constexpr auto flush_limit = static_cast<uint32_t>(
+            std::min<uint64_t>( std::numeric_limits<typename simd::mask_type>::max(), std::numeric_limits<int32_t>::max() ) );
+
+        const auto splat = simd::splat(value);
+
+        auto result = uint32_t{ 0 };
+        auto index  = uint32_t{ 0 };
+
+        while ( lanes <= count - index )
+        {
+            auto matches = mask{ };
+
+            for ( auto iteration = 0u; iteration < flush_limit && lanes <= count - index;
+                  ++iteration, index += lanes )
+            {
+                matches -= simd::template compare<Compare_>( simd::load(values + index), splat );
+            }
+
+            for ( auto lane = 0u; lane < lanes; ++lane ) {
+                result += static_cast<uint32_t>( matches[lane] );
+            }
+        }
+
+        for ( ; index < count; ++index ) {
+            result += simd::template compare<Compare_>( values[index], value ) ? 1 : 0;
+        }
+
+        return result;
+    }
+
+    // • Reduction
+    //
+    template <bool Min_>
+    DATA_KERNEL_INLINE static Type_ extreme(const Type_* values, uint32_t count) noexcept
+    {
+        auto result = values[0];
+        auto index  = uint32_t{ 0 };
+
+        if ( lanes <= count )
+        {
+            auto extremes = simd::load(values);
+
+            for ( index = lanes; lanes <= count - index; index += lanes )
+            {
+                const auto next = simd::load(values + index);
+
+                extremes = Min_
+                    ? simd::select( reinterpret_cast<mask>(next < extremes), next, extremes )
+                    : simd::select( reinterpret_cast<mask>(next > extremes), next, extremes );
+            }
+
+            result = extremes[0];
+
+            for ( auto lane = 1u; lane < lanes; ++lane ) {
+                result = Min_ ? std::min( result, Type_(extremes[lane]) ) : std::max( result, Type_(extremes[lane]) );
+            }
+        }
+
+        for ( ; index < count; ++index ) {
+            result = Min_ ? std::min( result, values[index] ) : std::max( result, values[index] );
+        }
+
+        return result;
+    }
+
+    DATA_KERNEL_INLINE static sum_type<Type_> sum(const Type_* values, uint32_t count) noexcept
+    {
+        using sums = typename simd::sums;
+
+        auto partial = sums{ };
+        auto index   = uint32_t{ 0 };
+
+        for ( ; lanes <= count - index; index += lanes ) {
+            partial += __builtin_convertvector( simd::load(values + index), sums );
+        }
+
+        auto result = sum_type<Type_>{ 0 };
+
+        for ( auto lane = 0u; lane < lanes; ++lane ) {
+            result += partial[lane];
+        }
+
+        for ( ; index < count; ++index ) {
+            result += values[index];
+        }
+
+        return result;
+    }
+
+    // • Modification
+    //
+    DATA_KERNEL_INLINE static void fill(Type_* values, uint32_t count, Type_ value) noexcept
+    {
+        const auto splat = simd::splat(value);
+
+        auto index = uint32_t{ 0 };
+
+        for ( ; lanes <= count - index; index += lanes ) {
+            simd::store( values + index, splat );
+        }
+
+        for ( ; index < count; ++index ) {
+            values[index] = value;
+        }
+    }
+
+    // • Comparison
+    //
+    DATA_KERNEL_INLINE static uint32_t mismatch(const Type_* lhs, const Type_* rhs, uint32_t count) noexcept
+    {
+        auto index = uint32_t{ 0 };
+
+        for ( ; lanes <= count - index; index += lanes )
+        {
+            if ( simd::any( simd::template compare<Compare::not_equal>( simd::load(lhs + index),
+                                                                        simd::load(rhs + index) ) ) ) {
+                break;
+            }
+        }
+
+        for ( ; index < count; ++index )
+        {
+            if ( lhs[index] != rhs[index] ) {
+                return index;
+            }
+        }
+
+        return count;
+    }
+
+    // • Filtered copy
+    //
+    template <Compare Compare_>
+    DATA_KERNEL_INLINE static uint32_t copy_if(const Type_* values, uint32_t count, Type_ value, Type_* dest) noexcept
+    {
+        const auto splat = simd::splat(value);
+
+        auto copied = uint32_t{ 0 };
+        auto index  = uint32_t{ 0 };
+
+        for ( ; lanes <= count - index; index += lanes )
+        {
+            // • Skip vectors with no selected elements, store vectors with all of
+            //   them, otherwise compact them without branching per element
+            //
+            const auto source = simd::load(values + index);
+            const auto choose = simd::template compare<Compare_>( source, splat );
+
+            if ( !simd::any(choose) ) {
+                continue;
+            }
+
+            if ( simd::all(choose) )
+            {
+                simd::store( dest + copied, source );
+                copied += lanes;
+                continue;
+            }
+
+            for ( auto lane = 0u; lane < lanes; ++lane )
+            {
+                dest[copied] = source[lane];
+                copied      -= static_cast<uint32_t>( choose[lane] );
+            }
+        }
+
+        for ( ; index < count; ++index )
+        {
+            dest[copied] = values[index];
+            copied      += simd::template compare<Compare_>( values[index], value ) ? 1 : 0;
+        }
+
+        return copied;
+    }
+
+    // • Dispatch on Compare
+    //
+    DATA_KERNEL_INLINE static uint32_t count(const Type_* values, uint32_t count, Compare compare, Type_ value) noexcept
+    {
+        switch ( compare )
+        {
+            case Compare::equal:         return Kernels::count<Compare::equal>(values, count, value);
+            case Compare::not_equal:     return Kernels::count<Compare::not_equal>(values, count, value);
+            case Compare::less:          return Kernels::count<Compare::less>(values, count, value);
+            case Compare::less_equal:    return Kernels::count<Compare::less_equal>(values, count, value);
+            case Compare::greater:       return Kernels::count<Compare::greater>(values, count, value);
+            case Compare::greater_equal: return Kernels::count<Compare::greater_equal>(values, count, value);
+        }
+
+        assert( false );
+
+        return 0;
+    }
+
+    DATA_KERNEL_INLINE static uint32_t copy_if( const Type_* values, uint32_t count, Compare compare,
+                                                Type_ value, Type_* dest ) noexcept
+    {
+        switch ( compare )
+        {
+            case Compare::equal:         return copy_if<Compare::equal>(values, count, value, dest);
+            case Compare::not_equal:     return copy_if<Compare::not_equal>(values, count, value, dest);
+            case Compare::less:          return copy_if<Compare::less>(values, count, value, dest);
+            case Compare::less_equal:    return copy_if<Compare::less_equal>(values, count, value, dest);
+            case Compare::greater:       return copy_if<Compare::greater>(values, count, value, dest);
+            case Compare::greater_equal: return copy_if<Compare::greater_equal>(values, count, value, dest);
+        }
+
+        assert( false );
+
+        return 0;
+    }
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Kernels per instruction set
+//
+//===------------------------------------------------------------------------===
+
+#define DATA_DEFINE_KERNELS(isa_, target_, width_)                                                      \
+                                                                                                        \
+template <Arithmetic Type_>                                                                             \
+struct isa_                                                                                             \
+{                                                                                                       \
+    using kernels = Kernels<Type_, width_>;                                                             \
+                                                                                                        \
+    target_ static uint32_t find(const Type_* values, uint32_t count, Type_ value)                      \
+    {                                                                                                   \
+        return kernels::find(values, count, value);                                                     \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static uint32_t count(const Type_* values, uint32_t count, Compare compare, Type_ value)    \
+    {                                                                                                   \
+        return kernels::count(values, count, compare, value);                                           \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static Type_ min(const Type_* values, uint32_t count)                                       \
+    {                                                                                                   \
+        return kernels::template extreme<true>(values, count);                                          \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static Type_ max(const Type_* values, uint32_t count)                                       \
+    {                                                                                                   \
+        return kernels::template extreme<false>(values, count);                                         \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static sum_type<Type_> sum(const Type_* values, uint32_t count)                             \
+    {                                                                                                   \
+        return kernels::sum(values, count);                                                             \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static void fill(Type_* values, uint32_t count, Type_ value)                                \
+    {                                                                                                   \
+        kernels::fill(values, count, value);                                                            \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static uint32_t mismatch(const Type_* lhs, const Type_* rhs, uint32_t count)                \
+    {                                                                                                   \
+        return kernels::mismatch(lhs, rhs, count);                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    target_ static uint32_t copy_if( const Type_* values, uint32_t count, Compare compare,              \
+                                     Type_ value, Type_* dest )                                         \
+    {                                                                                                   \
+        return kernels::copy_if(values, count, compare, value, dest);                                   \
+    }                                                                                                   \
+                                                                                                        \
+    static constexpr KernelTable<Type_> table = {                                                       \
+        .find     = find,                                                                               \
+        .count    = count,                                                                              \
+        .min      = min,                                                                                \
+        .max      = max,                                                                                \
+        .sum      = sum,                                                                                \
+        .fill     = fill,                                                                               \
+        .mismatch = mismatch,                                                                           \
+        .copy_if  = copy_if                                                                             \
+    };                                                                                                  \
+};
+
+// • 16-byte vectors are the baseline of both x86-64 (SSE2) and arm64 (NEON)
+//
+DATA_DEFINE_KERNELS(Baseline, , 16)
+
+#if DATA_KERNELS_X86
+DATA_DEFINE_KERNELS(AVX2,   [[gnu::target("avx2")]], 32)
+DATA_DEFINE_KERNELS(AVX512, [[gnu::target("avx512f,avx512bw")]], 64)
+#endif
+
+#undef DATA_DEFINE_KERNELS
+
+//===------------------------------------------------------------------------===
+// • Selection
+//===------------------------------------------------------------------------===
+
+enum class KernelISA : uint32_t
+{
+    generic,
+    sse2,
+    avx2,
+    avx512,
+};
+
+KernelISA select_isa(void) noexcept
+{
+#if DATA_KERNELS_X86
+    __builtin_cpu_init();
+
+    if ( __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") ) {
+        return KernelISA::avx512;
+    }
+
+    if ( __builtin_cpu_supports("avx2") ) {
+        return KernelISA::avx2;
+    }
+
+    return KernelISA::sse2;
+#else
+    return KernelISA::generic;
+#endif
+}
+
+template <Arithmetic Type_>
+const KernelTable<Type_>& kernels(void) noexcept
+{
+#if DATA_KERNELS_X86
+    static const auto& table = ( KernelISA::avx512 == select_isa() ) ? AVX512<Type_>::table
+                             : ( KernelISA::avx2   == select_isa() ) ? AVX2<Type_>::table
+                             : Baseline<Type_>::table;
+#else
+    static const auto& table = Baseline<Type_>::table;
+#endif
+
+    return table;
+}
+
+const char* kernel_isa(void) noexcept
+{
+    switch ( select_isa() )
+    {
+        case KernelISA::sse2:   return "sse2";
+        case KernelISA::avx2:   return "avx2";
+        case KernelISA::avx512: return "avx512";
+        default:                return "generic";
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Instantiation
+//===------------------------------------------------------------------------===
+
+template const KernelTable<int8_t>&   kernels<int8_t>(void) noexcept;
+template const KernelTable<uint8_t>&  kernels<uint8_t>(void) noexcept;
+template const KernelTable<int16_t>&  kernels<int16_t>(void) noexcept;
+template const KernelTable<uint16_t>& kernels<uint16_t>(void) noexcept;
+template const KernelTable<int32_t>&  kernels<int32_t>(void) noexcept;
+template const KernelTable<uint32_t>& kernels<uint32_t>(void) noexcept;
+template const KernelTable<int64_t>&  kernels<int64_t>(void) noexcept;
+template const KernelTable<uint64_t>& kernels<uint64_t>(void) noexcept;
+template const KernelTable<float>&    kernels<float>(void) noexcept;
+template const KernelTable<double>&   kernels<double>(void) noexcept;
+
+} // namespace detail
+
+} // namespace data
@@ -0,0 +1,276 @@
+//
+//  Algorithm.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Vector.hpp>
+
+#include <ranges>
+#include <span>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Arithmetic concept
+//===------------------------------------------------------------------------===
+
+template <class Type_>
+concept Arithmetic = std::is_same_v<Type_, int8_t>  || std::is_same_v<Type_, uint8_t>
+                  || std::is_same_v<Type_, int16_t> || std::is_same_v<Type_, uint16_t>
+                  || std::is_same_v<Type_, int32_t> || std::is_same_v<Type_, uint32_t>
+                  || std::is_same_v<Type_, int64_t> || std::is_same_v<Type_, uint64_t>
+                  || std::is_same_v<Type_, float>   || std::is_same_v<Type_, double>;
+
+//===------------------------------------------------------------------------===
+// • ArithmeticRange concept (Vector, std::span, ...)
+//===------------------------------------------------------------------------===
+
+template <class Range_>
+concept ArithmeticRange = std::ranges::contiguous_range<Range_>
+                       && std::ranges::sized_range<Range_>
+                       && Arithmetic<std::ranges::range_value_t<Range_>>;
+
+//===------------------------------------------------------------------------===
+// • Compare
+//===------------------------------------------------------------------------===
+
+enum class Compare : uint32_t
+{
+    equal,
+    not_equal,
+    less,
+    less_equal,
+    greater,
+    greater_equal,
+};
+
+//===------------------------------------------------------------------------===
+// • Sum type (integers are summed in 64 bits)
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+using sum_type = std::conditional_t< std::is_floating_point_v<Type_>, Type_,
+                     std::conditional_t< std::is_signed_v<Type_>, int64_t, uint64_t > >;
+
+//===------------------------------------------------------------------------===
+//
+// • Kernels
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+// • Kernel table, selected once for the running CPU
+//===------------------------------------------------------------------------===
+
+template <Arithmetic Type_>
+struct KernelTable
+{
+    uint32_t        (*find)(const Type_* values, uint32_t count, Type_ value);
+    uint32_t        (*count)(const Type_* values, uint32_t count, Compare compare, Type_ value);
+    Type_           (*min)(const Type_* values, uint32_t count);
+    Type_           (*max)(const Type_* values, uint32_t count);
+    sum_type<Type_> (*sum)(const Type_* values, uint32_t count);
+    void            (*fill)(Type_* values, uint32_t count, Type_ value);
+    uint32_t        (*mismatch)(const Type_* lhs, const Type_* rhs, uint32_t count);
+    uint32_t        (*copy_if)(const Type_* values, uint32_t count, Compare compare, Type_ value, Type_* dest);
+};
+
+template <Arithmetic Type_>
+const KernelTable<Type_>& kernels(void) noexcept;
+
+// • Name of the selected instruction set, "sse2", "avx2", "avx512" or "generic"
+//
+const char* kernel_isa(void) noexcept;
+
+//===------------------------------------------------------------------------===
+// • Ranges of arithmetic elements
+//===------------------------------------------------------------------------===
+
+template <class Range_>
+using range_value = std::ranges::range_value_t<Range_>;
+
+template <ArithmeticRange Range_>
+uint32_t count_of(Range_&& values) noexcept
+{
+    assert( std::ranges::size(values) <= std::numeric_limits<uint32_t>::max() );
+
+    return static_cast<uint32_t>( std::ranges::size(values) );
+}
+
+template <ArithmeticRange Range_>
+const KernelTable<range_value<Range_>>& kernels_for(const Range_& ) noexcept
+{
+    return kernels<range_value<Range_>>();
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+// • Search
+//===------------------------------------------------------------------------===
+
+// • Index of the first element equal to value, or the size if none
+//
+template <ArithmeticRange Range_>
+uint32_t find(const Range_& values, detail::range_value<Range_> value) noexcept
+{
+    return detail::kernels_for(values).find( std::ranges::data(values), detail::count_of(values), value );
+}
+
+template <ArithmeticRange Range_>
+uint32_t count(const Range_& values, detail::range_value<Range_> value) noexcept
+{
+    return detail::kernels_for(values).count( std::ranges::data(values), detail::count_of(values),
+                                              Compare::equal, value );
+}
+
+template <ArithmeticRange Range_>
+uint32_t count_if(const Range_& values, Compare compare, detail::range_value<Range_> value) noexcept
+{
+    return detail::kernels_for(values).count( std::ranges::data(values), detail::count_of(values),
+                                              compare, value );
+}
+
+//===------------------------------------------------------------------------===
+// • Reduction (NaN elements give an unspecified result)
+//===------------------------------------------------------------------------===
+
+template <ArithmeticRange Range_>
+detail::range_value<Range_> min(const Range_& values) noexcept
+{
+    assert( !std::ranges::empty(values) );
+
+    return detail::kernels_for(values).min( std::ranges::data(values), detail::count_of(values) );
+}
+
+template <ArithmeticRange Range_>
+detail::range_value<Range_> max(const Range_& values) noexcept
+{
+    assert( !std::ranges::empty(values) );
+
+    return detail::kernels_for(values).max( std::ranges::data(values), detail::count_of(values) );
+}
+
+// • Index of the first minimum or maximum element
+//
+template <ArithmeticRange Range_>
+uint32_t argmin(const Range_& values) noexcept
+{
+    return data::find( values, data::min(values) );
+}
+
+template <ArithmeticRange Range_>
+uint32_t argmax(const Range_& values) noexcept
+{
+    return data::find( values, data::max(values) );
+}
+
+// • Floating point sums are accumulated per SIMD lane, so may differ from a
+//   sequential sum by rounding
+//
+template <ArithmeticRange Range_>
+sum_type<detail::range_value<Range_>> sum(const Range_& values) noexcept
+{
+    return detail::kernels_for(values).sum( std::ranges::data(values), detail::count_of(values) );
+}
+
+//===------------------------------------------------------------------------===
+// • Modification
+//===------------------------------------------------------------------------===
+
+template <ArithmeticRange Range_>
+void fill(Range_&& values, detail::range_value<Range_> value) noexcept
+{
+    detail::kernels_for(values).fill( std::ranges::data(values), detail::count_of(values), value );
+}
+
+//===------------------------------------------------------------------------===
+// • Comparison
+//===------------------------------------------------------------------------===
+
+// • Index of the first differing element, or the shorter size if none
+//
+template <ArithmeticRange Range_>
+uint32_t mismatch(const Range_& lhs, const Range_& rhs) noexcept
+{
+    const auto count = std::min( detail::count_of(lhs), detail::count_of(rhs) );
+
+    return detail::kernels_for(lhs).mismatch( std::ranges::data(lhs), std::ranges::data(rhs), count );
+}
+
+template <ArithmeticRange Range_>
+bool equal(const Range_& lhs, const Range_& rhs) noexcept
+{
+    return detail::count_of(lhs) == detail::count_of(rhs) && detail::count_of(lhs) == data::mismatch(lhs, rhs);
+}
+
+//===------------------------------------------------------------------------===
+// • Filtered copy
+//===------------------------------------------------------------------------===
+
+// • Copies each element for which (element <compare> value), returning the
+//   count copied. The destination must have room for all of values
+//
+template <ArithmeticRange Range_>
+uint32_t copy_if( const Range_& values, Compare compare, detail::range_value<Range_> value,
+                  detail::range_value<Range_>* dest ) noexcept
+{
+    return detail::kernels_for(values).copy_if( std::ranges::data(values), detail::count_of(values),
+                                                compare, value, dest );
+}
+
+template <ArithmeticRange Range_>
+uint32_t copy_if( const Range_& values, Compare compare, detail::range_value<Range_> value,
+                  Vector<detail::range_value<Range_>>& dest ) noexcept(false)
+{
+    const auto count = detail::count_of(values);
+
+    auto append = dest.append_uninitialized(count);
+    auto copied = data::copy_if( values, compare, value, append.data() );
+
+    dest.resize_for_overwrite( dest.size() - count + copied );
+
+    return copied;
+}
+
+//===------------------------------------------------------------------------===
+// • VectorRef contents
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Type_>
+std::span<const Type_> contents_of(const VectorRef<Type_>& ref, const Atom* data) noexcept
+{
+    return { detail::offset_by<Type_>(data, ref.offset), ref.count };
+}
+
+template <TrivialLayout Type_>
+std::span<Type_> contents_of(const VectorRef<Type_>& ref, Atom* data) noexcept
+{
+    return { detail::offset_by<Type_>(data, ref.offset), ref.count };
+}
+
+} // namespace data
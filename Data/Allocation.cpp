@@ -18,6 +18,9 @@
 //
 
 #include <Data/Allocation.hpp>
+#include <Data/Trace.hpp>
+
+#include <vector>
 
 namespace data
 {
@@ -36,6 +39,8 @@ constexpr uint32_t get_allocation_length(uint32_t requested_contents_size) noexc
 
 Atom* divide(Atom* atom, uint32_t slice_length, AtomID identifier) noexcept
 {
+    DATA_TRACE_SCOPE("divide");
+
     // • First create the tail region fully within the region to divide
     //
     auto tail = detail::offset_by(atom, slice_length);
@@ -58,12 +63,16 @@ Atom* divide(Atom* atom, uint32_t slice_length, AtomID identifier) noexcept
 
 void merge_next(Atom* atom) noexcept
 {
+    DATA_TRACE_SCOPE("merge_next");
+
     atom->length                += detail::next(atom)->length;
     detail::next(atom)->previous = atom->length;
 }
 
 Atom* reserve_new(Atom* data, uint32_t allocation_length, AtomID identifier) noexcept(false)
 {
+    DATA_TRACE_SCOPE("reserve_new");
+
     for ( auto atom = next(data); !is_end(atom); atom = next(atom) )
     {
         if ( AtomID::free != atom->identifier || atom->length < allocation_length ) {
@@ -138,7 +147,7 @@ Atom* reserve(Atom* data, Atom* curr_alloc, uint32_t requested_contents_size) no
             && AtomID::free == extend->identifier
             && extend_length <= extend->length )
         {
-            if ( extend_length <= extend->length )
+            if ( extend_length < extend->length )
             {
                 divide(extend, extend_length, AtomID::free);
             }
@@ -175,6 +184,8 @@ Atom* reserve(Atom* data, Atom* curr_alloc, uint32_t requested_contents_size) no
 
 Atom* free(Atom* dealloc) noexcept
 {
+    DATA_TRACE_SCOPE("free");
+
     assert( AtomID::vector == dealloc->identifier );
 
     // • Convert to free region of the same length
@@ -202,6 +213,132 @@ Atom* free(Atom* dealloc) noexcept
     return dealloc;
 }
 
+bool can_resize_in_place(const Atom* curr_alloc, uint32_t allocation_length) noexcept
+{
+    if ( allocation_length <= curr_alloc->length )
+    {
+        return true;
+    }
+
+    auto extend = next(curr_alloc);
+
+    return !is_end(extend)
+        && AtomID::free == extend->identifier
+        && allocation_length - curr_alloc->length <= extend->length;
+}
+
+void reserve( Atom* data, std::span<Atom*> allocations,
+              std::span<const uint32_t> requested_contents_sizes ) noexcept(false)
+{
+    assert( AtomID::data == data->identifier );
+    assert( allocations.size() == requested_contents_sizes.size() );
+
+    // • Allocations that need a new atom, with the atom once placed
+    //
+    struct Placement
+    {
+        size_t      index;
+        uint32_t    allocation_length;
+        Atom*       atom;
+    };
+
+    // • Allocations extended in place, with their previous contents size
+    //
+    struct Extension
+    {
+        Atom*       atom;
+        uint32_t    contents_size;
+    };
+
+    auto placements = std::vector<Placement>{ };
+    auto extensions = std::vector<Extension>{ };
+
+    for ( auto index = size_t{ 0 }; index < allocations.size(); ++index )
+    {
+        const auto allocation_length = get_allocation_length(requested_contents_sizes[index]);
+
+        if ( nullptr == allocations[index] || !can_resize_in_place(allocations[index], allocation_length) )
+        {
+            placements.push_back({ .index = index, .allocation_length = allocation_length, .atom = nullptr });
+        }
+        else if ( allocations[index]->length < allocation_length )
+        {
+            extensions.push_back({ .atom = allocations[index], .contents_size = contents_size(allocations[index]) });
+
+            reserve( data, allocations[index], requested_contents_sizes[index] );
+        }
+    }
+
+    // • Place each new atom in the first free region it fits, in one pass
+    //
+    auto unplaced = placements.size();
+
+    for ( auto atom = next(data); 0 < unplaced && !is_end(atom); atom = next(atom) )
+    {
+        for ( auto& placement : placements )
+        {
+            if (   nullptr != placement.atom
+                || AtomID::free != atom->identifier
+                || atom->length < placement.allocation_length )
+            {
+                continue;
+            }
+
+            if ( placement.allocation_length < atom->length )
+            {
+                divide( atom, placement.allocation_length, AtomID::free );
+            }
+
+            atom->identifier = AtomID::vector;
+            placement.atom   = atom;
+
+            --unplaced;
+            break;
+        }
+    }
+
+    if ( 0 < unplaced )
+    {
+        // • Restore the layout before failing, as reserve_new does
+        //
+        for ( auto& placement : placements )
+        {
+            if ( nullptr != placement.atom ) {
+                free(placement.atom);
+            }
+        }
+
+        for ( auto& extension : extensions ) {
+            reserve( data, extension.atom, extension.contents_size );
+        }
+
+        assert( false );
+
+        throw false;
+    }
+
+    // • Move the contents of the relocated allocations, then shrink the rest
+    //   in place
+    //
+    for ( auto& placement : placements )
+    {
+        if ( auto curr_alloc = allocations[placement.index] )
+        {
+            std::memcpy( contents<uint8_t>(placement.atom), contents<uint8_t>(curr_alloc),
+                         std::min( contents_size(curr_alloc), contents_size(placement.atom) ) );
+
+            free(curr_alloc);
+        }
+
+        allocations[placement.index] = placement.atom;
+    }
+
+    for ( auto index = size_t{ 0 }; index < allocations.size(); ++index )
+    {
+        allocations[index] = reserve( data, allocations[index], requested_contents_sizes[index] );
+    }
+}
+
 } // namespace detail
 
 } // namespace data
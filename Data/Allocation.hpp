@@ -21,6 +21,8 @@
 
 #include <Data/Atom.hpp>
 
+#include <span>
+
 //===------------------------------------------------------------------------===
 // • namespace data
 //===------------------------------------------------------------------------===
@@ -40,6 +42,15 @@ Atom* reserve(Atom* data, Atom* curr_alloc, uint32_t requested_contents_size) no
 
 Atom* free(Atom* dealloc) noexcept;
 
+bool can_resize_in_place(const Atom* curr_alloc, uint32_t allocation_length) noexcept;
+
+// • Reserves or resizes several allocations with one pass over the atoms. Null
+//   allocations are reserved as 'vctr' atoms, and each is replaced by its new
+//   atom. Nothing is changed if they don't all fit
+//
+void reserve( Atom* data, std::span<Atom*> allocations,
+              std::span<const uint32_t> requested_contents_sizes ) noexcept(false);
+
 } // namespace detail
 
 } // namespace data
@@ -72,21 +72,31 @@ bool valid_alignment_and_length(const void* contents, uint32_t contents_length)
 }
 
 bool validate_layout(const void* contents, uint32_t contents_length) noexcept
+{
+    return !diagnose_layout(contents, contents_length).has_value();
+}
+
+std::optional<LayoutFault> diagnose_layout(const void* contents, uint32_t contents_length) noexcept
 {
     // • Contents alignment and length
     //
     if ( !valid_alignment_and_length(contents, contents_length) )
     {
-        return false;
+        return LayoutFault{ 0, "contents are misaligned or too short" };
     }
 
-    // • The first atom is 'data'
+    // • The first atom is 'data', and leaves room for 'end '
     //
     const Atom* data = reinterpret_cast<const Atom*>(contents);
 
     if ( !valid_data(data) )
     {
-        return false;
+        return LayoutFault{ 0, "first atom is not a valid 'data' atom" };
+    }
+
+    if ( contents_length - atom_header_length < data->length )
+    {
+        return LayoutFault{ 0, "'data' atom overlaps 'end '" };
     }
 
     // • The last atom is 'end ', which has no content
@@ -94,7 +104,7 @@ bool validate_layout(const void* contents, uint32_t contents_length) noexcept
     const auto end = detail::offset_by(data, contents_length - atom_header_length);
 
     if ( AtomID::end != end->identifier || !detail::empty(end) ) {
-        return false;
+        return LayoutFault{ contents_length - atom_header_length, "last atom is not an empty 'end ' atom" };
     }
 
     // • Validate each atom forward to 'end '
@@ -106,8 +116,10 @@ bool validate_layout(const void* contents, uint32_t contents_length) noexcept
           0 < end_distance ;
           end_distance -= curr->length, prev = curr, curr = detail::next(curr) )
     {
+        const auto offset = detail::distance(data, curr);
+
         if ( !is_aligned(curr->length) || end_distance < curr->length ) {
-            return false;
+            return LayoutFault{ offset, "length is misaligned or runs past 'end '" };
         }
 
         if ( AtomID::vector == curr->identifier )
@@ -115,7 +127,7 @@ bool validate_layout(const void* contents, uint32_t contents_length) noexcept
             // • There shall be no zero-length vector atoms
             //
             if ( detail::empty(curr) ) {
-                return false;
+                return LayoutFault{ offset, "'vctr' atom has no contents" };
             }
         }
         else if ( AtomID::free == curr->identifier )
@@ -123,26 +135,26 @@ bool validate_layout(const void* contents, uint32_t contents_length) noexcept
             // • There shall be no sequential free atoms
             //
             if ( AtomID::free == prev->identifier ) {
-                return false;
+                return LayoutFault{ offset, "'free' atom follows another 'free' atom" };
             }
         }
         else
         {
             // • Currently only two atom types before 'end '
             //
-            return false;
+            return LayoutFault{ offset, "unknown atom identifier" };
         }
 
         if (prev->length != curr->previous) {
-            return false;
+            return LayoutFault{ offset, "previous does not match the preceding atom length" };
         }
     }
 
     if ( curr != end ) {
-        return false;
+        return LayoutFault{ detail::distance(data, curr), "atom chain does not reach 'end '" };
     }
 
-    return true;
+    return std::nullopt;
 }
 
 //===------------------------------------------------------------------------===
@@ -171,7 +183,8 @@ Atom* format(void* buffer, uint32_t buffer_length, uint32_t data_contents_size)
     *data = {
         .length     = atom_header_length + aligned_data_contents_size,
         .identifier = AtomID::data,
-        0
+        .previous   = 0,
+        .reserved   = 0
     };
 
     // • Zero-init the data contents
@@ -196,14 +209,14 @@ Atom* format(void* buffer, uint32_t buffer_length, uint32_t data_contents_size)
             .length     = buffer_length - data->length - atom_header_length,
             .identifier = AtomID::free,
             .previous   = data->length,
-            0
+            .reserved   = 0
         };
 
         *end = {
             .length     = atom_header_length,
             .identifier = AtomID::end,
             .previous   = free->length,
-            0
+            .reserved   = 0
         };
     }
     else
@@ -212,7 +225,7 @@ Atom* format(void* buffer, uint32_t buffer_length, uint32_t data_contents_size)
             .length     = atom_header_length,
             .identifier = AtomID::end,
             .previous   = data->length,
-            0
+            .reserved   = 0
         };
     }
 
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <iterator>
+#include <optional>
 
 //===------------------------------------------------------------------------===
 // • namespace data
@@ -90,6 +91,17 @@ bool valid_alignment_and_length(const void* contents, uint32_t contents_length)
 
 bool validate_layout(const void* contents, uint32_t contents_length) noexcept;
 
+// • The first atom that fails validate_layout, at offset from the contents,
+//   with a short description of the check that failed
+//
+struct LayoutFault
+{
+    uint32_t    offset;
+    const char* reason;
+};
+
+std::optional<LayoutFault> diagnose_layout(const void* contents, uint32_t contents_length) noexcept;
+
 //===------------------------------------------------------------------------===
 //
 // • Iteration
@@ -259,7 +271,7 @@ std::pair<Atom*,Data_*>
 format_for_data(void* buffer, uint32_t buffer_length) noexcept(false)
 {
     auto data_atom = format( buffer, buffer_length, data::aligned_size<Data_>() );
-    auto data      = static_cast<Data_*>(buffer);
+    auto data      = detail::contents<Data_>(data_atom);
 
     return { data_atom, data };
 }
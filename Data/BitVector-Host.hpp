@@ -0,0 +1,299 @@
+//
+//  BitVector-Host.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/BitVectorRef.hpp>
+#include <Data/Vector-Host.hpp>
+
+#include <bit>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<BitVectorRef>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+// • Word utilities
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+// • Number of bits set in the words, with the popcnt instruction when the CPU
+//   has it
+//
+uint64_t popcount(const uint64_t* words, uint32_t count) noexcept;
+
+// • Mask of the bits [first, last) of a word, with first < last <= 64
+//
+constexpr uint64_t word_mask(uint32_t first, uint32_t last) noexcept
+{
+    return ( ~uint64_t{ 0 } >> ( bits_per_word - ( last - first ) ) ) << first;
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • BitVector
+//
+//===------------------------------------------------------------------------===
+
+// • Vector of bits in a 'vctr' atom of 64-bit words, with an optional rank
+//   index in a second atom for constant time rank and logarithmic time select.
+//   Any change to the bits makes the rank index stale until it is rebuilt
+//
+class BitVector
+{
+public:
+
+    // • Types
+    //
+    using size_type = uint32_t;
+
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+public:
+
+    // • Initialization
+    //
+    BitVector(BitVectorRef& ref, Atom* data) noexcept(false);
+
+private:
+
+    // • Initialization (deleted)
+    //
+    BitVector(const BitVector& ) = delete;
+    BitVector(BitVector&& ) = delete;
+    BitVector(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    BitVector& operator = (const BitVector& ) = delete;
+    BitVector& operator = (BitVector&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_ref.count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_ref.count;
+    }
+
+    size_type capacity(void) const noexcept
+    {
+        return m_words.capacity() * detail::bits_per_word;
+    }
+
+    std::span<const uint64_t> words(void) const noexcept
+    {
+        return { m_words.data(), m_words.size() };
+    }
+
+    // • Accessors : bits
+    //
+    bool test(size_type index) const noexcept
+    {
+        assert( index < size() );
+
+        return 0 != ( ( m_words[word_index(index)] >> bit_index(index) ) & 1 );
+    }
+
+    bool operator [] (size_type index) const noexcept
+    {
+        return test(index);
+    }
+
+    // • Accessors : counts
+    //
+    size_type count(void) const noexcept
+    {
+        return static_cast<size_type>( detail::popcount( m_words.data(), m_words.size() ) );
+    }
+
+    bool any(void) const noexcept;
+    bool all(void) const noexcept;
+
+    bool none(void) const noexcept
+    {
+        return !any();
+    }
+
+    // • Accessors : search
+    //
+    //      Index of the first bit set at or after index, or npos if none
+    //
+    size_type find_first(void) const noexcept
+    {
+        return find_next(0);
+    }
+
+    size_type find_next(size_type index) const noexcept;
+
+    template <class Function_>
+        requires std::is_invocable_v<Function_, size_type>
+    void for_each_set(Function_&& fn) const
+    {
+        for ( auto word = size_type{ 0 }; word < m_words.size(); ++word )
+        {
+            for ( auto bits = m_words[word]; 0 != bits; bits &= bits - 1 ) {
+                fn( word * detail::bits_per_word + std::countr_zero(bits) );
+            }
+        }
+    }
+
+    // • Accessors : rank and select
+    //
+    //      Number of bits set before index, with index <= size()
+    //
+    size_type rank(size_type index) const noexcept;
+
+    //      Index of the set bit with the given rank, or npos if there are no
+    //      more bits set than rank
+    //
+    size_type select(size_type rank) const noexcept;
+
+    bool has_rank_index(void) const noexcept
+    {
+        return !m_ranks.empty();
+    }
+
+    // • Methods : bits
+    //
+    void set(size_type index) noexcept
+    {
+        assert( index < size() );
+
+        m_words[word_index(index)] |= uint64_t{ 1 } << bit_index(index);
+
+        did_change();
+    }
+
+    void reset(size_type index) noexcept
+    {
+        assert( index < size() );
+
+        m_words[word_index(index)] &= ~( uint64_t{ 1 } << bit_index(index) );
+
+        did_change();
+    }
+
+    void flip(size_type index) noexcept
+    {
+        assert( index < size() );
+
+        m_words[word_index(index)] ^= uint64_t{ 1 } << bit_index(index);
+
+        did_change();
+    }
+
+    void set(size_type index, bool value) noexcept
+    {
+        value ? set(index) : reset(index);
+    }
+
+    // • Methods : ranges of bits [first, last)
+    //
+    void set_range(size_type first, size_type last) noexcept;
+    void reset_range(size_type first, size_type last) noexcept;
+
+    // • Methods : every bit, with other of the same size
+    //
+    BitVector& operator &= (const BitVector& other) noexcept(false);
+    BitVector& operator |= (const BitVector& other) noexcept(false);
+    BitVector& operator ^= (const BitVector& other) noexcept(false);
+
+    BitVector& and_not(const BitVector& other) noexcept(false);
+
+    void flip(void) noexcept;
+
+    // • Methods : container
+    //
+    void reserve(size_type capacity) noexcept(false)
+    {
+        m_words.reserve( detail::word_count(capacity) );
+    }
+
+    void resize(size_type count, bool value = false) noexcept(false);
+
+    void push_back(bool value) noexcept(false);
+
+    void clear(void) noexcept(false)
+    {
+        m_words.clear();
+        m_ref.count = 0;
+
+        did_change();
+    }
+
+    // • Methods : rank index
+    //
+    //      Counts the bits of each block of 8 words once, in its own atom
+    //
+    void build_rank_index(void) noexcept(false);
+
+private:
+
+    // • Utilities (private)
+    //
+    static size_type word_index(size_type index) noexcept
+    {
+        return index / detail::bits_per_word;
+    }
+
+    static size_type bit_index(size_type index) noexcept
+    {
+        return index % detail::bits_per_word;
+    }
+
+    void did_change(void) noexcept
+    {
+        m_ref.ranks.count = 0;
+    }
+
+    void clear_tail(void) noexcept;
+
+    template <class Operation_>
+    BitVector& combine(const BitVector& other, Operation_ operation) noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    BitVectorRef&       m_ref;
+    Vector<uint64_t>    m_words;
+    Vector<uint32_t>    m_ranks;
+};
+
+} // namespace data
@@ -0,0 +1,67 @@
+//
+//  BitVector-Metal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/BitVectorRef.hpp>
+#include <Data/Vector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • BitVector utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+inline bool test_bit(BitVectorRef ref, const device uint8_t* base, uint32_t index)
+{
+    const device uint64_t* words = contents(ref.words, base);
+
+    return 0 != ( ( words[index / detail::bits_per_word] >> ( index % detail::bits_per_word ) ) & 1 );
+}
+
+// • Number of bits set before index. The rank index must have been built
+//
+inline uint32_t rank(BitVectorRef ref, const device uint8_t* base, uint32_t index)
+{
+    const device uint64_t* words = contents(ref.words, base);
+
+    const uint32_t word = index / detail::bits_per_word;
+    const uint32_t bit  = index % detail::bits_per_word;
+
+    uint32_t rank = contents(ref.ranks, base)[word / detail::words_per_block];
+
+    for ( uint32_t prev = word - word % detail::words_per_block; prev < word; ++prev ) {
+        rank += static_cast<uint32_t>( popcount(words[prev]) );
+    }
+
+    if ( 0 < bit ) {
+        rank += static_cast<uint32_t>( popcount( words[word] & ( ( uint64_t(1) << bit ) - 1 ) ) );
+    }
+
+    return rank;
+}
+
+} // namespace data
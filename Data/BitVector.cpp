@@ -0,0 +1,422 @@
+//
+//  BitVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/BitVector.hpp>
+
+#include <algorithm>
+#include <array>
+
+//===------------------------------------------------------------------------===
+// • Instruction sets
+//===------------------------------------------------------------------------===
+
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#define DATA_POPCNT_X86 1
+#else
+#define DATA_POPCNT_X86 0
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+// • Population count
+//
+//      Without popcnt, x86-64 compilers expand std::popcount to a dozen
+//      instructions, so the kernel is compiled for both and chosen once
+//===------------------------------------------------------------------------===
+
+[[gnu::always_inline]] inline uint64_t popcount_words(const uint64_t* words, uint32_t count) noexcept
+{
+    // • Independent sums, so consecutive popcounts don't wait on each other
+    //
+    auto sums  = std::array<uint64_t, 4>{ };
+    auto index = uint32_t{ 0 };
+
+    for ( ; index + 4 <= count; index += 4 )
+    {
+        sums[0] += std::popcount(words[index + 0]);
+        sums[1] += std::popcount(words[index + 1]);
+        sums[2] += std::popcount(words[index + 2]);
+        sums[3] += std::popcount(words[index + 3]);
+    }
+
+    for ( ; index < count; ++index ) {
+        sums[0] += std::popcount(words[index]);
+    }
+
+    return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+static uint64_t popcount_generic(const uint64_t* words, uint32_t count) noexcept
+{
+    return popcount_words(words, count);
+}
+
+#if DATA_POPCNT_X86
+[[gnu::target("popcnt")]] static uint64_t popcount_popcnt(const uint64_t* words, uint32_t count) noexcept
+{
+    return popcount_words(words, count);
+}
+#endif
+
+uint64_t popcount(const uint64_t* words, uint32_t count) noexcept
+{
+#if DATA_POPCNT_X86
+    static const auto kernel = []{
+        __builtin_cpu_init();
+
+        return __builtin_cpu_supports("popcnt") ? &popcount_popcnt : &popcount_generic;
+    }();
+#else
+    static const auto kernel = &popcount_generic;
+#endif
+
+    return kernel(words, count);
+}
+
+//===------------------------------------------------------------------------===
+// • Select
+//===------------------------------------------------------------------------===
+
+// • Index of the set bit of a word with the given rank, by halving. The word
+//   must have more bits set than rank
+//
+constexpr uint32_t select_in_word(uint64_t word, uint32_t rank) noexcept
+{
+    auto index = uint32_t{ 0 };
+
+    for ( auto width = uint32_t{ 32 }; 0 < width; width /= 2 )
+    {
+        const auto low_count = static_cast<uint32_t>( std::popcount( word & ( ( uint64_t{ 1 } << width ) - 1 ) ) );
+
+        if ( low_count <= rank )
+        {
+            rank  -= low_count;
+            word >>= width;
+            index += width;
+        }
+    }
+
+    return index;
+}
+
+static_assert( 0  == select_in_word(0b1, 0) );
+static_assert( 5  == select_in_word(0b101001, 2) );
+static_assert( 63 == select_in_word(~uint64_t{ 0 }, 63) );
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • BitVector
+//
+//===------------------------------------------------------------------------===
+
+BitVector::BitVector(BitVectorRef& ref, Atom* data) noexcept(false)
+    :
+        m_ref  { ref },
+        m_words{ ref.words, data },
+        m_ranks{ ref.ranks, data }
+{
+    if ( m_words.size() != detail::word_count(m_ref.count) ) {
+        throw false;
+    }
+
+    if ( 0 != bit_index(m_ref.count) && 0 != ( m_words.back() >> bit_index(m_ref.count) ) ) {
+        throw false;
+    }
+
+    if ( !m_ranks.empty() && m_ranks.size() != detail::block_count(m_words.size()) + 1 ) {
+        throw false;
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Accessors
+//===------------------------------------------------------------------------===
+
+bool BitVector::any(void) const noexcept
+{
+    return std::any_of( m_words.begin(), m_words.end(), [](auto word) { return 0 != word; } );
+}
+
+bool BitVector::all(void) const noexcept
+{
+    const auto full_words = word_index(size());
+
+    const auto all_full = std::all_of( m_words.begin(), m_words.begin() + full_words, [](auto word) {
+        return ~uint64_t{ 0 } == word;
+    });
+
+    return all_full && ( 0 == bit_index(size())
+                      || detail::word_mask(0, bit_index(size())) == m_words[full_words] );
+}
+
+BitVector::size_type BitVector::find_next(size_type index) const noexcept
+{
+    if ( size() <= index ) {
+        return npos;
+    }
+
+    auto word = word_index(index);
+    auto bits = m_words[word] >> bit_index(index) << bit_index(index);
+
+    while ( 0 == bits )
+    {
+        if ( m_words.size() == ++word ) {
+            return npos;
+        }
+
+        bits = m_words[word];
+    }
+
+    return word * detail::bits_per_word + std::countr_zero(bits);
+}
+
+BitVector::size_type BitVector::rank(size_type index) const noexcept
+{
+    assert( index <= size() );
+
+    const auto word = word_index(index);
+    auto rank       = size_type{ 0 };
+
+    if ( has_rank_index() )
+    {
+        const auto block_word = word - word % detail::words_per_block;
+
+        rank = m_ranks[word / detail::words_per_block]
+             + static_cast<size_type>( detail::popcount( m_words.data() + block_word, word - block_word ) );
+    }
+    else
+    {
+        rank = static_cast<size_type>( detail::popcount( m_words.data(), word ) );
+    }
+
+    if ( 0 < bit_index(index) ) {
+        rank += std::popcount( m_words[word] & detail::word_mask(0, bit_index(index)) );
+    }
+
+    return rank;
+}
+
+BitVector::size_type BitVector::select(size_type rank) const noexcept
+{
+    auto word = size_type{ 0 };
+
+    if ( has_rank_index() )
+    {
+        // • Last block with no more bits set before it than rank
+        //
+        if ( m_ranks.back() <= rank ) {
+            return npos;
+        }
+
+        const auto block = std::upper_bound( m_ranks.begin(), m_ranks.end(), rank ) - m_ranks.begin() - 1;
+
+        word  = static_cast<size_type>(block) * detail::words_per_block;
+        rank -= m_ranks[block];
+    }
+
+    for ( ; word < m_words.size(); ++word )
+    {
+        const auto word_count = static_cast<size_type>( std::popcount(m_words[word]) );
+
+        if ( rank < word_count ) {
+            return word * detail::bits_per_word + detail::select_in_word(m_words[word], rank);
+        }
+
+        rank -= word_count;
+    }
+
+    return npos;
+}
+
+//===------------------------------------------------------------------------===
+// • Methods : ranges of bits
+//===------------------------------------------------------------------------===
+
+void BitVector::set_range(size_type first, size_type last) noexcept
+{
+    assert( first <= last && last <= size() );
+
+    for ( auto index = first; index < last; )
+    {
+        const auto end = std::min( last, ( word_index(index) + 1 ) * detail::bits_per_word );
+
+        m_words[word_index(index)] |= detail::word_mask( bit_index(index), end - index + bit_index(index) );
+
+        index = end;
+    }
+
+    did_change();
+}
+
+void BitVector::reset_range(size_type first, size_type last) noexcept
+{
+    assert( first <= last && last <= size() );
+
+    for ( auto index = first; index < last; )
+    {
+        const auto end = std::min( last, ( word_index(index) + 1 ) * detail::bits_per_word );
+
+        m_words[word_index(index)] &= ~detail::word_mask( bit_index(index), end - index + bit_index(index) );
+
+        index = end;
+    }
+
+    did_change();
+}
+
+//===------------------------------------------------------------------------===
+// • Methods : every bit
+//===------------------------------------------------------------------------===
+
+template <class Operation_>
+BitVector& BitVector::combine(const BitVector& other, Operation_ operation) noexcept(false)
+{
+    if ( other.size() != size() ) {
+        throw false;
+    }
+
+    auto words       = m_words.data();
+    auto other_words = other.m_words.data();
+
+    for ( auto index = size_type{ 0 }; index < m_words.size(); ++index ) {
+        words[index] = operation( words[index], other_words[index] );
+    }
+
+    did_change();
+
+    return *this;
+}
+
+BitVector& BitVector::operator &= (const BitVector& other) noexcept(false)
+{
+    return combine( other, [](auto lhs, auto rhs) { return lhs & rhs; } );
+}
+
+BitVector& BitVector::operator |= (const BitVector& other) noexcept(false)
+{
+    return combine( other, [](auto lhs, auto rhs) { return lhs | rhs; } );
+}
+
+BitVector& BitVector::operator ^= (const BitVector& other) noexcept(false)
+{
+    return combine( other, [](auto lhs, auto rhs) { return lhs ^ rhs; } );
+}
+
+BitVector& BitVector::and_not(const BitVector& other) noexcept(false)
+{
+    return combine( other, [](auto lhs, auto rhs) { return lhs & ~rhs; } );
+}
+
+void BitVector::flip(void) noexcept
+{
+    for ( auto& word : m_words ) {
+        word = ~word;
+    }
+
+    clear_tail();
+    did_change();
+}
+
+//===------------------------------------------------------------------------===
+// • Methods : container
+//===------------------------------------------------------------------------===
+
+void BitVector::resize(size_type count, bool value) noexcept(false)
+{
+    const auto prev_count = size();
+    const auto word_count = detail::word_count(count);
+
+    if ( m_words.capacity() < word_count ) {
+        m_words.reserve( std::max(word_count, m_words.size() + m_words.size() / 2) );
+    }
+
+    // • New words start clear, and the tail of the last word already is
+    //
+    const auto prev_words = m_words.size();
+
+    m_words.resize_for_overwrite(word_count);
+
+    std::fill( m_words.begin() + std::min(prev_words, word_count), m_words.end(), uint64_t{ 0 } );
+
+    m_ref.count = count;
+
+    if ( prev_count < count && value ) {
+        set_range(prev_count, count);
+    }
+
+    clear_tail();
+    did_change();
+}
+
+void BitVector::push_back(bool value) noexcept(false)
+{
+    const auto index = size();
+
+    resize( index + 1 );
+
+    if ( value ) {
+        set(index);
+    }
+}
+
+void BitVector::build_rank_index(void) noexcept(false)
+{
+    const auto block_count = detail::block_count(m_words.size());
+
+    m_ranks.clear();
+    m_ranks.reserve(block_count + 1);
+
+    auto ranks = m_ranks.append_uninitialized(block_count + 1);
+    auto rank  = uint32_t{ 0 };
+
+    for ( auto block = size_type{ 0 }; block < block_count; ++block )
+    {
+        const auto first = block * detail::words_per_block;
+        const auto count = std::min( m_words.size() - first, size_type{ detail::words_per_block } );
+
+        ranks[block] = rank;
+        rank        += static_cast<uint32_t>( detail::popcount(m_words.data() + first, count) );
+    }
+
+    ranks[block_count] = rank;
+}
+
+//===------------------------------------------------------------------------===
+// • Utilities (private)
+//===------------------------------------------------------------------------===
+
+void BitVector::clear_tail(void) noexcept
+{
+    if ( 0 != bit_index(size()) ) {
+        m_words.back() &= detail::word_mask(0, bit_index(size()));
+    }
+}
+
+} // namespace data
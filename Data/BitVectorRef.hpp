@@ -0,0 +1,80 @@
+//
+//  BitVectorRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • BitVectorRef
+//
+//===------------------------------------------------------------------------===
+
+// • Bits packed into 64-bit words, least significant bit first. Bits past the
+//   count in the last word are always zero.
+//
+//   The optional rank index holds, for each block of 8 words, the number of
+//   bits set before the block, and the total last. It has no elements when it
+//   is stale or hasn't been built
+//
+struct BitVectorRef
+{
+    uint32_t                count;  // Number of bits
+    VectorRef<uint64_t>     words;
+    VectorRef<uint32_t>     ranks;
+};
+
+static_assert( 20 ==  sizeof(BitVectorRef), "Unexpected size" );
+static_assert(  4 == alignof(BitVectorRef), "Unexpected alignment" );
+
+//===------------------------------------------------------------------------===
+// • Layout utilities
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+enum : uint32_t
+{
+    bits_per_word   = 64,
+    words_per_block = 8,
+    bits_per_block  = bits_per_word * words_per_block,
+};
+
+inline uint32_t word_count(uint32_t bit_count)
+{
+    return ( bit_count + ( bits_per_word - 1 ) ) / bits_per_word;
+}
+
+inline uint32_t block_count(uint32_t word_count)
+{
+    return ( word_count + ( words_per_block - 1 ) ) / words_per_block;
+}
+
+} // namespace detail
+
+} // namespace data
@@ -0,0 +1,58 @@
+//
+//  ColumnsRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • ColumnsRef
+//
+//===------------------------------------------------------------------------===
+
+// • Columns of equal count, each in its own 'vctr' atom. The offsets are those
+//   of the field columns of a record, in declaration order
+//
+template <uint32_t Count_>
+struct ColumnsRef
+{
+    uint32_t count;
+    uint32_t offsets[Count_];   // Offset from the beginning of the Resource atom
+};
+
+static_assert( 16 ==  sizeof(ColumnsRef<3>), "Unexpected size" );
+static_assert(  4 == alignof(ColumnsRef<3>), "Unexpected alignment" );
+
+// • VectorRef of a column, for the Vector contents() accessors (Host and Metal)
+//
+template <TRIVIAL_LAYOUT Type_, uint32_t Count_>
+VectorRef<Type_> column(ColumnsRef<Count_> ref, uint32_t index)
+{
+    return { ref.offsets[index], ref.count };
+}
+
+} // namespace data
@@ -0,0 +1,98 @@
+//
+//  DirtyRanges.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/DirtyRanges.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • DirtyRanges
+//
+//===------------------------------------------------------------------------===
+
+DirtyRanges::DirtyRanges(uint32_t contents_length, uint32_t granularity) noexcept(false)
+    :
+        m_contents_length{ contents_length },
+        m_granularity    { granularity     }
+{
+    if ( !std::has_single_bit(granularity) ) {
+        throw false;
+    }
+}
+
+uint64_t DirtyRanges::dirty_length(void) const noexcept
+{
+    auto length = uint64_t{ 0 };
+
+    for ( const auto& range : m_ranges ) {
+        length += range.length;
+    }
+
+    return length;
+}
+
+void DirtyRanges::mark(uint32_t offset, uint32_t length) noexcept(false)
+{
+    assert( offset <= m_contents_length && length <= m_contents_length - offset );
+
+    if ( 0 == length )
+    {
+        // • No-op
+        return;
+    }
+
+    // • Widen to whole granules within the buffer
+    //
+    const auto mask  = uint64_t{ m_granularity - 1 };
+    const auto begin = static_cast<uint32_t>( offset & ~mask );
+    const auto end   = static_cast<uint32_t>( std::min( ( uint64_t{ offset } + length + mask ) & ~mask,
+                                                        uint64_t{ m_contents_length } ) );
+
+    // • Merge with every range it overlaps or touches
+    //
+    auto first = std::lower_bound( m_ranges.begin(), m_ranges.end(), begin,
+                                   [](const DirtyRange& range, uint32_t begin) { return range.end() < begin; } );
+    auto last  = std::upper_bound( first, m_ranges.end(), end,
+                                   [](uint32_t end, const DirtyRange& range) { return end < range.offset; } );
+
+    if ( first == last )
+    {
+        m_ranges.insert( first, { .offset = begin, .length = end - begin } );
+        return;
+    }
+
+    const auto merged_begin = std::min( begin, first->offset );
+    const auto merged_end   = std::max( end, std::prev(last)->end() );
+
+    *first = { .offset = merged_begin, .length = merged_end - merged_begin };
+
+    m_ranges.erase( std::next(first), last );
+}
+
+} // namespace data
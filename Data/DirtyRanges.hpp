@@ -0,0 +1,164 @@
+//
+//  DirtyRanges.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+#include <Data/MutationObserver.hpp>
+
+#include <span>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • DirtyRange
+//
+//===------------------------------------------------------------------------===
+
+struct DirtyRange
+{
+    uint32_t    offset;     // Offset from the beginning of the 'data' atom
+    uint32_t    length;
+
+    uint32_t end(void) const noexcept
+    {
+        return offset + length;
+    }
+
+    bool operator == (const DirtyRange& ) const = default;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • DirtyRanges
+//
+//===------------------------------------------------------------------------===
+
+// • The byte ranges of a formatted buffer modified since they were last
+//   consumed, so that only those are uploaded to the device. Ranges are
+//   widened to multiples of the granularity, a power of two, and kept sorted
+//   and coalesced, so ranges within the same or adjacent granules merge.
+//   As an observer of a Mutator, it marks every byte range modified
+//
+class DirtyRanges : public MutationObserver
+{
+public:
+
+    // • Initialization
+    //
+    explicit DirtyRanges(uint32_t contents_length, uint32_t granularity = alignment) noexcept(false);
+
+private:
+
+    // • Initialization (deleted)
+    //
+    DirtyRanges(const DirtyRanges& ) = delete;
+    DirtyRanges(DirtyRanges&& ) = delete;
+    DirtyRanges(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    DirtyRanges& operator = (const DirtyRanges& ) = delete;
+    DirtyRanges& operator = (DirtyRanges&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint32_t granularity(void) const noexcept
+    {
+        return m_granularity;
+    }
+
+    std::span<const DirtyRange> ranges(void) const noexcept
+    {
+        return m_ranges;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return m_ranges.empty();
+    }
+
+    // • Total length of the ranges
+    //
+    uint64_t dirty_length(void) const noexcept;
+
+    // • Methods
+    //
+    void mark(uint32_t offset, uint32_t length) noexcept(false);
+
+    void mark_all(void) noexcept(false)
+    {
+        mark(0, m_contents_length);
+    }
+
+    void clear(void) noexcept
+    {
+        m_ranges.clear();
+    }
+
+    // • MutationObserver
+    //
+    void did_modify(uint32_t offset, uint32_t length) noexcept(false) override
+    {
+        mark(offset, length);
+    }
+
+    //      Returns the ranges and clears them, as once they have been uploaded
+    //
+    std::vector<DirtyRange> consume(void) noexcept
+    {
+        auto ranges = std::vector<DirtyRange>{ };
+
+        ranges.swap(m_ranges);
+
+        return ranges;
+    }
+
+    //      Calls sink(offset, length) for each range in order, as with
+    //      didModifyRange, then clears them. The ranges are kept if sink throws
+    //
+    template <class Sink_>
+    void consume(Sink_&& sink) noexcept(false)
+    {
+        for ( const auto& range : m_ranges ) {
+            sink( range.offset, range.length );
+        }
+
+        m_ranges.clear();
+    }
+
+private:
+
+    // • Data members
+    //
+    uint32_t                m_contents_length;
+    uint32_t                m_granularity;
+    std::vector<DirtyRange> m_ranges;
+};
+
+} // namespace data
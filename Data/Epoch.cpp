@@ -0,0 +1,112 @@
+//
+//  Epoch.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Epoch.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • EpochDomain
+//
+//===------------------------------------------------------------------------===
+
+EpochDomain::EpochDomain(void) noexcept
+    :
+        m_epoch{ outside_epoch + 1 }
+{
+    for ( auto& slot : m_slots )
+    {
+        slot.epoch.store(outside_epoch);
+        slot.in_use.store(false);
+    }
+}
+
+uint64_t EpochDomain::min_reader_epoch(void) const noexcept
+{
+    auto min_epoch = m_epoch.load();
+
+    for ( const auto& slot : m_slots )
+    {
+        if ( const auto epoch = slot.epoch.load(); outside_epoch != epoch ) {
+            min_epoch = std::min(min_epoch, epoch);
+        }
+    }
+
+    return min_epoch;
+}
+
+uint32_t EpochDomain::claim(void) noexcept(false)
+{
+    for ( auto index = uint32_t{ 0 }; index < max_readers; ++index )
+    {
+        auto in_use = false;
+
+        if ( m_slots[index].in_use.compare_exchange_strong(in_use, true) ) {
+            return index;
+        }
+    }
+
+    throw false;
+}
+
+void EpochDomain::release(uint32_t slot) noexcept
+{
+    assert( outside_epoch == m_slots[slot].epoch.load() );
+
+    m_slots[slot].in_use.store(false);
+}
+
+void EpochDomain::enter(uint32_t slot) noexcept
+{
+    assert( outside_epoch == m_slots[slot].epoch.load() );
+
+    // • Published before anything is read, and again if the writer advanced
+    //   meanwhile, as it may not have seen this reader in its scan
+    //
+    auto epoch = m_epoch.load();
+
+    for ( ;; )
+    {
+        m_slots[slot].epoch.store(epoch);
+
+        const auto current = m_epoch.load();
+
+        if ( current == epoch ) {
+            break;
+        }
+
+        epoch = current;
+    }
+}
+
+void EpochDomain::leave(uint32_t slot) noexcept
+{
+    m_slots[slot].epoch.store(outside_epoch);
+}
+
+} // namespace data
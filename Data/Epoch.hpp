@@ -0,0 +1,232 @@
+//
+//  Epoch.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • EpochDomain
+//
+//===------------------------------------------------------------------------===
+
+// • Epochs of the readers of a buffer mutated by one writer. A reader enters
+//   at the current epoch and stays there until it leaves. What the writer
+//   retires at an epoch is reclaimed once the epoch has advanced and no
+//   reader entered at or before it remains
+//
+class EpochDomain
+{
+public:
+
+    enum : uint32_t
+    {
+        max_readers = 64
+    };
+
+    // • Initialization
+    //
+    EpochDomain(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    EpochDomain(const EpochDomain& ) = delete;
+    EpochDomain(EpochDomain&& ) = delete;
+
+    // • Assignment (deleted)
+    //
+    EpochDomain& operator = (const EpochDomain& ) = delete;
+    EpochDomain& operator = (EpochDomain&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint64_t epoch(void) const noexcept
+    {
+        return m_epoch.load();
+    }
+
+    //      The oldest epoch of the readers within one, or the current epoch if
+    //      there are none
+    //
+    uint64_t min_reader_epoch(void) const noexcept;
+
+    // • Methods
+    //
+    //      Called by the writer once its changes are complete. Returns the new
+    //      epoch
+    //
+    uint64_t advance(void) noexcept
+    {
+        return m_epoch.fetch_add(1) + 1;
+    }
+
+private:
+
+    friend class EpochReader;
+
+    enum : uint64_t
+    {
+        outside_epoch = 0
+    };
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t>   epoch;
+        std::atomic<bool>       in_use;
+    };
+
+    // • Utilities (private)
+    //
+    uint32_t claim(void) noexcept(false);
+    void release(uint32_t slot) noexcept;
+
+    void enter(uint32_t slot) noexcept;
+    void leave(uint32_t slot) noexcept;
+
+private:
+
+    // • Data members
+    //
+    alignas(64) std::atomic<uint64_t>   m_epoch;
+    std::array<Slot, max_readers>       m_slots;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • EpochReader
+//
+//===------------------------------------------------------------------------===
+
+// • A reader thread's slot in the domain, for as long as it exists. Contents
+//   reached within an epoch stay valid until the reader leaves it
+//
+class EpochReader
+{
+public:
+
+    // • Initialization
+    //
+    //      Throws if every slot is taken
+    //
+    explicit EpochReader(EpochDomain& domain) noexcept(false)
+        :
+            m_domain{ domain         },
+            m_slot  { domain.claim() }
+    {
+    }
+
+    ~EpochReader(void) noexcept
+    {
+        m_domain.release(m_slot);
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    EpochReader(const EpochReader& ) = delete;
+    EpochReader(EpochReader&& ) = delete;
+    EpochReader(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    EpochReader& operator = (const EpochReader& ) = delete;
+    EpochReader& operator = (EpochReader&& ) = delete;
+
+public:
+
+    // • Methods
+    //
+    void enter(void) noexcept
+    {
+        m_domain.enter(m_slot);
+    }
+
+    void leave(void) noexcept
+    {
+        m_domain.leave(m_slot);
+    }
+
+private:
+
+    // • Data members
+    //
+    EpochDomain&    m_domain;
+    uint32_t        m_slot;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • EpochGuard
+//
+//===------------------------------------------------------------------------===
+
+class EpochGuard
+{
+public:
+
+    // • Initialization
+    //
+    explicit EpochGuard(EpochReader& reader) noexcept
+        :
+            m_reader{ reader }
+    {
+        m_reader.enter();
+    }
+
+    ~EpochGuard(void) noexcept
+    {
+        m_reader.leave();
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    EpochGuard(const EpochGuard& ) = delete;
+    EpochGuard(EpochGuard&& ) = delete;
+    EpochGuard(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    EpochGuard& operator = (const EpochGuard& ) = delete;
+    EpochGuard& operator = (EpochGuard&& ) = delete;
+
+private:
+
+    // • Data members
+    //
+    EpochReader&    m_reader;
+};
+
+} // namespace data
@@ -0,0 +1,127 @@
+//
+//  EpochMutator.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/EpochMutator.hpp>
+
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • EpochMutator
+//
+//===------------------------------------------------------------------------===
+
+EpochMutator::EpochMutator( Atom* data, uint32_t contents_length, EpochDomain& epochs,
+                            std::initializer_list<MutationObserver*> observers ) noexcept(false)
+    :
+        Mutator { data, contents_length, observers },
+        m_epochs{ &epochs                          }
+{
+}
+
+//===------------------------------------------------------------------------===
+// • Allocation
+//===------------------------------------------------------------------------===
+
+Atom* EpochMutator::reserve(Atom* curr_alloc, uint32_t requested_contents_size) noexcept(false)
+{
+    // • Readers may still be within the current atom, so it is only extended
+    //   in place, or else copied and retired. Shrinks are skipped
+    //
+    const auto allocation_length = atom_header_length + aligned_size(requested_contents_size);
+
+    if ( allocation_length <= curr_alloc->length ) {
+        return curr_alloc;
+    }
+
+    if ( detail::can_resize_in_place(curr_alloc, allocation_length) ) {
+        return Mutator::reserve(curr_alloc, requested_contents_size);
+    }
+
+    auto alloc = Mutator::reserve(requested_contents_size, AtomID::vector);
+
+    std::memcpy( detail::contents<uint8_t>(alloc), detail::contents<uint8_t>(curr_alloc),
+                 detail::contents_size(curr_alloc) );
+
+    write( detail::contents<uint8_t>(alloc), detail::contents_size(curr_alloc) );
+
+    retire(curr_alloc);
+
+    return alloc;
+}
+
+Atom* EpochMutator::free(Atom* dealloc) noexcept(false)
+{
+    retire(dealloc);
+
+    return dealloc;
+}
+
+//===------------------------------------------------------------------------===
+// • Reclamation
+//===------------------------------------------------------------------------===
+
+void EpochMutator::retire(const Atom* atom) noexcept(false)
+{
+    assert( AtomID::vector == atom->identifier );
+
+    // • Any reader within the atom entered at or before the current epoch
+    //
+    m_retired.push_back({ .offset = detail::distance(data(), atom), .epoch = m_epochs->epoch() });
+}
+
+size_t EpochMutator::reclaim(void) noexcept(false)
+{
+    if ( m_retired.empty() )
+    {
+        // • No-op
+        return 0;
+    }
+
+    // • Readers entering from now on only reach the current atoms
+    //
+    m_epochs->advance();
+
+    const auto min_epoch = m_epochs->min_reader_epoch();
+
+    // • Retired atoms stay 'vctr' atoms until freed, so the offsets of the
+    //   others remain those of atoms as each is merged into its neighbours
+    //
+    const auto reclaimed = std::erase_if( m_retired, [&](const Retired& retired)
+    {
+        if ( min_epoch <= retired.epoch ) {
+            return false;
+        }
+
+        Mutator::free( detail::offset_by(data(), retired.offset) );
+
+        return true;
+    });
+
+    return reclaimed;
+}
+
+} // namespace data
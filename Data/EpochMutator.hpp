@@ -0,0 +1,101 @@
+//
+//  EpochMutator.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Epoch.hpp>
+#include <Data/Mutator.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • EpochMutator
+//
+//===------------------------------------------------------------------------===
+
+// • Mutator that retires the atoms it relocates or frees rather than freeing
+//   them, and only reclaims them once no reader of the EpochDomain may still
+//   be within them, so that readers need no lock while one writer mutates
+//   the buffer. Atoms are only extended in place or copied, never shrunk.
+//   A relocation is observed as a reservation and a write of the copy, and
+//   the free as of reclaim(), so a Journal still replays the same layout
+//
+class EpochMutator : public Mutator
+{
+public:
+
+    // • Initialization
+    //
+    EpochMutator( Atom* data, uint32_t contents_length, EpochDomain& epochs,
+                  std::initializer_list<MutationObserver*> observers = { } ) noexcept(false);
+
+    // • Accessors
+    //
+    size_t retired_count(void) const noexcept
+    {
+        return m_retired.size();
+    }
+
+    // • Methods : allocation
+    //
+    using Mutator::reserve;
+
+    Atom* reserve(Atom* curr_alloc, uint32_t requested_contents_size) noexcept(false) override;
+
+    Atom* free(Atom* dealloc) noexcept(false) override;
+
+    // • Methods : reclamation
+    //
+    //      Called by the writer between mutations. Advances the epoch and frees
+    //      the retired atoms that no reader may still be within. Returns the
+    //      count freed
+    //
+    size_t reclaim(void) noexcept(false);
+
+private:
+
+    // • Utilities (private)
+    //
+    void retire(const Atom* atom) noexcept(false);
+
+private:
+
+    struct Retired
+    {
+        uint32_t    offset;     // Of the atom
+        uint64_t    epoch;
+    };
+
+private:
+
+    // • Data members
+    //
+    EpochDomain*         m_epochs;
+    std::vector<Retired> m_retired;
+};
+
+} // namespace data
@@ -0,0 +1,589 @@
+//
+//  FlatMap-Host.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/FlatMapRef.hpp>
+#include <Data/Vector-Host.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<FlatSetRef<int>>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<FlatMapRef<int, int>>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+// • Batch insertion utilities
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+template <class Key_>
+constexpr bool equivalent(const Key_& lhs, const Key_& rhs) noexcept
+{
+    return !(lhs < rhs) && !(rhs < lhs);
+}
+
+// • Merges the sorted inserted keys into the sorted keys from the back, so that
+//   the keys are only moved once. The keys must have room for both, and
+//   move(dest, source, is_inserted) is called for each key moved. Returns the
+//   index of the first key moved
+//
+template <TrivialLayout Key_, class Move_>
+uint32_t merge_backward( Key_* keys, uint32_t count, const Key_* inserted, uint32_t inserted_count,
+                         Move_&& move ) noexcept
+{
+    auto dest = count + inserted_count;
+
+    while ( 0 < inserted_count )
+    {
+        --dest;
+
+        if ( 0 < count && inserted[inserted_count - 1] < keys[count - 1] )
+        {
+            keys[dest] = keys[--count];
+            move(dest, count, false);
+        }
+        else
+        {
+            keys[dest] = inserted[--inserted_count];
+            move(dest, inserted_count, true);
+        }
+    }
+
+    return dest;
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • FlatSet
+//
+//===------------------------------------------------------------------------===
+
+// • Sorted set of keys in a 'vctr' atom. Keys are found by binary search and
+//   cannot be modified in place
+//
+template <TrivialLayout Key_>
+    requires std::totally_ordered<Key_>
+class FlatSet
+{
+public:
+
+    // • Types
+    //
+    using set_ref        = FlatSetRef<Key_>;
+    using key_type       = Key_;
+    using value_type     = Key_;
+    using size_type      = uint32_t;
+    using const_iterator = const Key_*;
+    using iterator       = const_iterator;
+
+public:
+
+    // • Initialization
+    //
+    FlatSet(set_ref& ref, Atom* data) noexcept(false)
+        :
+            m_keys   { ref.keys, data },
+            m_mutator{ nullptr        }
+    {
+    }
+
+    // • Initialization : observed mutations
+    //
+    FlatSet(set_ref& ref, Mutator& mutator) noexcept(false)
+        :
+            m_keys   { ref.keys, mutator },
+            m_mutator{ &mutator          }
+    {
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    FlatSet(const FlatSet& ) = delete;
+    FlatSet(FlatSet&& ) = delete;
+    FlatSet(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    FlatSet& operator = (const FlatSet& ) = delete;
+    FlatSet& operator = (FlatSet&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_keys.size();
+    }
+
+    bool empty(void) const noexcept
+    {
+        return m_keys.empty();
+    }
+
+    size_type capacity(void) const noexcept
+    {
+        return m_keys.capacity();
+    }
+
+    // • Accessors : std::range concept
+    //
+    const_iterator begin(void) const noexcept
+    {
+        return m_keys.cbegin();
+    }
+
+    const_iterator end(void) const noexcept
+    {
+        return m_keys.cend();
+    }
+
+    // • Accessors : search
+    //
+    const_iterator lower_bound(const key_type& key) const noexcept
+    {
+        return begin() + detail::lower_bound(begin(), size(), key);
+    }
+
+    const_iterator find(const key_type& key) const noexcept
+    {
+        const auto position = lower_bound(key);
+
+        return ( position != end() && !(key < *position) ) ? position : end();
+    }
+
+    bool contains(const key_type& key) const noexcept
+    {
+        return find(key) != end();
+    }
+
+    // • Methods : capacity
+    //
+    void reserve(size_type capacity) noexcept(false)
+    {
+        m_keys.reserve(capacity);
+    }
+
+    // • Methods : insertion
+    //
+    bool insert(const key_type& key) noexcept(false)
+    {
+        const auto position = lower_bound(key);
+
+        if ( position != end() && !(key < *position) )
+        {
+            return false;
+        }
+
+        m_keys.insert(position, key);
+
+        return true;
+    }
+
+    //      Sorts the new keys, then merges them in with one reservation.
+    //      Returns the count of keys inserted
+    //
+    template <std::forward_iterator FwdIter_>
+        requires std::is_convertible_v<typename std::iterator_traits<FwdIter_>::value_type, Key_>
+    size_type insert(FwdIter_ first, FwdIter_ last) noexcept(false)
+    {
+        auto inserted = std::vector<key_type>( first, last );
+
+        std::sort( inserted.begin(), inserted.end() );
+
+        inserted.erase( std::unique( inserted.begin(), inserted.end(), detail::equivalent<key_type> ), inserted.end() );
+
+        std::erase_if( inserted, [this](const auto& key) { return contains(key); } );
+
+        if ( inserted.empty() )
+        {
+            // • No-op
+            return 0;
+        }
+
+        const auto count          = size();
+        const auto inserted_count = static_cast<size_type>( inserted.size() );
+
+        auto keys = m_keys.resize_for_overwrite(count + inserted_count);
+
+        const auto first_moved = detail::merge_backward( keys.data(), count, inserted.data(), inserted_count,
+                                                         [](auto... ) {} );
+
+        did_write(keys.subspan(first_moved));
+
+        return inserted_count;
+    }
+
+    size_type insert(std::initializer_list<key_type> ilist) noexcept(false)
+    {
+        return insert( ilist.begin(), ilist.end() );
+    }
+
+    // • Methods : removal
+    //
+    size_type erase(const key_type& key) noexcept(false)
+    {
+        const auto position = find(key);
+
+        if ( position == end() )
+        {
+            return 0;
+        }
+
+        m_keys.erase(position);
+
+        return 1;
+    }
+
+    void clear(void) noexcept(false)
+    {
+        m_keys.clear();
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    void did_write(std::span<const key_type> keys) noexcept(false)
+    {
+        if ( nullptr != m_mutator )
+        {
+            m_mutator->write( keys.data(), static_cast<uint32_t>(keys.size_bytes()) );
+        }
+    }
+
+private:
+
+    // • Data members
+    //
+    Vector<key_type>    m_keys;
+    Mutator*            m_mutator;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • FlatMap
+//
+//===------------------------------------------------------------------------===
+
+// • Sorted map with its keys and values in separate 'vctr' atoms, so that the
+//   binary search only touches keys. Values may be modified in place; writes
+//   to an observed map are then reported with Mutator::write
+//
+template <TrivialLayout Key_, TrivialLayout Value_>
+    requires std::totally_ordered<Key_>
+class FlatMap
+{
+public:
+
+    // • Types
+    //
+    using map_ref     = FlatMapRef<Key_, Value_>;
+    using key_type    = Key_;
+    using mapped_type = Value_;
+    using size_type   = uint32_t;
+
+public:
+
+    // • Initialization
+    //
+    FlatMap(map_ref& ref, Atom* data) noexcept(false)
+        :
+            m_keys   { ref.keys,   data },
+            m_values { ref.values, data },
+            m_mutator{ nullptr          }
+    {
+        if ( ref.keys.count != ref.values.count ) {
+            throw false;
+        }
+    }
+
+    // • Initialization : observed mutations
+    //
+    FlatMap(map_ref& ref, Mutator& mutator) noexcept(false)
+        :
+            m_keys   { ref.keys,   mutator },
+            m_values { ref.values, mutator },
+            m_mutator{ &mutator            }
+    {
+        if ( ref.keys.count != ref.values.count ) {
+            throw false;
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    FlatMap(const FlatMap& ) = delete;
+    FlatMap(FlatMap&& ) = delete;
+    FlatMap(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    FlatMap& operator = (const FlatMap& ) = delete;
+    FlatMap& operator = (FlatMap&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_keys.size();
+    }
+
+    bool empty(void) const noexcept
+    {
+        return m_keys.empty();
+    }
+
+    // • Accessors : elements, in key order
+    //
+    std::span<const key_type> keys(void) const noexcept
+    {
+        return { m_keys.data(), size() };
+    }
+
+    std::span<mapped_type> values(void) noexcept
+    {
+        return { m_values.data(), size() };
+    }
+
+    std::span<const mapped_type> values(void) const noexcept
+    {
+        return { m_values.data(), size() };
+    }
+
+    // • Accessors : search
+    //
+    //      Index of the first key not less than key
+    //
+    size_type lower_bound(const key_type& key) const noexcept
+    {
+        return detail::lower_bound(m_keys.data(), size(), key);
+    }
+
+    mapped_type* find(const key_type& key) noexcept
+    {
+        const auto index = lower_bound(key);
+
+        return ( index < size() && !(key < m_keys[index]) ) ? m_values.data() + index : nullptr;
+    }
+
+    const mapped_type* find(const key_type& key) const noexcept
+    {
+        const auto index = lower_bound(key);
+
+        return ( index < size() && !(key < m_keys[index]) ) ? m_values.data() + index : nullptr;
+    }
+
+    bool contains(const key_type& key) const noexcept
+    {
+        return nullptr != find(key);
+    }
+
+    mapped_type& at(const key_type& key) noexcept(false)
+    {
+        auto value = find(key);
+
+        if ( nullptr == value ) {
+            throw false;
+        }
+
+        return *value;
+    }
+
+    const mapped_type& at(const key_type& key) const noexcept(false)
+    {
+        auto value = find(key);
+
+        if ( nullptr == value ) {
+            throw false;
+        }
+
+        return *value;
+    }
+
+    // • Methods : capacity
+    //
+    void reserve(size_type capacity) noexcept(false)
+    {
+        m_keys.reserve(capacity);
+        m_values.reserve(capacity);
+    }
+
+    // • Methods : insertion
+    //
+    //      Returns true if the key was inserted, false if its value was assigned
+    //
+    bool insert_or_assign(const key_type& key, const mapped_type& value) noexcept(false)
+    {
+        const auto index = lower_bound(key);
+
+        if ( index < size() && !(key < m_keys[index]) )
+        {
+            m_values[index] = value;
+
+            did_write( values().subspan(index, 1) );
+
+            return false;
+        }
+
+        // • Both atoms are reserved before either grows, so that a throw leaves
+        //   the keys and values the same length
+        //
+        reserve( size() + 1 );
+
+        m_keys.insert( m_keys.cbegin() + index, key );
+        m_values.insert( m_values.cbegin() + index, value );
+
+        return true;
+    }
+
+    //      As insert_or_assign for each pair in order, with the new keys sorted
+    //      and merged in with one reservation of each atom. Returns the count
+    //      of keys inserted
+    //
+    size_type insert_or_assign(std::span<const key_type> keys, std::span<const mapped_type> values) noexcept(false)
+    {
+        assert( keys.size() == values.size() );
+        assert( keys.size() <= std::numeric_limits<size_type>::max() );
+
+        // • Sorted order of the pairs, keeping the last of equivalent keys
+        //
+        auto order = std::vector<size_type>( keys.size() );
+
+        std::iota( order.begin(), order.end(), size_type{ 0 } );
+        std::stable_sort( order.begin(), order.end(), [&](auto lhs, auto rhs) { return keys[lhs] < keys[rhs]; } );
+
+        auto inserted_keys   = std::vector<key_type>{ };
+        auto inserted_values = std::vector<mapped_type>{ };
+
+        for ( auto position = size_t{ 0 }; position < order.size(); ++position )
+        {
+            const auto pair = order[position];
+
+            if ( position + 1 < order.size() && detail::equivalent(keys[pair], keys[order[position + 1]]) ) {
+                continue;
+            }
+
+            if ( auto value = find(keys[pair]) )
+            {
+                *value = values[pair];
+
+                did_write( std::span{ value, 1 } );
+            }
+            else
+            {
+                inserted_keys.push_back( keys[pair] );
+                inserted_values.push_back( values[pair] );
+            }
+        }
+
+        if ( inserted_keys.empty() )
+        {
+            // • No-op
+            return 0;
+        }
+
+        const auto count          = size();
+        const auto inserted_count = static_cast<size_type>( inserted_keys.size() );
+
+        reserve(count + inserted_count);
+
+        auto merged_keys   = m_keys.resize_for_overwrite(count + inserted_count);
+        auto merged_values = m_values.resize_for_overwrite(count + inserted_count);
+
+        const auto first_moved = detail::merge_backward( merged_keys.data(), count, inserted_keys.data(), inserted_count,
+            [&](auto dest, auto source, bool is_inserted) {
+                merged_values[dest] = is_inserted ? inserted_values[source] : merged_values[source];
+            });
+
+        did_write( merged_keys.subspan(first_moved) );
+        did_write( merged_values.subspan(first_moved) );
+
+        return inserted_count;
+    }
+
+    // • Methods : removal
+    //
+    size_type erase(const key_type& key) noexcept(false)
+    {
+        const auto index = lower_bound(key);
+
+        if ( size() <= index || key < m_keys[index] )
+        {
+            return 0;
+        }
+
+        m_keys.erase( m_keys.cbegin() + index );
+        m_values.erase( m_values.cbegin() + index );
+
+        return 1;
+    }
+
+    void clear(void) noexcept(false)
+    {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    template <class Type_>
+    void did_write(std::span<Type_> elements) noexcept(false)
+    {
+        if ( nullptr != m_mutator )
+        {
+            m_mutator->write( elements.data(), static_cast<uint32_t>(elements.size_bytes()) );
+        }
+    }
+
+private:
+
+    // • Data members
+    //
+    Vector<key_type>    m_keys;
+    Vector<mapped_type> m_values;
+    Mutator*            m_mutator;
+};
+
+} // namespace data
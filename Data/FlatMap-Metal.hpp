@@ -0,0 +1,99 @@
+//
+//  FlatMap-Metal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/FlatMapRef.hpp>
+#include <Data/Vector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • FlatSet utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+template <TRIVIAL_LAYOUT Key_>
+bool contains(FlatSetRef<Key_> ref, const device uint8_t* base, Key_ key)
+{
+    const device Key_* keys = contents(ref.keys, base);
+    const uint32_t     index = detail::lower_bound(keys, ref.keys.count, key);
+
+    return index < ref.keys.count && !(key < keys[index]);
+}
+
+#if !defined ( DATA_METAL_EMULATION )
+
+template <TRIVIAL_LAYOUT Key_>
+bool contains(FlatSetRef<Key_> ref, constant uint8_t* base, Key_ key)
+{
+    constant Key_* keys  = contents(ref.keys, base);
+    const uint32_t index = detail::lower_bound(keys, ref.keys.count, key);
+
+    return index < ref.keys.count && !(key < keys[index]);
+}
+
+#endif
+
+//===------------------------------------------------------------------------===
+//
+// • FlatMap utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+// • The value of key, or null if there is none
+//
+template <TRIVIAL_LAYOUT Key_, TRIVIAL_LAYOUT Value_>
+const device Value_* find(FlatMapRef<Key_, Value_> ref, const device uint8_t* base, Key_ key)
+{
+    const device Key_* keys  = contents(ref.keys, base);
+    const uint32_t     index = detail::lower_bound(keys, ref.keys.count, key);
+
+    return ( index < ref.keys.count && !(key < keys[index]) ) ? contents(ref.values, base) + index : nullptr;
+}
+
+template <TRIVIAL_LAYOUT Key_, TRIVIAL_LAYOUT Value_>
+device Value_* find(FlatMapRef<Key_, Value_> ref, device uint8_t* base, Key_ key)
+{
+    const device Key_* keys  = contents(ref.keys, static_cast<const device uint8_t*>(base));
+    const uint32_t     index = detail::lower_bound(keys, ref.keys.count, key);
+
+    return ( index < ref.keys.count && !(key < keys[index]) ) ? contents(ref.values, base) + index : nullptr;
+}
+
+#if !defined ( DATA_METAL_EMULATION )
+
+template <TRIVIAL_LAYOUT Key_, TRIVIAL_LAYOUT Value_>
+constant Value_* find(FlatMapRef<Key_, Value_> ref, constant uint8_t* base, Key_ key)
+{
+    constant Key_* keys  = contents(ref.keys, base);
+    const uint32_t index = detail::lower_bound(keys, ref.keys.count, key);
+
+    return ( index < ref.keys.count && !(key < keys[index]) ) ? contents(ref.values, base) + index : nullptr;
+}
+
+#endif
+
+} // namespace data
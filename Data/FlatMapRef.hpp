@@ -0,0 +1,85 @@
+//
+//  FlatMapRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • FlatSetRef, FlatMapRef
+//
+//===------------------------------------------------------------------------===
+
+// • Keys are sorted and unique. The values of a map are stored in a separate
+//   atom, in the order of their keys
+//
+template <TRIVIAL_LAYOUT Key_>
+struct FlatSetRef
+{
+    VectorRef<Key_>     keys;
+};
+
+template <TRIVIAL_LAYOUT Key_, TRIVIAL_LAYOUT Value_>
+struct FlatMapRef
+{
+    VectorRef<Key_>     keys;
+    VectorRef<Value_>   values;
+};
+
+static_assert(  8 ==  sizeof(FlatSetRef<int>), "Unexpected size" );
+static_assert( 16 ==  sizeof(FlatMapRef<int, int>), "Unexpected size" );
+static_assert(  4 == alignof(FlatMapRef<int, int>), "Unexpected alignment" );
+
+//===------------------------------------------------------------------------===
+// • Search (Host and Metal)
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+// • Index of the first key not less than key. The loop has a fixed trip count
+//   for a given count and selects without branching on the comparison
+//
+template <typename Pointer_, typename Key_>
+uint32_t lower_bound(Pointer_ keys, uint32_t count, Key_ key)
+{
+    uint32_t first = 0;
+
+    while ( 1 < count )
+    {
+        const uint32_t half = count / 2;
+
+        first  = ( keys[first + half] < key ) ? first + half : first;
+        count -= half;
+    }
+
+    return first + ( ( 1 == count && keys[first] < key ) ? 1 : 0 );
+}
+
+} // namespace detail
+
+} // namespace data
@@ -0,0 +1,586 @@
+//
+//  HashTable.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/HashTableRef.hpp>
+#include <Data/Vector.hpp>
+
+#include <bit>
+#include <cstring>
+
+#if defined ( __SSE2__ )
+#include <emmintrin.h>
+#elif defined ( __ARM_NEON ) && defined ( __aarch64__ )
+#include <arm_neon.h>
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<HashTableRef<int, int>>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • Hash
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+constexpr uint64_t mix(uint64_t value) noexcept
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111eb;
+    value ^= value >> 31;
+
+    return value;
+}
+
+// • Mixes the bytes 8 at a time, zero-padding the last word
+//
+inline uint64_t hash_bytes(const void* bytes, size_t length) noexcept
+{
+    auto hash = uint64_t{ length };
+
+    for ( auto offset = size_t{ 0 }; offset < length; offset += sizeof(uint64_t) )
+    {
+        auto word = uint64_t{ 0 };
+
+        std::memcpy( &word, static_cast<const uint8_t*>(bytes) + offset, std::min(sizeof(uint64_t), length - offset) );
+
+        hash = mix(hash ^ word);
+    }
+
+    return hash;
+}
+
+} // namespace detail
+
+// • The positions of keys in a stored table depend on their hashes, so a hash
+//   must give the same result in every process that reads the buffer. Keys
+//   with padding or floating point members need a specialization
+//
+template <class Key_>
+struct Hash
+{
+    static_assert( std::has_unique_object_representations_v<Key_>, "Hash must be specialized for this key type" );
+
+    uint64_t operator () (const Key_& key) const noexcept
+    {
+        return detail::hash_bytes( &key, sizeof(Key_) );
+    }
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Control groups
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+enum : uint8_t
+{
+    // • Full slots hold the low 7 bits of their key's hash
+    //
+    control_empty  = 0x80,
+    control_erased = 0xfe,
+};
+
+enum : uint32_t
+{
+    group_length = 16
+};
+
+// • Bit masks of the matching control bytes of a group, one bit per slot
+//
+#if defined ( __SSE2__ )
+
+inline uint32_t match_control(const uint8_t* group, uint8_t control) noexcept
+{
+    const auto bytes = _mm_load_si128( reinterpret_cast<const __m128i*>(group) );
+
+    return static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(control))) ) );
+}
+
+inline uint32_t match_available(const uint8_t* group) noexcept
+{
+    return static_cast<uint32_t>( _mm_movemask_epi8( _mm_load_si128( reinterpret_cast<const __m128i*>(group) ) ) );
+}
+
+#elif defined ( __ARM_NEON ) && defined ( __aarch64__ )
+
+inline uint32_t movemask(uint8x16_t matches) noexcept
+{
+    const auto weights = uint8x16_t{ 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const auto bits    = vandq_u8(matches, weights);
+
+    return vaddv_u8( vget_low_u8(bits) ) | ( uint32_t{ vaddv_u8( vget_high_u8(bits) ) } << 8 );
+}
+
+inline uint32_t match_control(const uint8_t* group, uint8_t control) noexcept
+{
+    return movemask( vceqq_u8( vld1q_u8(group), vdupq_n_u8(control) ) );
+}
+
+inline uint32_t match_available(const uint8_t* group) noexcept
+{
+    return movemask( vtstq_u8( vld1q_u8(group), vdupq_n_u8(0x80) ) );
+}
+
+#else
+
+inline uint32_t match_control(const uint8_t* group, uint8_t control) noexcept
+{
+    auto result = uint32_t{ 0 };
+
+    for ( auto slot = uint32_t{ 0 }; slot < group_length; ++slot ) {
+        result |= ( control == group[slot] ) ? 1u << slot : 0u;
+    }
+
+    return result;
+}
+
+inline uint32_t match_available(const uint8_t* group) noexcept
+{
+    auto result = uint32_t{ 0 };
+
+    for ( auto slot = uint32_t{ 0 }; slot < group_length; ++slot ) {
+        result |= ( 0 != (0x80 & group[slot]) ) ? 1u << slot : 0u;
+    }
+
+    return result;
+}
+
+#endif
+
+inline uint32_t match_empty(const uint8_t* group) noexcept
+{
+    return match_control(group, control_empty);
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • HashTable
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Key_, TrivialLayout Value_>
+struct HashSlot
+{
+    Key_    key;
+    Value_  value;
+};
+
+// • Open addressing table in a 'vctr' atom. Slots are probed a group of 16 at a
+//   time, matching the 7 bit hash tags of the group with one SIMD comparison,
+//   from group to group in triangular order. Positions are relative to the
+//   contents, so a mapped buffer is used as is
+//
+template <TrivialLayout Key_, TrivialLayout Value_, class Hash_ = Hash<Key_>>
+    requires std::equality_comparable<Key_>
+class HashTable
+{
+public:
+
+    // • Types
+    //
+    using table_ref   = HashTableRef<Key_, Value_>;
+    using key_type    = Key_;
+    using mapped_type = Value_;
+    using slot_type   = HashSlot<Key_, Value_>;
+    using size_type   = uint32_t;
+
+    static_assert( alignof(slot_type) <= alignment, "Unexpected alignment" );
+
+public:
+
+    // • Initialization
+    //
+    HashTable(table_ref& ref, Atom* data) noexcept(false)
+        :
+            m_ref { ref     },
+            m_data{ data    },
+            m_vctr{ nullptr }
+    {
+        if ( 0 != m_ref.capacity )
+        {
+            if (   !std::has_single_bit(m_ref.capacity)
+                || m_ref.capacity < detail::group_length
+                || m_ref.capacity - m_ref.erased < m_ref.count )
+            {
+                throw false;
+            }
+
+            m_vctr = detail::allocation_header( VectorRef<uint8_t>{ m_ref.offset, table_length(m_ref.capacity) }, m_data );
+        }
+        else if ( 0 != m_ref.offset || 0 != m_ref.count || 0 != m_ref.erased )
+        {
+            throw false;
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    HashTable(const HashTable& ) = delete;
+    HashTable(HashTable&& ) = delete;
+    HashTable(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    HashTable& operator = (const HashTable& ) = delete;
+    HashTable& operator = (HashTable&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_ref.count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_ref.count;
+    }
+
+    size_type capacity(void) const noexcept
+    {
+        return m_ref.capacity;
+    }
+
+    // • Accessors : search
+    //
+    mapped_type* find(const key_type& key) noexcept
+    {
+        const auto slot = find_slot(key);
+
+        return ( nullptr != slot ) ? &slot->value : nullptr;
+    }
+
+    const mapped_type* find(const key_type& key) const noexcept
+    {
+        const auto slot = const_cast<HashTable*>(this)->find_slot(key);
+
+        return ( nullptr != slot ) ? &slot->value : nullptr;
+    }
+
+    bool contains(const key_type& key) const noexcept
+    {
+        return nullptr != find(key);
+    }
+
+    mapped_type& at(const key_type& key) noexcept(false)
+    {
+        auto value = find(key);
+
+        if ( nullptr == value ) {
+            throw false;
+        }
+
+        return *value;
+    }
+
+    const mapped_type& at(const key_type& key) const noexcept(false)
+    {
+        auto value = find(key);
+
+        if ( nullptr == value ) {
+            throw false;
+        }
+
+        return *value;
+    }
+
+    // • Accessors : iteration, in slot order
+    //
+    template <class Function_>
+    void for_each(Function_&& function) const
+    {
+        for ( auto slot = uint32_t{ 0 }; slot < m_ref.capacity; ++slot )
+        {
+            if ( 0 == (0x80 & controls()[slot]) ) {
+                function( slots()[slot].key, slots()[slot].value );
+            }
+        }
+    }
+
+    // • Methods : capacity
+    //
+    //      Grows the table so that count keys fit within the maximum load
+    //
+    void reserve(size_type count) noexcept(false)
+    {
+        if ( count <= max_load(m_ref.capacity) - m_ref.erased )
+        {
+            // • No-op
+            //
+            return;
+        }
+
+        rehash( capacity_for( std::max(count, m_ref.count) ) );
+    }
+
+    // • Methods : insertion
+    //
+    //      Returns true if the key was inserted, false if its value was assigned
+    //
+    bool insert_or_assign(const key_type& key, const mapped_type& value) noexcept(false)
+    {
+        const auto hash = Hash_{ }(key);
+
+        if ( auto slot = find_slot(key, hash) )
+        {
+            slot->value = value;
+            return false;
+        }
+
+        if ( max_load(m_ref.capacity) < m_ref.count + m_ref.erased + 1 )
+        {
+            // • Reclaim the erased slots, growing unless most of the load is erased
+            //
+            rehash( capacity_for(m_ref.count + 1) );
+        }
+
+        const auto slot = insert_slot(hash);
+
+        m_ref.erased -= ( detail::control_erased == controls()[slot] ) ? 1 : 0;
+        ++m_ref.count;
+
+        controls()[slot] = tag(hash);
+        slots()[slot]    = { .key = key, .value = value };
+
+        return true;
+    }
+
+    // • Methods : removal
+    //
+    size_type erase(const key_type& key) noexcept
+    {
+        const auto slot_ptr = find_slot(key);
+
+        if ( nullptr == slot_ptr )
+        {
+            return 0;
+        }
+
+        const auto slot  = static_cast<uint32_t>( slot_ptr - slots() );
+        const auto group = controls() + (slot & ~(detail::group_length - 1));
+
+        // • A probe stops at the first group with an empty slot, so a slot in
+        //   such a group can be emptied rather than marked as erased
+        //
+        if ( 0 != detail::match_empty(group) )
+        {
+            controls()[slot] = detail::control_empty;
+        }
+        else
+        {
+            controls()[slot] = detail::control_erased;
+            ++m_ref.erased;
+        }
+
+        --m_ref.count;
+
+        return 1;
+    }
+
+    void clear(void) noexcept
+    {
+        if ( 0 != m_ref.capacity ) {
+            std::memset( controls(), detail::control_empty, m_ref.capacity );
+        }
+
+        m_ref.count  = 0;
+        m_ref.erased = 0;
+    }
+
+private:
+
+    // • Utilities (private) : layout
+    //
+    static uint32_t table_length(uint32_t capacity) noexcept(false)
+    {
+        if ( (std::numeric_limits<uint32_t>::max() - capacity) / sizeof(slot_type) < capacity ) {
+            throw false;
+        }
+
+        return static_cast<uint32_t>( capacity + capacity * sizeof(slot_type) );
+    }
+
+    static constexpr uint32_t max_load(uint32_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    static uint32_t capacity_for(uint32_t count) noexcept(false)
+    {
+        auto capacity = uint32_t{ detail::group_length };
+
+        while ( max_load(capacity) < count )
+        {
+            if ( std::numeric_limits<uint32_t>::max() / 2 < capacity ) {
+                throw false;
+            }
+
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    uint8_t* controls(void) const noexcept
+    {
+        return detail::contents<uint8_t>(m_vctr);
+    }
+
+    slot_type* slots(void) const noexcept
+    {
+        return reinterpret_cast<slot_type*>( controls() + m_ref.capacity );
+    }
+
+    static uint8_t tag(uint64_t hash) noexcept
+    {
+        return static_cast<uint8_t>( hash & 0x7f );
+    }
+
+    uint32_t first_group(uint64_t hash) const noexcept
+    {
+        return static_cast<uint32_t>( hash >> 7 ) & ( m_ref.capacity / detail::group_length - 1 );
+    }
+
+    // • Utilities (private) : probing
+    //
+    slot_type* find_slot(const key_type& key) noexcept
+    {
+        return find_slot( key, Hash_{ }(key) );
+    }
+
+    slot_type* find_slot(const key_type& key, uint64_t hash) noexcept
+    {
+        if ( 0 == m_ref.count ) {
+            return nullptr;
+        }
+
+        const auto group_mask = m_ref.capacity / detail::group_length - 1;
+
+        for ( auto group = first_group(hash), step = uint32_t{ 0 }; step <= group_mask; group = (group + ++step) & group_mask )
+        {
+            const auto first = group * detail::group_length;
+
+            for ( auto matches = detail::match_control(controls() + first, tag(hash)); 0 != matches; matches &= matches - 1 )
+            {
+                auto slot = slots() + first + std::countr_zero(matches);
+
+                if ( slot->key == key ) {
+                    return slot;
+                }
+            }
+
+            if ( 0 != detail::match_empty(controls() + first) ) {
+                break;
+            }
+        }
+
+        return nullptr;
+    }
+
+    //      First empty or erased slot on the probe sequence of hash, which the
+    //      load limit guarantees
+    //
+    uint32_t insert_slot(uint64_t hash) noexcept
+    {
+        const auto group_mask = m_ref.capacity / detail::group_length - 1;
+
+        for ( auto group = first_group(hash), step = uint32_t{ 0 }; ; group = (group + ++step) & group_mask )
+        {
+            const auto first = group * detail::group_length;
+
+            if ( auto available = detail::match_available(controls() + first) ) {
+                return first + std::countr_zero(available);
+            }
+        }
+    }
+
+    // • Utilities (private) : rehash
+    //
+    //      Reinserts each key into a new atom, then frees the current one
+    //
+    void rehash(uint32_t capacity) noexcept(false)
+    {
+        assert( m_ref.count <= max_load(capacity) );
+
+        auto prev_vctr     = m_vctr;
+        auto prev_capacity = m_ref.capacity;
+        auto prev_controls = ( nullptr != prev_vctr ) ? controls() : nullptr;
+        auto prev_slots    = ( nullptr != prev_vctr ) ? slots() : nullptr;
+
+        m_vctr         = detail::reserve( m_data, table_length(capacity), AtomID::vector );
+        m_ref.offset   = detail::contents_offset(m_data, m_vctr);
+        m_ref.capacity = capacity;
+        m_ref.erased   = 0;
+
+        std::memset( controls(), detail::control_empty, capacity );
+
+        for ( auto slot = uint32_t{ 0 }; slot < prev_capacity; ++slot )
+        {
+            if ( 0 != (0x80 & prev_controls[slot]) ) {
+                continue;
+            }
+
+            const auto hash = Hash_{ }(prev_slots[slot].key);
+            const auto dest = insert_slot(hash);
+
+            controls()[dest] = tag(hash);
+            slots()[dest]    = prev_slots[slot];
+        }
+
+        if ( nullptr != prev_vctr ) {
+            detail::free(prev_vctr);
+        }
+    }
+
+private:
+
+    // • Data members
+    //
+    table_ref&  m_ref;
+    Atom*       m_data;
+    Atom*       m_vctr;
+};
+
+} // namespace data
@@ -0,0 +1,244 @@
+//
+//  Image.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Atom.hpp>
+#include <Data/VectorRef.hpp>
+
+#include <array>
+#include <bit>
+#include <ranges>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Images
+//
+//      A complete formatted buffer built in constant evaluation, to be placed
+//      in read-only data with no work at startup:
+//
+//  constexpr auto image = []
+//  {
+//      auto builder = ImageBuilder<Root, length>{ };
+//      auto root    = Root{ .keys = builder.add_vector(keys) };
+//
+//      builder.set_root(root);
+//
+//      return builder.finish();
+//  }();
+//
+//      format, the allocator and Vector address the buffer through Atom
+//      pointers, which constant evaluation can't, so the builder writes the
+//      same layout byte by byte instead. Values are written with bit_cast,
+//      which can't write padding, so types with padding are a compile error;
+//      give them explicit reserved members, as Atom has
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Root_, uint32_t Length_>
+struct alignas(alignment) Image
+{
+    std::array<uint8_t, Length_> bytes;
+
+    // • Accessors
+    //
+    static constexpr uint32_t size(void) noexcept
+    {
+        return Length_;
+    }
+
+    const Atom* data(void) const noexcept(false)
+    {
+        return data_atom( bytes.data(), Length_ );
+    }
+
+    const Root_* root(void) const noexcept(false)
+    {
+        return detail::contents<Root_>( data() );
+    }
+};
+
+//===------------------------------------------------------------------------===
+//
+// • ImageBuilder
+//
+//      Lays out the 'data' atom, then one 'vctr' atom per added vector in
+//      order, then a 'free' atom for any remaining length and the 'end ' atom.
+//      A length of plan_length<Root>(counts) leaves no 'free' atom
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Root_, uint32_t Length_>
+class ImageBuilder
+{
+public:
+
+    // • Types
+    //
+    using image_type = Image<Root_, Length_>;
+
+    static_assert( is_aligned(Length_), "Unaligned image length" );
+    static_assert( atom_header_length + aligned_size<Root_>() + atom_header_length <= Length_,
+                   "Image too short for its root" );
+
+public:
+
+    // • Initialization
+    //
+    constexpr ImageBuilder(void) noexcept
+        :
+            m_image   { },
+            m_end     { atom_header_length + aligned_size<Root_>() },
+            m_previous{ m_end }
+    {
+        write_atom( 0, m_end, AtomID::data, 0 );
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    ImageBuilder(const ImageBuilder& ) = delete;
+    ImageBuilder(ImageBuilder&& ) = delete;
+
+    // • Assignment (deleted)
+    //
+    ImageBuilder& operator = (const ImageBuilder& ) = delete;
+    ImageBuilder& operator = (ImageBuilder&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    constexpr uint32_t available(void) const noexcept
+    {
+        return Length_ - atom_header_length - m_end;
+    }
+
+    // • Methods
+    //
+    //      Adds a 'vctr' atom with a copy of the values, unless empty
+    //
+    template <std::ranges::contiguous_range Range_>
+        requires TrivialLayout<std::ranges::range_value_t<Range_>>
+    constexpr auto add_vector(const Range_& values) noexcept(false)
+        -> VectorRef<std::ranges::range_value_t<Range_>>
+    {
+        using value_type = std::ranges::range_value_t<Range_>;
+
+        const auto count = std::ranges::size(values);
+
+        if ( 0 == count ) {
+            return { .offset = 0, .count = 0 };
+        }
+
+        const auto contents_size = uint64_t{ count } * sizeof(value_type);
+        const auto length        = atom_header_length + ( ( contents_size + alignment - 1 ) & ~uint64_t{ alignment - 1 } );
+
+        if ( available() < length ) {
+            throw false;
+        }
+
+        write_atom( m_end, static_cast<uint32_t>(length), AtomID::vector, m_previous );
+
+        auto offset = m_end + atom_header_length;
+
+        for ( const auto& value : values )
+        {
+            write_value( offset, value );
+
+            offset += sizeof(value_type);
+        }
+
+        const auto ref = VectorRef<value_type>{
+            .offset = m_end + atom_header_length,
+            .count  = static_cast<uint32_t>(count)
+        };
+
+        m_previous = static_cast<uint32_t>(length);
+        m_end     += static_cast<uint32_t>(length);
+
+        return ref;
+    }
+
+    //      The root usually holds the references returned by add_vector, so is
+    //      set last
+    //
+    constexpr void set_root(const Root_& root) noexcept
+    {
+        write_value( atom_header_length, root );
+    }
+
+    constexpr image_type finish(void) noexcept
+    {
+        auto previous = m_previous;
+
+        if ( 0 < available() )
+        {
+            write_atom( m_end, available(), AtomID::free, previous );
+
+            previous = available();
+        }
+
+        write_atom( Length_ - atom_header_length, atom_header_length, AtomID::end, previous );
+
+        return m_image;
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    template <TrivialLayout Type_>
+    constexpr void write_value(uint32_t offset, const Type_& value) noexcept
+    {
+        const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(Type_)>>(value);
+
+        for ( auto index = size_t{ 0 }; index < bytes.size(); ++index ) {
+            m_image.bytes[offset + index] = bytes[index];
+        }
+    }
+
+    constexpr void write_atom(uint32_t offset, uint32_t length, AtomID identifier, uint32_t previous) noexcept
+    {
+        write_value( offset, Atom{
+            .length     = length,
+            .identifier = identifier,
+            .previous   = previous,
+            .reserved   = 0
+        } );
+    }
+
+private:
+
+    // • Data members
+    //
+    image_type  m_image;
+    uint32_t    m_end;
+    uint32_t    m_previous;
+};
+
+} // namespace data
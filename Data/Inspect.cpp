@@ -0,0 +1,235 @@
+//
+//  Inspect.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Inspect.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Atom chain
+//
+//===------------------------------------------------------------------------===
+
+std::vector<AtomEntry> atom_chain(const void* contents, uint32_t contents_length) noexcept(false)
+{
+    if ( !valid_alignment_and_length(contents, contents_length) ) {
+        throw false;
+    }
+
+    const auto data  = reinterpret_cast<const Atom*>(contents);
+    auto       chain = std::vector<AtomEntry>{ };
+
+    for ( auto offset = uint32_t{ 0 }; offset <= contents_length - atom_header_length ; )
+    {
+        const auto atom = detail::offset_by(data, offset);
+
+        chain.push_back({
+            .offset     = offset,
+            .identifier = atom->identifier,
+            .length     = atom->length,
+            .previous   = atom->previous
+        });
+
+        // • Stop at 'end ', or at a length that would not move forward within
+        //   the contents
+        //
+        if (   detail::is_end(atom)
+            || !is_aligned(atom->length)
+            || atom->length < atom_header_length
+            || contents_length - offset < atom->length )
+        {
+            break;
+        }
+
+        offset += atom->length;
+    }
+
+    return chain;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Free space
+//
+//===------------------------------------------------------------------------===
+
+FreeSpace free_space(const void* contents, [[maybe_unused]] uint32_t contents_length) noexcept
+{
+    assert( validate_layout(contents, contents_length) );
+
+    auto free_space = FreeSpace{ };
+    auto data       = reinterpret_cast<const Atom*>(contents);
+
+    for ( auto atom = detail::next(data); !detail::is_end(atom); atom = detail::next(atom) )
+    {
+        if ( AtomID::free != atom->identifier ) {
+            continue;
+        }
+
+        free_space.free_length  += atom->length;
+        free_space.free_count   += 1;
+        free_space.largest_free  = std::max(free_space.largest_free, atom->length);
+
+        free_space.histogram[ std::bit_width(atom->length) - 1 ] += 1;
+    }
+
+    return free_space;
+}
+
+std::string occupancy_map(const void* contents, uint32_t contents_length, uint32_t cell_count) noexcept(false)
+{
+    assert( validate_layout(contents, contents_length) );
+
+    if ( 0 == cell_count ) {
+        throw false;
+    }
+
+    // • Cells of (nearly) equal length, and the cell of a byte offset
+    //
+    const auto cells      = std::min(cell_count, contents_length);
+    const auto cell_begin = [&](uint64_t cell) { return cell * contents_length / cells; };
+    const auto cell_of    = [&](uint64_t offset) {
+        auto cell = offset * cells / contents_length;
+
+        while ( offset < cell_begin(cell) ) {
+            --cell;
+        }
+
+        while ( cell_begin(cell + 1) <= offset ) {
+            ++cell;
+        }
+
+        return cell;
+    };
+
+    auto free_bytes = std::vector<uint64_t>( cells, 0 );
+    auto data       = reinterpret_cast<const Atom*>(contents);
+
+    for ( auto atom = detail::next(data); !detail::is_end(atom); atom = detail::next(atom) )
+    {
+        if ( AtomID::free != atom->identifier ) {
+            continue;
+        }
+
+        const auto begin = uint64_t{ detail::distance(data, atom) };
+        const auto end   = begin + atom->length;
+
+        for ( auto cell = cell_of(begin); cell < cells && cell_begin(cell) < end; ++cell ) {
+            free_bytes[cell] += std::min(end, cell_begin(cell + 1)) - std::max(begin, cell_begin(cell));
+        }
+    }
+
+    auto map = std::string( cells, '#' );
+
+    for ( auto cell = uint32_t{ 0 }; cell < cells; ++cell )
+    {
+        if ( free_bytes[cell] == cell_begin(cell + 1) - cell_begin(cell) ) {
+            map[cell] = '.';
+        }
+        else if ( 0 < free_bytes[cell] ) {
+            map[cell] = ':';
+        }
+    }
+
+    return map;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Vector usage
+//
+//===------------------------------------------------------------------------===
+
+std::vector<VectorUsage> vector_usage( const void* contents, [[maybe_unused]] uint32_t contents_length,
+                                       std::span<const VectorField> fields ) noexcept(false)
+{
+    assert( validate_layout(contents, contents_length) );
+
+    const auto data = reinterpret_cast<const Atom*>(contents);
+    const auto root = detail::contents<uint8_t>(data);
+
+    // • Offsets of the 'vctr' atoms, so that references into the middle of
+    //   an atom are not read as a header
+    //
+    auto vectors = std::vector<uint32_t>{ };
+
+    for ( auto atom = detail::next(data); !detail::is_end(atom); atom = detail::next(atom) )
+    {
+        if ( AtomID::vector == atom->identifier ) {
+            vectors.push_back( detail::distance(data, atom) );
+        }
+    }
+
+    auto usage = std::vector<VectorUsage>{ };
+
+    usage.reserve( fields.size() );
+
+    for ( const auto& field : fields )
+    {
+        auto entry = VectorUsage{
+            .field            = field,
+            .count            = 0,
+            .used_length      = 0,
+            .allocated_length = 0,
+            .is_valid         = false
+        };
+
+        if ( uint64_t{ field.offset } + sizeof(VectorRef<uint8_t>) <= detail::contents_size(data) )
+        {
+            auto ref = VectorRef<uint8_t>{ };
+
+            std::memcpy( &ref, root + field.offset, sizeof(ref) );
+
+            const auto used_length = uint64_t{ ref.count } * field.element_size;
+
+            entry.count       = ref.count;
+            entry.used_length = static_cast<uint32_t>( std::min<uint64_t>(used_length, std::numeric_limits<uint32_t>::max()) );
+
+            if ( 0 == ref.offset )
+            {
+                entry.is_valid = 0 == ref.count;
+            }
+            else if ( atom_header_length <= ref.offset
+                      && std::binary_search( vectors.begin(), vectors.end(), ref.offset - atom_header_length ) )
+            {
+                const auto atom = detail::offset_by(data, ref.offset - atom_header_length);
+
+                entry.allocated_length = detail::contents_size(atom);
+                entry.is_valid         = used_length <= entry.allocated_length;
+            }
+        }
+
+        usage.push_back(entry);
+    }
+
+    return usage;
+}
+
+} // namespace data
@@ -0,0 +1,122 @@
+//
+//  Inspect.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Atom.hpp>
+#include <Data/Schema.hpp>
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Inspection
+//
+//      Reports on a formatted buffer for diagnostics, for example a buffer
+//      dumped to disk. Except for atom_chain, these expect a buffer that
+//      passes validate_layout
+//
+//===------------------------------------------------------------------------===
+
+//===------------------------------------------------------------------------===
+// • Atom chain
+//===------------------------------------------------------------------------===
+
+struct AtomEntry
+{
+    uint32_t    offset;     // Offset from the beginning of the 'data' atom
+    AtomID      identifier;
+    uint32_t    length;
+    uint32_t    previous;
+};
+
+// • The atoms from 'data' forward, up to 'end ' or up to the first atom whose
+//   length doesn't fit in the contents, so that the atoms of an invalid buffer
+//   can be listed up to the fault
+//
+std::vector<AtomEntry> atom_chain(const void* contents, uint32_t contents_length) noexcept(false);
+
+//===------------------------------------------------------------------------===
+// • Free space
+//===------------------------------------------------------------------------===
+
+struct FreeSpace
+{
+    uint64_t    free_length;    // Of all 'free' atoms, headers included
+    uint32_t    free_count;
+    uint32_t    largest_free;
+
+    // • Count of 'free' atoms by power of two, from [2^i, 2^(i+1)) bytes
+    //
+    std::array<uint32_t, 32> histogram;
+
+    // • 0 when all the free space is one atom, approaching 1 as it is split
+    //   into many small atoms
+    //
+    double fragmentation(void) const noexcept
+    {
+        return 0 == free_length ? 0.0 : 1.0 - double(largest_free) / double(free_length);
+    }
+};
+
+FreeSpace free_space(const void* contents, uint32_t contents_length) noexcept;
+
+// • One character per cell of the contents, split into cell_count cells of
+//   equal length: '#' for no free bytes, '.' for only free bytes and ':' for
+//   cells in part free
+//
+std::string occupancy_map(const void* contents, uint32_t contents_length, uint32_t cell_count) noexcept(false);
+
+//===------------------------------------------------------------------------===
+// • Vector usage
+//===------------------------------------------------------------------------===
+
+struct VectorUsage
+{
+    VectorField field;
+    uint32_t    count;
+    uint32_t    used_length;        // count elements of the field
+    uint32_t    allocated_length;   // Contents of the 'vctr' atom
+    bool        is_valid;           // The reference is in the root, and to a
+                                    // 'vctr' atom large enough for count
+
+    uint32_t reclaimable(void) const noexcept
+    {
+        return is_valid ? allocated_length - used_length : 0;
+    }
+};
+
+// • The VectorRef of the root at each field, as described by a schema read
+//   at run time instead of vector_fields, with the bytes allocated beyond
+//   their count
+//
+std::vector<VectorUsage> vector_usage( const void* contents, uint32_t contents_length,
+                                       std::span<const VectorField> fields ) noexcept(false);
+
+} // namespace data
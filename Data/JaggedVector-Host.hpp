@@ -0,0 +1,272 @@
+//
+//  JaggedVector-Host.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/JaggedVectorRef.hpp>
+#include <Data/Parallel.hpp>
+#include <Data/Vector-Host.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<JaggedVectorRef<int>>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • JaggedVector
+//
+//===------------------------------------------------------------------------===
+
+// • Vector of variable length rows in two 'vctr' atoms, one of row offsets and
+//   one of the values of every row. Rows are only appended
+//
+template <TrivialLayout Type_>
+class JaggedVector
+{
+public:
+
+    // • Types
+    //
+    using jagged_ref = JaggedVectorRef<Type_>;
+    using value_type = Type_;
+    using size_type  = uint32_t;
+    using row_type   = std::span<value_type>;
+
+public:
+
+    // • Initialization
+    //
+    JaggedVector(jagged_ref& ref, Atom* data) noexcept(false)
+        :
+            m_offsets{ ref.offsets, data },
+            m_values { ref.values,  data }
+    {
+        const auto is_valid = m_offsets.empty()
+            ? m_values.empty()
+            : 0 == m_offsets.front() && m_values.size() == m_offsets.back();
+
+        if ( !is_valid ) {
+            throw false;
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    JaggedVector(const JaggedVector& ) = delete;
+    JaggedVector(JaggedVector&& ) = delete;
+    JaggedVector(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    JaggedVector& operator = (const JaggedVector& ) = delete;
+    JaggedVector& operator = (JaggedVector&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == size();
+    }
+
+    size_type value_count(void) const noexcept
+    {
+        return m_values.size();
+    }
+
+    // • Accessors : rows
+    //
+    std::span<value_type> row(size_type index) noexcept
+    {
+        assert( index < size() );
+
+        return { m_values.data() + m_offsets[index], m_offsets[index + 1] - m_offsets[index] };
+    }
+
+    std::span<const value_type> row(size_type index) const noexcept
+    {
+        assert( index < size() );
+
+        return { m_values.data() + m_offsets[index], m_offsets[index + 1] - m_offsets[index] };
+    }
+
+    std::span<value_type> operator [] (size_type index) noexcept
+    {
+        return row(index);
+    }
+
+    std::span<const value_type> operator [] (size_type index) const noexcept
+    {
+        return row(index);
+    }
+
+    // • Accessors : all values, in row order
+    //
+    std::span<value_type> values(void) noexcept
+    {
+        return { m_values.data(), m_values.size() };
+    }
+
+    std::span<const value_type> values(void) const noexcept
+    {
+        return { m_values.data(), m_values.size() };
+    }
+
+    // • Methods : capacity
+    //
+    void reserve(size_type row_count, size_type value_count) noexcept(false)
+    {
+        m_offsets.reserve(row_count + 1);
+        m_values.reserve(value_count);
+    }
+
+    // • Methods : rows
+    //
+    void push_back(std::span<const value_type> row) noexcept(false)
+    {
+        const auto count = static_cast<size_type>( row.size() );
+
+        append( row, std::span{ &count, 1 } );
+    }
+
+    //      Appends the rows of counts[r] values each, taken in order from
+    //      values, with one reservation of each atom
+    //
+    void append(std::span<const value_type> values, std::span<const size_type> counts) noexcept(false)
+    {
+        auto total = uint64_t{ value_count() };
+
+        for ( auto count : counts ) {
+            total += count;
+        }
+
+        if ( total - value_count() != values.size() || std::numeric_limits<size_type>::max() < total ) {
+            throw false;
+        }
+
+        prepare_rows(counts.size());
+
+        reserve_for_append( m_offsets, static_cast<size_type>(counts.size()) );
+        reserve_for_append( m_values, static_cast<size_type>(values.size()) );
+
+        auto offsets = m_offsets.append_uninitialized( static_cast<size_type>(counts.size()) );
+        auto offset  = value_count();
+
+        for ( auto index = size_t{ 0 }; index < counts.size(); ++index )
+        {
+            offset        += counts[index];
+            offsets[index] = offset;
+        }
+
+        auto dest = m_values.append_uninitialized( static_cast<size_type>(values.size()) );
+
+        std::copy( values.begin(), values.end(), dest.begin() );
+    }
+
+    //      Appends rows of counts[r] values each, computing the offsets with a
+    //      parallel prefix sum. The values are left for the caller to write,
+    //      for example from parallel::for_each over the new rows
+    //
+    void append_for_overwrite(ThreadPool& pool, std::span<const size_type> counts) noexcept(false)
+    {
+        const auto value_offset = value_count();
+        const auto total        = parallel::reduce( pool, counts, uint64_t{ value_offset } );
+
+        if ( std::numeric_limits<size_type>::max() < total ) {
+            throw false;
+        }
+
+        prepare_rows(counts.size());
+
+        reserve_for_append( m_offsets, static_cast<size_type>(counts.size()) );
+        reserve_for_append( m_values, static_cast<size_type>(total - value_offset) );
+
+        auto offsets = m_offsets.append_uninitialized( static_cast<size_type>(counts.size()) );
+
+        parallel::inclusive_scan( pool, counts, offsets );
+
+        if ( 0 < value_offset ) {
+            parallel::for_each( pool, offsets, [value_offset](auto& offset) { offset += value_offset; } );
+        }
+
+        m_values.append_uninitialized( static_cast<size_type>(total - value_offset) );
+    }
+
+    void clear(void) noexcept(false)
+    {
+        m_offsets.clear();
+        m_values.clear();
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    //      Adds the leading zero offset before the first row
+    //
+    void prepare_rows(size_t row_count) noexcept(false)
+    {
+        if ( std::numeric_limits<size_type>::max() - 1 - m_offsets.size() < row_count ) {
+            throw false;
+        }
+
+        if ( m_offsets.empty() && 0 < row_count )
+        {
+            m_offsets.reserve( static_cast<size_type>(row_count + 1) );
+            m_offsets.push_back(0);
+        }
+    }
+
+    //      Grows by half again, so that appending one row at a time is
+    //      amortized
+    //
+    template <TrivialLayout Element_>
+    static void reserve_for_append(Vector<Element_>& vector, size_type count) noexcept(false)
+    {
+        if ( vector.available() < count ) {
+            vector.reserve( std::max(vector.size() + count, vector.size() + vector.size() / 2) );
+        }
+    }
+
+private:
+
+    // • Data members
+    //
+    Vector<uint32_t>    m_offsets;
+    Vector<value_type>  m_values;
+};
+
+} // namespace data
@@ -0,0 +1,64 @@
+//
+//  JaggedVector-Metal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/JaggedVectorRef.hpp>
+#include <Data/Vector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • JaggedVector utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+template <TRIVIAL_LAYOUT Type_>
+uint32_t row_count(JaggedVectorRef<Type_> ref)
+{
+    return ( 0 < ref.offsets.count ) ? ref.offsets.count - 1 : 0;
+}
+
+template <TRIVIAL_LAYOUT Type_>
+uint32_t row_size(JaggedVectorRef<Type_> ref, const device uint8_t* base, uint32_t row)
+{
+    const device uint32_t* offsets = contents(ref.offsets, base);
+
+    return offsets[row + 1] - offsets[row];
+}
+
+template <TRIVIAL_LAYOUT Type_>
+const device Type_* row_contents(JaggedVectorRef<Type_> ref, const device uint8_t* base, uint32_t row)
+{
+    return contents(ref.values, base) + contents(ref.offsets, base)[row];
+}
+
+template <TRIVIAL_LAYOUT Type_>
+device Type_* row_contents(JaggedVectorRef<Type_> ref, device uint8_t* base, uint32_t row)
+{
+    return contents(ref.values, base) + contents(ref.offsets, static_cast<const device uint8_t*>(base))[row];
+}
+
+} // namespace data
@@ -0,0 +1,51 @@
+//
+//  JaggedVectorRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • JaggedVectorRef
+//
+//===------------------------------------------------------------------------===
+
+// • Rows in compressed sparse row form. The values of row r are
+//   values[offsets[r], offsets[r + 1]), so offsets has one more element than
+//   there are rows, or none if there are no rows
+//
+template <TRIVIAL_LAYOUT Type_>
+struct JaggedVectorRef
+{
+    VectorRef<uint32_t>     offsets;
+    VectorRef<Type_>        values;
+};
+
+static_assert( 16 ==  sizeof(JaggedVectorRef<int>), "Unexpected size" );
+static_assert(  4 == alignof(JaggedVectorRef<int>), "Unexpected alignment" );
+
+} // namespace data
@@ -0,0 +1,334 @@
+//
+//  Journal.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Journal.hpp>
+#include <Data/VectorRef.hpp>
+
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Checksum
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+constexpr uint32_t checksum(const uint8_t* bytes, uint32_t length) noexcept
+{
+    // • FNV-1a, only used to detect a torn final write
+    //
+    auto hash = uint32_t{ 0x811c9dc5 };
+
+    for ( auto byte = bytes; byte < bytes + length; ++byte )
+    {
+        hash = (hash ^ *byte) * 0x01000193;
+    }
+
+    return hash;
+}
+
+//===------------------------------------------------------------------------===
+// • Replay checks
+//===------------------------------------------------------------------------===
+
+// • The atom of a valid layout that begins at offset, if any
+//
+const Atom* atom_at(const Atom* data, uint32_t offset) noexcept
+{
+    for ( auto atom = data; ; atom = next(atom) )
+    {
+        const auto atom_offset = distance(data, atom);
+
+        if ( offset <= atom_offset || is_end(atom) ) {
+            return offset == atom_offset ? atom : nullptr;
+        }
+    }
+}
+
+// • The range is within the contents of one atom of a valid layout, so that
+//   writing it leaves every atom header intact
+//
+bool is_within_contents(const Atom* data, uint32_t offset, uint32_t length) noexcept
+{
+    for ( auto atom = data; !is_end(atom); atom = next(atom) )
+    {
+        const auto contents_begin = distance(data, atom) + atom_header_length;
+        const auto contents_end   = distance(data, atom) + atom->length;
+
+        if ( offset < contents_end ) {
+            return contents_begin <= offset && length <= contents_end - offset;
+        }
+    }
+
+    return false;
+}
+
+// • aligned_size without wrapping, for sizes read from the records
+//
+uint64_t aligned_length(uint32_t size) noexcept
+{
+    return ( uint64_t{ size } + 0x0f ) & ~uint64_t{ 0x0f };
+}
+
+// • Whether reserve_new would find a free atom of the length, rather than
+//   asserting that the contents are exhausted
+//
+bool has_free_atom(const Atom* data, uint64_t allocation_length) noexcept
+{
+    for ( auto atom = next(data); !is_end(atom); atom = next(atom) )
+    {
+        if ( AtomID::free == atom->identifier && allocation_length <= atom->length ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • Journal
+//
+//===------------------------------------------------------------------------===
+
+Journal::Journal(void) noexcept
+{
+}
+
+void Journal::append(JournalID identifier, uint32_t offset, uint32_t size, uint32_t result) noexcept(false)
+{
+    const auto record = JournalRecord {
+        .identifier = identifier,
+        .offset     = offset,
+        .size       = size,
+        .result     = result
+    };
+
+    auto bytes = reinterpret_cast<const uint8_t*>(&record);
+
+    m_records.insert( m_records.end(), bytes, bytes + sizeof(record) );
+}
+
+//===------------------------------------------------------------------------===
+// • MutationObserver
+//===------------------------------------------------------------------------===
+
+void Journal::did_reserve(uint32_t atom_offset, uint32_t requested_contents_size) noexcept(false)
+{
+    append( JournalID::reserve, atom_offset, requested_contents_size, 0 );
+}
+
+void Journal::did_resize(uint32_t curr_offset, uint32_t requested_contents_size, uint32_t atom_offset) noexcept(false)
+{
+    append( JournalID::resize, curr_offset, requested_contents_size, atom_offset );
+}
+
+void Journal::did_free(uint32_t atom_offset, uint32_t free_offset) noexcept(false)
+{
+    append( JournalID::free, atom_offset, 0, free_offset );
+}
+
+void Journal::did_write(uint32_t offset, const void* contents, uint32_t length) noexcept(false)
+{
+    auto bytes = static_cast<const uint8_t*>(contents);
+
+    append( JournalID::write, offset, length, detail::checksum(bytes, length) );
+
+    m_records.insert( m_records.end(), bytes, bytes + length );
+    m_records.resize( m_records.size() + aligned_size(length) - length, 0 );
+}
+
+void Journal::did_update(uint32_t ref_offset, uint32_t offset, uint32_t count) noexcept(false)
+{
+    append( JournalID::ref, ref_offset, offset, count );
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Recovery
+//
+//===------------------------------------------------------------------------===
+
+bool replay( void* contents, uint32_t contents_length,
+             const void* records, size_t records_length ) noexcept
+{
+    // • The records are replayed with the unchecked allocator primitives, which
+    //   rely on a valid layout, and then only ever write within atom contents
+    //
+    if ( !validate_layout(contents, contents_length) ) {
+        return false;
+    }
+
+    try
+    {
+        auto data  = data_atom(contents, contents_length);
+        auto begin = static_cast<const uint8_t*>(records);
+        auto end   = begin + records_length;
+
+        for ( auto curr = begin; curr < end; )
+        {
+            // • An incomplete final record is the tail of an interrupted append
+            //
+            if ( end - curr < static_cast<ptrdiff_t>(sizeof(JournalRecord)) ) {
+                break;
+            }
+
+            auto record = JournalRecord{ };
+
+            std::memcpy( &record, curr, sizeof(record) );
+
+            auto next = curr + sizeof(record);
+
+            switch ( record.identifier )
+            {
+                case JournalID::reserve:
+                {
+                    const auto allocation_length = atom_header_length + detail::aligned_length(record.size);
+
+                    if ( contents_length < allocation_length || !detail::has_free_atom(data, allocation_length) ) {
+                        return false;
+                    }
+
+                    auto alloc = detail::reserve(data, record.size, AtomID::vector);
+
+                    if ( detail::distance(data, alloc) != record.offset ) {
+                        return false;
+                    }
+                    break;
+                }
+
+                case JournalID::resize:
+                {
+                    if ( !is_aligned(record.offset) ) {
+                        return false;
+                    }
+
+                    auto curr_alloc = const_cast<Atom*>( detail::atom_at(data, record.offset) );
+
+                    if ( nullptr == curr_alloc || AtomID::vector != curr_alloc->identifier ) {
+                        return false;
+                    }
+
+                    const auto allocation_length = atom_header_length + detail::aligned_length(record.size);
+
+                    if (   contents_length < allocation_length
+                        || (   !detail::can_resize_in_place( curr_alloc, static_cast<uint32_t>(allocation_length) )
+                            && !detail::has_free_atom(data, allocation_length) ) )
+                    {
+                        return false;
+                    }
+
+                    auto alloc = detail::reserve(data, curr_alloc, record.size);
+
+                    if ( detail::distance(data, alloc) != record.result ) {
+                        return false;
+                    }
+                    break;
+                }
+
+                case JournalID::free:
+                {
+                    if ( !is_aligned(record.offset) ) {
+                        return false;
+                    }
+
+                    auto dealloc = const_cast<Atom*>( detail::atom_at(data, record.offset) );
+
+                    if ( nullptr == dealloc || AtomID::vector != dealloc->identifier ) {
+                        return false;
+                    }
+
+                    auto free = detail::free(dealloc);
+
+                    if ( detail::distance(data, free) != record.result ) {
+                        return false;
+                    }
+                    break;
+                }
+
+                case JournalID::write:
+                {
+                    const auto payload_length = detail::aligned_length(record.size);
+                    const auto available      = static_cast<uint64_t>(end - next);
+
+                    // • No write is longer than the contents, torn or not
+                    //
+                    if ( contents_length < record.size ) {
+                        return false;
+                    }
+
+                    // • Only the final record may be torn
+                    //
+                    if ( available < payload_length ) {
+                        return validate_layout(contents, contents_length);
+                    }
+
+                    if ( detail::checksum(next, record.size) != record.result ) {
+                        return available == payload_length && validate_layout(contents, contents_length);
+                    }
+
+                    if ( 0 < record.size && !detail::is_within_contents(data, record.offset, record.size) ) {
+                        return false;
+                    }
+
+                    std::memcpy( detail::offset_by<uint8_t>(data, record.offset), next, record.size );
+
+                    next += payload_length;
+                    break;
+                }
+
+                case JournalID::ref:
+                {
+                    if (   0 != record.offset % alignof(VectorRef<uint8_t>)
+                        || !detail::is_within_contents(data, record.offset, sizeof(VectorRef<uint8_t>)) )
+                    {
+                        return false;
+                    }
+
+                    const auto ref = VectorRef<uint8_t>{ record.size, record.result };
+
+                    std::memcpy( detail::offset_by<uint8_t>(data, record.offset), &ref, sizeof(ref) );
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+
+            curr = next;
+        }
+    }
+    catch ( ... )
+    {
+        return false;
+    }
+
+    return validate_layout(contents, contents_length);
+}
+
+} // namespace data
@@ -0,0 +1,170 @@
+//
+//  Journal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Allocation.hpp>
+#include <Data/MutationObserver.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • JournalID
+//===------------------------------------------------------------------------===
+
+enum class JournalID : uint32_t
+{
+    // • Each record is replayed in order onto the last checkpoint:
+    //
+    //  'rsrv'  offset: new atom,       size: requested contents size
+    //  'rsiz'  offset: current atom,   size: requested contents size,  result: new atom
+    //  'free'  offset: freed atom,                                     result: free atom
+    //  'writ'  offset: contents,       size: byte count,               result: checksum
+    //  'vref'  offset: VectorRef,      size: ref offset,               result: ref count
+    //
+    //  Only 'writ' is followed by a payload, padded to the alignment
+
+    reserve = 'rsrv',
+    resize  = 'rsiz',
+    free    = 'free',
+    write   = 'writ',
+    ref     = 'vref',
+};
+
+//===------------------------------------------------------------------------===
+//
+// • JournalRecord
+//
+//===------------------------------------------------------------------------===
+
+struct alignas(16) JournalRecord
+{
+    JournalID   identifier;
+    uint32_t    offset;     // Offset from the beginning of the 'data' atom
+    uint32_t    size;
+    uint32_t    result;
+};
+
+static_assert( 16 ==  sizeof(JournalRecord), "Unexpected size" );
+static_assert( 16 == alignof(JournalRecord), "Unexpected alignment" );
+
+static_assert( data::is_trivial_layout<JournalRecord>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • Journal
+//
+//===------------------------------------------------------------------------===
+
+// • Append-only log of the logical mutations made to a formatted buffer since
+//   its last checkpoint, kept as an observer of the Mutator of the buffer.
+//   The records are meant to be appended to durable storage and cleared, and
+//   replayed onto the checkpoint for recovery
+//
+class Journal : public MutationObserver
+{
+public:
+
+    // • Initialization
+    //
+    Journal(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    Journal(const Journal& ) = delete;
+    Journal(Journal&& ) = delete;
+
+    // • Assignment (deleted)
+    //
+    Journal& operator = (const Journal& ) = delete;
+    Journal& operator = (Journal&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    const uint8_t* records(void) const noexcept
+    {
+        return m_records.data();
+    }
+
+    size_t size(void) const noexcept
+    {
+        return m_records.size();
+    }
+
+    bool empty(void) const noexcept
+    {
+        return m_records.empty();
+    }
+
+    // • Methods : records
+    //
+    //      Called once the records have been appended to durable storage or
+    //      the buffer itself has been checkpointed
+    //
+    void clear(void) noexcept
+    {
+        m_records.clear();
+    }
+
+    // • MutationObserver
+    //
+    void did_reserve(uint32_t atom_offset, uint32_t requested_contents_size) noexcept(false) override;
+    void did_resize(uint32_t curr_offset, uint32_t requested_contents_size, uint32_t atom_offset) noexcept(false) override;
+    void did_free(uint32_t atom_offset, uint32_t free_offset) noexcept(false) override;
+
+    void did_write(uint32_t offset, const void* contents, uint32_t length) noexcept(false) override;
+    void did_update(uint32_t ref_offset, uint32_t offset, uint32_t count) noexcept(false) override;
+
+private:
+
+    // • Utilities (private)
+    //
+    void append(JournalID identifier, uint32_t offset, uint32_t size, uint32_t result) noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    std::vector<uint8_t> m_records;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Recovery
+//
+//===------------------------------------------------------------------------===
+
+// • Replays the journal records onto the last checkpoint of the buffer, stopping
+//   at an incomplete (torn) final record, then validates the resulting layout
+//
+bool replay( void* contents, uint32_t contents_length,
+             const void* records, size_t records_length ) noexcept;
+
+} // namespace data
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <type_traits>
 
 //===------------------------------------------------------------------------===
@@ -141,14 +144,14 @@ namespace detail
 {
 
 template <TrivialLayout Root_, TrivialLayout Type_>
-uint32_t distance(const Root_* root, const Type_* data)
+constexpr uint32_t distance(const Root_* root, const Type_* data)
 {
     return static_cast<uint32_t> (
                                   reinterpret_cast<const uint8_t*>(data) - reinterpret_cast<const uint8_t*>(root) );
 }
 
 template <TrivialLayout Root_, TrivialLayout Type_>
-uint32_t distance(const void* root, const Type_* data)
+constexpr uint32_t distance(const void* root, const Type_* data)
 {
     return static_cast<uint32_t> (
                                   reinterpret_cast<const uint8_t*>(data) - static_cast<const uint8_t*>(root) );
@@ -30,18 +30,26 @@ namespace data
 // • Concept names (Metal)
 //===------------------------------------------------------------------------===
 
+// • Emulation on the host keeps the TrivialLayout concept
+//
+#if !defined ( DATA_METAL_EMULATION )
 #define TRIVIAL_LAYOUT typename
+#endif
 
 //===------------------------------------------------------------------------===
 // • Memory Layout Utilities (Metal)
 //===------------------------------------------------------------------------===
 
+#if !defined ( DATA_METAL_EMULATION )
+
 template <TRIVIAL_LAYOUT Type_, TRIVIAL_LAYOUT Root_>
 constant Type_* offset_by(constant Root_* root, uint32_t offset)
 {
     return reinterpret_cast<constant Type_*>(reinterpret_cast<constant uint8_t*>(root) + offset);
 }
 
+#endif
+
 template <TRIVIAL_LAYOUT Type_, TRIVIAL_LAYOUT Root_>
 const device Type_* offset_by(const device Root_* root, uint32_t offset)
 {
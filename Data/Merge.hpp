@@ -0,0 +1,194 @@
+//
+//  Merge.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Allocation.hpp>
+#include <Data/Schema.hpp>
+#include <Data/ThreadPool.hpp>
+
+#include <cstring>
+#include <span>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Merging
+//
+//      Buffers built independently, for example one per worker thread, are
+//      merged by copying the atoms of each, from its first atom to its last
+//      'vctr' atom, into one region of the target:
+//
+//  [data] [vctr ...]  [    source 0    ] [    source 1    ] ...  [free] [end ]
+//
+//      Atoms within each source keep their relative offsets, so each root is
+//      rebased by one delta and only the links between sources are fixed.
+//      Only the VectorRef of the schema are rebased: offsets stored within
+//      contents, such as the chunks of a SegmentedVector, aren't
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+constexpr uint32_t merge_piece_length = 1 << 20;   // In bytes, of each parallel copy
+
+// • The atoms of a source to copy, up to the end of its last 'vctr' atom
+//
+struct MergeSpan
+{
+    const Atom* first;
+    uint32_t    length;
+    uint32_t    last_length;    // Of the last atom
+};
+
+inline MergeSpan merge_span(const Atom* data) noexcept
+{
+    auto span = MergeSpan{ .first = next(data), .length = 0, .last_length = 0 };
+
+    for ( auto atom = next(data); !is_end(atom); atom = next(atom) )
+    {
+        if ( AtomID::vector == atom->identifier )
+        {
+            span.length      = distance(span.first, atom) + atom->length;
+            span.last_length = atom->length;
+        }
+    }
+
+    return span;
+}
+
+} // namespace detail
+
+// • Copies the atoms of each source buffer to the target, in parallel, and
+//   returns the root of each with its references rebased onto the target,
+//   to be stored in the target as the caller sees fit. Throws if the target
+//   has no free region large enough
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+std::vector<Root_> merge_buffers( ThreadPool& pool, Atom* data,
+                                  std::span<const Atom* const> sources ) noexcept(false)
+{
+    assert( valid_data(data) );
+
+    auto spans   = std::vector<detail::MergeSpan>( sources.size() );
+    auto offsets = std::vector<uint32_t>( sources.size() );
+    auto total   = uint64_t{ 0 };
+
+    for ( auto index = size_t{ 0 }; index < sources.size(); ++index )
+    {
+        assert( valid_data(sources[index]) );
+
+        spans[index]   = detail::merge_span(sources[index]);
+        offsets[index] = static_cast<uint32_t>(total);
+        total         += spans[index].length;
+    }
+
+    auto roots = std::vector<Root_>( sources.size() );
+
+    for ( auto index = size_t{ 0 }; index < sources.size(); ++index ) {
+        roots[index] = *detail::contents<Root_>(sources[index]);
+    }
+
+    if ( 0 == total ) {
+        return roots;
+    }
+
+    if ( std::numeric_limits<uint32_t>::max() < total ) {
+        throw false;
+    }
+
+    // • One region for all of the atoms, whose header is overwritten
+    //
+    auto region = detail::reserve( data, static_cast<uint32_t>(total) - atom_header_length, AtomID::vector );
+
+    const auto region_offset   = detail::distance(data, region);
+    const auto region_previous = region->previous;
+    const auto after           = detail::next(region);
+
+    // • Parallel copies, in pieces so that large sources are shared
+    //
+    {
+        auto group = TaskGroup{ pool };
+        auto dest  = reinterpret_cast<uint8_t*>(region);
+
+        for ( auto index = size_t{ 0 }; index < sources.size(); ++index )
+        {
+            auto source = reinterpret_cast<const uint8_t*>(spans[index].first);
+
+            for ( auto piece = uint32_t{ 0 }; piece < spans[index].length; piece += detail::merge_piece_length )
+            {
+                const auto length = std::min( detail::merge_piece_length, spans[index].length - piece );
+
+                group.run( [to = dest + offsets[index] + piece, from = source + piece, length]() {
+                    std::memcpy( to, from, length );
+                });
+            }
+        }
+
+        group.wait();
+    }
+
+    // • Link the first atom of each source to the atom before it, and the atom
+    //   after the region to the last
+    //
+    auto previous = region_previous;
+
+    for ( auto index = size_t{ 0 }; index < sources.size(); ++index )
+    {
+        if ( 0 == spans[index].length ) {
+            continue;
+        }
+
+        detail::offset_by(data, region_offset + offsets[index])->previous = previous;
+
+        previous = spans[index].last_length;
+    }
+
+    after->previous = previous;
+
+    // • Rebase the references of each root by the delta of its source
+    //
+    for ( auto index = size_t{ 0 }; index < sources.size(); ++index )
+    {
+        const auto source_offset = sources[index]->length;
+        const auto target_offset = region_offset + offsets[index];
+
+        for ( const auto& field : vector_fields<Root_> )
+        {
+            auto& ref = vector_at(&roots[index], field);
+
+            if ( 0 != ref.offset ) {
+                ref.offset = ref.offset - source_offset + target_offset;
+            }
+        }
+    }
+
+    return roots;
+}
+
+} // namespace data
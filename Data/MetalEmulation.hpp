@@ -0,0 +1,190 @@
+//
+//  MetalEmulation.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#if defined ( __METAL_VERSION__ )
+#error "MetalEmulation.hpp is only for host builds"
+#endif
+
+#include <Data/Layout.hpp>
+#include <Data/ThreadPool.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+
+//===------------------------------------------------------------------------===
+//
+// • Metal emulation
+//
+//      Compiles the Metal utilities as plain C++, so that kernels reading
+//      formatted buffers can be tested and profiled on the host. Include it
+//      after every other header: device and constant become macros, device
+//      for nothing and constant for const, and the constant overloads of the
+//      utilities are left out as they are then the const device ones
+//
+//===------------------------------------------------------------------------===
+
+#define DATA_METAL_EMULATION 1
+
+#define device
+#define constant const
+
+//===------------------------------------------------------------------------===
+// • namespace metal (the builtins used by the Metal utilities)
+//===------------------------------------------------------------------------===
+
+namespace metal
+{
+
+template <std::unsigned_integral Type_>
+constexpr Type_ popcount(Type_ value) noexcept
+{
+    return static_cast<Type_>( std::popcount(value) );
+}
+
+template <std::unsigned_integral Type_>
+constexpr Type_ clz(Type_ value) noexcept
+{
+    return static_cast<Type_>( std::countl_zero(value) );
+}
+
+template <std::unsigned_integral Type_>
+constexpr Type_ ctz(Type_ value) noexcept
+{
+    return static_cast<Type_>( std::countr_zero(value) );
+}
+
+} // namespace metal
+
+// • As Metal sources do before including the utilities
+//
+using namespace metal;
+
+#include <Data/Layout-Metal.hpp>
+#include <Data/Vector-Metal.hpp>
+#include <Data/BitVector-Metal.hpp>
+#include <Data/FlatMap-Metal.hpp>
+#include <Data/JaggedVector-Metal.hpp>
+#include <Data/PackedIntVector-Metal.hpp>
+#include <Data/SegmentedVector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data::emulation
+//===------------------------------------------------------------------------===
+
+namespace data::emulation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Dispatch
+//
+//===------------------------------------------------------------------------===
+
+// • The attributes of a kernel thread, named after the Metal ones
+//
+struct ThreadPosition
+{
+    uint32_t    thread_position_in_grid;
+    uint32_t    thread_position_in_threadgroup;
+    uint32_t    threadgroup_position_in_grid;
+};
+
+namespace detail
+{
+
+constexpr uint32_t tasks_per_thread = 4;        // For stealing to balance the load
+
+template <class Kernel_>
+void run_threadgroup( Kernel_& kernel, uint32_t grid_size, uint32_t threadgroup_size,
+                      uint32_t threadgroup ) noexcept(false)
+{
+    const auto first = uint64_t{ threadgroup } * threadgroup_size;
+    const auto last  = std::min( first + threadgroup_size, uint64_t{ grid_size } );
+
+    for ( auto thread = first; thread < last; ++thread )
+    {
+        const auto position = ThreadPosition{
+            .thread_position_in_grid        = static_cast<uint32_t>(thread),
+            .thread_position_in_threadgroup = static_cast<uint32_t>(thread - first),
+            .threadgroup_position_in_grid   = threadgroup
+        };
+
+        if constexpr ( std::is_invocable_v<Kernel_&, const ThreadPosition&> ) {
+            kernel(position);
+        }
+        else {
+            kernel(position.thread_position_in_grid);
+        }
+    }
+}
+
+} // namespace detail
+
+// • Runs kernel for each of grid_size threads, as dispatchThreads does, with
+//   either the ThreadPosition or the thread_position_in_grid. The last
+//   threadgroup may be partial. The threads of a threadgroup run one after
+//   another on one pool thread, so kernels can't wait on threadgroup barriers.
+//   The first exception thrown by a kernel is rethrown
+//
+template <class Kernel_>
+void dispatch_threads( ThreadPool& pool, uint32_t grid_size, uint32_t threadgroup_size,
+                       Kernel_&& kernel ) noexcept(false)
+{
+    if ( 0 == threadgroup_size ) {
+        throw false;
+    }
+
+    const auto threadgroups = static_cast<uint32_t>( ( uint64_t{ grid_size } + threadgroup_size - 1 ) / threadgroup_size );
+    const auto tasks        = std::min( threadgroups, pool.size() * detail::tasks_per_thread );
+
+    const auto run_task = [&](uint32_t task)
+    {
+        const auto first = static_cast<uint32_t>( uint64_t{ threadgroups } * task / tasks );
+        const auto last  = static_cast<uint32_t>( uint64_t{ threadgroups } * (task + 1) / tasks );
+
+        for ( auto threadgroup = first; threadgroup < last; ++threadgroup ) {
+            detail::run_threadgroup( kernel, grid_size, threadgroup_size, threadgroup );
+        }
+    };
+
+    if ( tasks <= 1 )
+    {
+        if ( 1 == tasks ) {
+            run_task(0);
+        }
+
+        return;
+    }
+
+    auto group = TaskGroup{ pool };
+
+    for ( auto task = uint32_t{ 1 }; task < tasks; ++task ) {
+        group.run( [&, task]() { run_task(task); } );
+    }
+
+    run_task(0);
+
+    group.wait();
+}
+
+} // namespace data::emulation
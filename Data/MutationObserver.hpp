@@ -0,0 +1,74 @@
+//
+//  MutationObserver.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • MutationObserver
+//
+//===------------------------------------------------------------------------===
+
+// • Notified by a Mutator of each mutation of a formatted buffer, with offsets
+//   from the beginning of the 'data' atom. Each observer overrides what it
+//   needs: the Journal keeps the logical mutations, DirtyRanges the bytes.
+//   An observer that throws leaves the buffer mutated but itself incomplete
+//
+class MutationObserver
+{
+public:
+
+    virtual ~MutationObserver(void) noexcept = default;
+
+    // • Allocation
+    //
+    //      did_reserve(atom offset, requested contents size)
+    //      did_resize(current atom offset, requested contents size, new atom offset)
+    //      did_free(freed atom offset, free atom offset)
+    //
+    virtual void did_reserve(uint32_t, uint32_t) noexcept(false) { }
+    virtual void did_resize(uint32_t, uint32_t, uint32_t) noexcept(false) { }
+    virtual void did_free(uint32_t, uint32_t) noexcept(false) { }
+
+    // • Contents
+    //
+    //      did_write(contents offset, contents, length)
+    //      did_update(VectorRef offset, ref offset, ref count)
+    //
+    virtual void did_write(uint32_t, const void*, uint32_t) noexcept(false) { }
+    virtual void did_update(uint32_t, uint32_t, uint32_t) noexcept(false) { }
+
+    // • Bytes
+    //
+    //      did_modify(offset, length) for every byte range the mutations above
+    //      modified, including the atom headers and relocated contents
+    //
+    virtual void did_modify(uint32_t, uint32_t) noexcept(false) { }
+};
+
+} // namespace data
@@ -0,0 +1,166 @@
+//
+//  Mutator.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Mutator.hpp>
+
+#include <algorithm>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Mutator
+//
+//===------------------------------------------------------------------------===
+
+Mutator::Mutator( Atom* data, uint32_t contents_length,
+                  std::initializer_list<MutationObserver*> observers ) noexcept(false)
+    :
+        m_data           { data            },
+        m_contents_length{ contents_length },
+        m_observers      ( observers       )
+{
+    assert( valid_data(data) );
+}
+
+bool Mutator::contains(const void* contents, uint32_t length) const noexcept
+{
+    auto begin = reinterpret_cast<const uint8_t*>(m_data);
+    auto first = static_cast<const uint8_t*>(contents);
+
+    return begin <= first && first + length <= begin + m_contents_length;
+}
+
+void Mutator::did_modify(uint32_t offset, uint32_t length) noexcept(false)
+{
+    for ( auto observer : m_observers ) {
+        observer->did_modify(offset, length);
+    }
+}
+
+// • The allocator writes the headers of an atom, the one before it, which
+//   it may merge into, and the two after it, which it may divide or merge
+//
+void Mutator::did_modify_headers(const Atom* atom) noexcept(false)
+{
+    if ( m_observers.empty() )
+    {
+        // • No-op
+        return;
+    }
+
+    did_modify( detail::distance(m_data, detail::previous(atom)), atom_header_length );
+
+    for ( auto count = 0; count < 3; ++count )
+    {
+        did_modify( detail::distance(m_data, atom), atom_header_length );
+
+        if ( detail::is_end(atom) ) {
+            break;
+        }
+
+        atom = detail::next(atom);
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Allocation
+//===------------------------------------------------------------------------===
+
+Atom* Mutator::reserve(uint32_t requested_contents_size, AtomID identifier) noexcept(false)
+{
+    auto alloc = detail::reserve(m_data, requested_contents_size, identifier);
+
+    for ( auto observer : m_observers ) {
+        observer->did_reserve(detail::distance(m_data, alloc), requested_contents_size);
+    }
+
+    did_modify_headers(alloc);
+
+    return alloc;
+}
+
+Atom* Mutator::reserve(Atom* curr_alloc, uint32_t requested_contents_size) noexcept(false)
+{
+    const auto curr_offset = detail::distance(m_data, curr_alloc);
+    const auto curr_size   = detail::contents_size(curr_alloc);
+
+    // • Before a relocation frees the current atom and merges its neighbours
+    //
+    did_modify_headers(curr_alloc);
+
+    auto alloc = detail::reserve(m_data, curr_alloc, requested_contents_size);
+
+    for ( auto observer : m_observers ) {
+        observer->did_resize(curr_offset, requested_contents_size, detail::distance(m_data, alloc));
+    }
+
+    did_modify_headers(alloc);
+
+    if ( alloc != curr_alloc ) {
+        did_modify( detail::contents_offset(m_data, alloc), std::min( curr_size, detail::contents_size(alloc) ) );
+    }
+
+    return alloc;
+}
+
+Atom* Mutator::free(Atom* dealloc) noexcept(false)
+{
+    const auto dealloc_offset = detail::distance(m_data, dealloc);
+
+    did_modify_headers(dealloc);
+
+    auto free = detail::free(dealloc);
+
+    for ( auto observer : m_observers ) {
+        observer->did_free(dealloc_offset, detail::distance(m_data, free));
+    }
+
+    return free;
+}
+
+//===------------------------------------------------------------------------===
+// • Contents
+//===------------------------------------------------------------------------===
+
+void Mutator::write(const void* contents, uint32_t length) noexcept(false)
+{
+    assert( contains(contents, length) );
+
+    if ( 0 == length )
+    {
+        // • No-op
+        return;
+    }
+
+    const auto offset = detail::distance( m_data, static_cast<const uint8_t*>(contents) );
+
+    for ( auto observer : m_observers ) {
+        observer->did_write(offset, contents, length);
+    }
+
+    did_modify(offset, length);
+}
+
+} // namespace data
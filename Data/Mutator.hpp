@@ -0,0 +1,129 @@
+//
+//  Mutator.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Allocation.hpp>
+#include <Data/MutationObserver.hpp>
+#include <Data/VectorRef.hpp>
+
+#include <initializer_list>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Mutator
+//
+//===------------------------------------------------------------------------===
+
+// • Makes the allocations of the containers of a formatted buffer, and notifies
+//   its observers of those and of the writes the containers report, so that a
+//   Journal, DirtyRanges or both follow the mutations. Atoms are resized and
+//   freed immediately, unless a derived policy such as EpochMutator defers it
+//
+class Mutator
+{
+public:
+
+    // • Initialization
+    //
+    Mutator( Atom* data, uint32_t contents_length,
+             std::initializer_list<MutationObserver*> observers = { } ) noexcept(false);
+
+    virtual ~Mutator(void) noexcept = default;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    Mutator(const Mutator& ) = delete;
+    Mutator(Mutator&& ) = delete;
+    Mutator(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    Mutator& operator = (const Mutator& ) = delete;
+    Mutator& operator = (Mutator&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    Atom* data(void) noexcept
+    {
+        return m_data;
+    }
+
+    // • Methods : allocation
+    //
+    Atom* reserve(uint32_t requested_contents_size, AtomID identifier) noexcept(false);
+    virtual Atom* reserve(Atom* curr_alloc, uint32_t requested_contents_size) noexcept(false);
+
+    virtual Atom* free(Atom* dealloc) noexcept(false);
+
+    // • Methods : contents
+    //
+    //      Reports a write to a range of the buffer. Writes through Vector
+    //      element references are not observed and are reported here
+    //
+    void write(const void* contents, uint32_t length) noexcept(false);
+
+    template <TrivialLayout Type_>
+    void update(const VectorRef<Type_>& ref) noexcept(false)
+    {
+        // • Only refs stored within the buffer are part of its state
+        //
+        if ( contains(&ref, sizeof(ref)) )
+        {
+            const auto ref_offset = detail::distance(m_data, &ref);
+
+            for ( auto observer : m_observers ) {
+                observer->did_update(ref_offset, ref.offset, ref.count);
+            }
+
+            did_modify( ref_offset, sizeof(ref) );
+        }
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    bool contains(const void* contents, uint32_t length) const noexcept;
+
+    void did_modify(uint32_t offset, uint32_t length) noexcept(false);
+    void did_modify_headers(const Atom* atom) noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    Atom*                          m_data;
+    uint32_t                       m_contents_length;
+    std::vector<MutationObserver*> m_observers;
+};
+
+} // namespace data
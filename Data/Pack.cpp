@@ -0,0 +1,263 @@
+//
+//  Pack.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Pack.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Layout utilities
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+constexpr uint64_t index_length(uint32_t count) noexcept
+{
+    return ( sizeof(PackHeader) + sizeof(PackEntry)*uint64_t{count} + 0x0f ) & ~uint64_t{0x0f};
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • Writing
+//
+//===------------------------------------------------------------------------===
+
+void write_pack(const char* path, std::span<const PackSource> sources) noexcept(false)
+{
+    if ( std::numeric_limits<uint32_t>::max() < sources.size() ) {
+        throw false;
+    }
+
+    // • Index, sorted by key
+    //
+    auto order = std::vector<uint32_t>( sources.size() );
+
+    for ( auto index = uint32_t{ 0 }; index < order.size(); ++index ) {
+        order[index] = index;
+    }
+
+    std::sort( order.begin(), order.end(), [&](auto lhs, auto rhs) {
+        return sources[lhs].key < sources[rhs].key;
+    });
+
+    const auto count = static_cast<uint32_t>( sources.size() );
+    auto offset      = detail::index_length(count);
+    auto entries     = std::vector<PackEntry>( count );
+
+    for ( auto index = uint32_t{ 0 }; index < count; ++index )
+    {
+        const auto& source = sources[order[index]];
+
+        if ( 0 < index && source.key == entries[index - 1].key ) {
+            throw false;
+        }
+
+        if ( !validate_layout(source.contents, source.contents_length) ) {
+            throw false;
+        }
+
+        entries[index] = {
+            .key      = source.key,
+            .offset   = offset,
+            .length   = source.contents_length,
+            .reserved = 0
+        };
+
+        offset += source.contents_length;
+    }
+
+    const auto header = PackHeader {
+        .identifier = PackID::pack,
+        .count      = count,
+        .length     = offset
+    };
+
+    // • Header, index and padding, then each buffer in key order
+    //
+    auto file = std::ofstream{ path, std::ios::binary | std::ios::trunc };
+
+    const auto padding = std::array<char, alignment>{ };
+    const auto entries_length = sizeof(PackEntry) * entries.size();
+
+    file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+    file.write( reinterpret_cast<const char*>(entries.data()), entries_length );
+    file.write( padding.data(), detail::index_length(count) - sizeof(header) - entries_length );
+
+    for ( auto index : order )
+    {
+        file.write( static_cast<const char*>(sources[index].contents), sources[index].contents_length );
+    }
+
+    if ( !file.flush() ) {
+        throw false;
+    }
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Pack
+//
+//===------------------------------------------------------------------------===
+
+Pack::Pack(const char* path) noexcept(false)
+    :
+        m_contents{ nullptr },
+        m_length  { 0       },
+        m_mapped  { false   }
+{
+    auto file = ::open(path, O_RDONLY);
+
+    if ( file < 0 ) {
+        throw false;
+    }
+
+    struct stat status;
+
+    if ( 0 != ::fstat(file, &status) || status.st_size < static_cast<off_t>(sizeof(PackHeader)) )
+    {
+        ::close(file);
+        throw false;
+    }
+
+    auto mapping = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+
+    ::close(file);
+
+    if ( MAP_FAILED == mapping ) {
+        throw false;
+    }
+
+    // • Buffers are accessed individually, so don't read ahead of them
+    //
+    ::madvise(mapping, status.st_size, MADV_RANDOM);
+
+    m_contents = static_cast<const uint8_t*>(mapping);
+    m_length   = static_cast<uint64_t>(status.st_size);
+    m_mapped   = true;
+
+    try
+    {
+        validate_index();
+    }
+    catch ( ... )
+    {
+        ::munmap(mapping, m_length);
+        throw;
+    }
+}
+
+Pack::Pack(const void* contents, uint64_t length) noexcept(false)
+    :
+        m_contents{ static_cast<const uint8_t*>(contents) },
+        m_length  { length },
+        m_mapped  { false  }
+{
+    if ( !is_aligned(contents) || length < sizeof(PackHeader) ) {
+        throw false;
+    }
+
+    validate_index();
+}
+
+Pack::~Pack(void) noexcept
+{
+    if ( m_mapped )
+    {
+        ::munmap(const_cast<uint8_t*>(m_contents), m_length);
+    }
+}
+
+void Pack::validate_index(void) const noexcept(false)
+{
+    const auto header = this->header();
+
+    if (   PackID::pack != header->identifier
+        || header->length != m_length
+        || m_length < detail::index_length(header->count) )
+    {
+        throw false;
+    }
+
+    auto offset = detail::index_length(header->count);
+    auto prev   = static_cast<const PackEntry*>(nullptr);
+
+    for ( const auto& entry : entries() )
+    {
+        if (   entry.offset != offset
+            || !is_aligned(entry.length)
+            || entry.length < min_contents_length
+            || m_length - offset < entry.length
+            || ( nullptr != prev && entry.key <= prev->key ) )
+        {
+            throw false;
+        }
+
+        offset += entry.length;
+        prev    = &entry;
+    }
+}
+
+const PackEntry* Pack::find(uint64_t key) const noexcept
+{
+    const auto entries = this->entries();
+
+    auto entry = std::lower_bound( entries.begin(), entries.end(), key, [](const auto& entry, auto key) {
+        return entry.key < key;
+    });
+
+    return ( entry != entries.end() && key == entry->key ) ? &*entry : nullptr;
+}
+
+const Atom* Pack::data_atom(uint64_t key) const noexcept(false)
+{
+    auto entry = find(key);
+
+    if ( nullptr == entry ) {
+        throw false;
+    }
+
+    return data::data_atom( contents(*entry), entry->length );
+}
+
+bool Pack::validate_layout(uint64_t key) const noexcept
+{
+    auto entry = find(key);
+
+    return nullptr != entry && data::validate_layout( contents(*entry), entry->length );
+}
+
+} // namespace data
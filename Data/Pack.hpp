@@ -0,0 +1,176 @@
+//
+//  Pack.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Atom.hpp>
+
+#include <span>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • PackID
+//===------------------------------------------------------------------------===
+
+enum class PackID : uint32_t
+{
+    // • Valid layout:
+    //
+    //  [16]            'pack' header
+    //  [24 * count]    index, sorted by key
+    //  [padding]       to the alignment
+    // ([length]        formatted buffer)*
+
+    pack = 'pack',
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Pack layout
+//
+//===------------------------------------------------------------------------===
+
+struct alignas(16) PackHeader
+{
+    PackID      identifier;
+    uint32_t    count;
+    uint64_t    length;     // Total length of the pack
+};
+
+struct PackEntry
+{
+    uint64_t    key;
+    uint64_t    offset;     // Offset from the beginning of the pack
+    uint32_t    length;     // Contents length of the formatted buffer
+    uint32_t    reserved;
+};
+
+static_assert( 16 ==  sizeof(PackHeader), "Unexpected size" );
+static_assert( 16 == alignof(PackHeader), "Unexpected alignment" );
+static_assert( 24 ==  sizeof(PackEntry), "Unexpected size" );
+
+static_assert( data::is_trivial_layout<PackHeader>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<PackEntry>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • Writing
+//
+//===------------------------------------------------------------------------===
+
+struct PackSource
+{
+    uint64_t    key;
+    const void* contents;
+    uint32_t    contents_length;
+};
+
+// • Writes each formatted buffer once, validating its layout, with keys unique
+//
+void write_pack(const char* path, std::span<const PackSource> sources) noexcept(false);
+
+//===------------------------------------------------------------------------===
+//
+// • Pack
+//
+//===------------------------------------------------------------------------===
+
+// • Read-only view of a pack mapped into memory. Only the header and index are
+//   validated on open; each buffer is paged in when it is first accessed
+//
+class Pack
+{
+public:
+
+    // • Initialization
+    //
+    explicit Pack(const char* path) noexcept(false);
+    Pack(const void* contents, uint64_t length) noexcept(false);
+
+    ~Pack(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    Pack(const Pack& ) = delete;
+    Pack(Pack&& ) = delete;
+    Pack(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    Pack& operator = (const Pack& ) = delete;
+    Pack& operator = (Pack&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint32_t size(void) const noexcept
+    {
+        return header()->count;
+    }
+
+    std::span<const PackEntry> entries(void) const noexcept
+    {
+        return { reinterpret_cast<const PackEntry*>(header() + 1), size() };
+    }
+
+    const PackEntry* find(uint64_t key) const noexcept;
+
+    const uint8_t* contents(const PackEntry& entry) const noexcept
+    {
+        return m_contents + entry.offset;
+    }
+
+    // • Methods
+    //
+    //      The 'data' atom of a buffer in place, without touching the rest of it
+    //
+    const Atom* data_atom(uint64_t key) const noexcept(false);
+
+    bool validate_layout(uint64_t key) const noexcept;
+
+private:
+
+    // • Utilities (private)
+    //
+    const PackHeader* header(void) const noexcept
+    {
+        return reinterpret_cast<const PackHeader*>(m_contents);
+    }
+
+    void validate_index(void) const noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    const uint8_t*  m_contents;
+    uint64_t        m_length;
+    bool            m_mapped;
+};
+
+} // namespace data
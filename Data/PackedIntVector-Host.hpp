@@ -0,0 +1,209 @@
+//
+//  PackedIntVector-Host.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/PackedIntVectorRef.hpp>
+#include <Data/Vector-Host.hpp>
+
+#include <array>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<PackedBlock>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<PackedIntVectorRef>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+// • Block kernels
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+using packed_values = std::array<uint32_t, packed_block_length>;
+
+// • Chooses the encoding and width of count values, 1 to 128, and packs them
+//   into width * 4 words, returning the block with a zero offset
+//
+PackedBlock pack_block(const uint32_t* values, uint32_t count, uint32_t* words) noexcept;
+
+// • Unpacks all 128 values of a block, 4 lanes at a time
+//
+void unpack_block(const PackedBlock& block, const uint32_t* words, uint32_t* values) noexcept;
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVector
+//
+//===------------------------------------------------------------------------===
+
+// • Vector of uint32_t compressed in blocks of 128 values, each with frame of
+//   reference or delta coding and bit packing. Values are appended, read one
+//   at a time through the block headers, or decoded a block at a time
+//
+class PackedIntVector
+{
+public:
+
+    // • Types
+    //
+    using value_type = uint32_t;
+    using size_type  = uint32_t;
+
+    static constexpr size_type block_length = detail::packed_block_length;
+
+public:
+
+    // • Initialization
+    //
+    PackedIntVector(PackedIntVectorRef& ref, Atom* data) noexcept(false);
+
+private:
+
+    // • Initialization (deleted)
+    //
+    PackedIntVector(const PackedIntVector& ) = delete;
+    PackedIntVector(PackedIntVector&& ) = delete;
+    PackedIntVector(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    PackedIntVector& operator = (const PackedIntVector& ) = delete;
+    PackedIntVector& operator = (PackedIntVector&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_ref.count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_ref.count;
+    }
+
+    size_type block_count(void) const noexcept
+    {
+        return m_blocks.size();
+    }
+
+    //      Bytes of block headers and packed words, against 4 per value
+    //
+    size_type packed_length(void) const noexcept
+    {
+        return m_blocks.size() * sizeof(PackedBlock) + m_words.size() * sizeof(uint32_t);
+    }
+
+    std::span<const PackedBlock> blocks(void) const noexcept
+    {
+        return { m_blocks.data(), m_blocks.size() };
+    }
+
+    // • Accessors : values
+    //
+    value_type operator [] (size_type index) const noexcept
+    {
+        assert( index < size() );
+
+        return detail::packed_value( m_blocks[index / block_length], m_words.data(), index % block_length );
+    }
+
+    //      All 128 values of a block, with the last one's padding
+    //
+    void decode_block(size_type block, std::span<value_type, block_length> values) const noexcept
+    {
+        assert( block < block_count() );
+
+        detail::unpack_block( m_blocks[block], m_words.data(), values.data() );
+    }
+
+    //      The first values.size() values
+    //
+    void decode(std::span<value_type> values) const noexcept;
+
+    //      Calls fn(values, first_index) for each block in order, with the
+    //      block decoded into a buffer on the stack
+    //
+    template <class Function_>
+        requires std::is_invocable_v<Function_, std::span<const value_type>, size_type>
+    void for_each_block(Function_&& fn) const
+    {
+        auto values = detail::packed_values{ };
+
+        for ( auto block = size_type{ 0 }; block < block_count(); ++block )
+        {
+            const auto first = block * block_length;
+
+            detail::unpack_block( m_blocks[block], m_words.data(), values.data() );
+
+            fn( std::span<const value_type>{ values.data(), std::min(block_length, size() - first) }, first );
+        }
+    }
+
+    // • Methods
+    //
+    //      A partial last block is decoded and packed again with the first of
+    //      the new values
+    //
+    void append(std::span<const value_type> values) noexcept(false);
+
+    void assign(std::span<const value_type> values) noexcept(false)
+    {
+        clear();
+        append(values);
+    }
+
+    void clear(void) noexcept(false)
+    {
+        m_blocks.clear();
+        m_words.clear();
+
+        m_ref.count = 0;
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    void append_block(const value_type* values, size_type count) noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    PackedIntVectorRef&     m_ref;
+    Vector<PackedBlock>     m_blocks;
+    Vector<uint32_t>        m_words;
+};
+
+} // namespace data
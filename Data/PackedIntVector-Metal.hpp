@@ -0,0 +1,56 @@
+//
+//  PackedIntVector-Metal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/PackedIntVectorRef.hpp>
+#include <Data/Vector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVector utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+inline uint32_t packed_value(PackedIntVectorRef ref, const device uint8_t* base, uint32_t index)
+{
+    const PackedBlock block = contents(ref.blocks, base)[index / detail::packed_block_length];
+
+    return detail::packed_value( block, contents(ref.words, base), index % detail::packed_block_length );
+}
+
+#if !defined ( DATA_METAL_EMULATION )
+
+inline uint32_t packed_value(PackedIntVectorRef ref, constant uint8_t* base, uint32_t index)
+{
+    const PackedBlock block = contents(ref.blocks, base)[index / detail::packed_block_length];
+
+    return detail::packed_value( block, contents(ref.words, base), index % detail::packed_block_length );
+}
+
+#endif
+
+} // namespace data
@@ -0,0 +1,330 @@
+//
+//  PackedIntVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/PackedIntVector.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Packing
+//
+//===------------------------------------------------------------------------===
+
+PackedBlock pack_block(const uint32_t* values, uint32_t count, uint32_t* words) noexcept
+{
+    assert( 0 < count && count <= packed_block_length );
+
+    auto padded = packed_values{ };
+
+    std::copy_n( values, count, padded.begin() );
+    std::fill( padded.begin() + count, padded.end(), values[count - 1] );
+
+    // • Frame of reference, or delta when the values never decrease across a
+    //   lane and the deltas need fewer bits
+    //
+    const auto [min, max] = std::minmax_element( padded.begin(), padded.end() );
+
+    auto block = PackedBlock {
+        .reference = *min,
+        .offset    = 0,
+        .width     = static_cast<uint32_t>( std::bit_width(*max - *min) ),
+        .encoding  = PackedEncoding::frame
+    };
+
+    auto fields    = packed_values{ };
+    auto max_delta = uint32_t{ 0 };
+    auto is_delta  = true;
+
+    for ( auto index = uint32_t{ 0 }; is_delta && index < packed_block_length; ++index )
+    {
+        const auto prev = ( index < packed_lanes ) ? padded[0] : padded[index - packed_lanes];
+
+        is_delta      = prev <= padded[index];
+        fields[index] = padded[index] - prev;
+        max_delta     = std::max(max_delta, fields[index]);
+    }
+
+    if ( is_delta && std::bit_width(max_delta) < block.width )
+    {
+        block.reference = padded[0];
+        block.width     = static_cast<uint32_t>( std::bit_width(max_delta) );
+        block.encoding  = PackedEncoding::delta;
+    }
+    else
+    {
+        for ( auto index = uint32_t{ 0 }; index < packed_block_length; ++index ) {
+            fields[index] = padded[index] - block.reference;
+        }
+    }
+
+    // • Each lane's fields are packed low bits first across its words
+    //
+    std::fill_n( words, packed_lanes * block.width, 0 );
+
+    for ( auto index = uint32_t{ 0 }; 0 < block.width && index < packed_block_length; ++index )
+    {
+        const auto bit   = ( index / packed_lanes ) * block.width;
+        const auto word  = ( bit / 32 ) * packed_lanes + index % packed_lanes;
+        const auto shift = bit % 32;
+
+        words[word] |= fields[index] << shift;
+
+        if ( 32 < shift + block.width ) {
+            words[word + packed_lanes] |= fields[index] >> ( 32 - shift );
+        }
+    }
+
+    return block;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Unpacking
+//
+//      Each lane holds every 4th value, so a 4 x 32-bit vector unpacks one
+//      value of each lane at a time. The kernels are specialized for every
+//      width, so the shifts and masks are constants once the loop is unrolled
+//
+//===------------------------------------------------------------------------===
+
+typedef uint32_t lanes_type __attribute__(( vector_size(packed_lanes * sizeof(uint32_t)) ));
+
+[[gnu::always_inline]] inline lanes_type load_lanes(const uint32_t* words) noexcept
+{
+    lanes_type result;
+
+    std::memcpy( &result, words, sizeof(result) );
+
+    return result;
+}
+
+[[gnu::always_inline]] inline void store_lanes(uint32_t* values, lanes_type source) noexcept
+{
+    std::memcpy( values, &source, sizeof(source) );
+}
+
+template <uint32_t Width_, PackedEncoding Encoding_>
+void unpack_block(const uint32_t* words, uint32_t reference, uint32_t* values) noexcept
+{
+    constexpr auto mask = ( 32 == Width_ ) ? ~uint32_t{ 0 } : ( uint32_t{ 1 } << Width_ ) - 1;
+
+    auto sums = lanes_type{ } + reference;
+
+#pragma GCC unroll 32
+    for ( auto position = uint32_t{ 0 }; position < packed_block_length / packed_lanes; ++position )
+    {
+        auto fields = lanes_type{ };
+
+        if constexpr ( 0 < Width_ )
+        {
+            const auto bit   = position * Width_;
+            const auto shift = bit % 32;
+            const auto first = words + ( bit / 32 ) * packed_lanes;
+
+            fields = load_lanes(first) >> shift;
+
+            if ( 32 < shift + Width_ ) {
+                fields |= load_lanes(first + packed_lanes) << ( 32 - shift );
+            }
+
+            fields &= mask;
+        }
+
+        if constexpr ( PackedEncoding::frame == Encoding_ )
+        {
+            store_lanes( values + position * packed_lanes, fields + reference );
+        }
+        else
+        {
+            sums += fields;
+
+            store_lanes( values + position * packed_lanes, sums );
+        }
+    }
+}
+
+using UnpackKernel = void (*)(const uint32_t* words, uint32_t reference, uint32_t* values) noexcept;
+
+template <PackedEncoding Encoding_, uint32_t... Widths_>
+constexpr std::array<UnpackKernel, sizeof...(Widths_)> unpack_kernels(std::integer_sequence<uint32_t, Widths_...> ) noexcept
+{
+    return { &unpack_block<Widths_, Encoding_>... };
+}
+
+void unpack_block(const PackedBlock& block, const uint32_t* words, uint32_t* values) noexcept
+{
+    static constexpr auto widths = std::make_integer_sequence<uint32_t, 33>{ };
+
+    static constexpr auto frame_kernels = unpack_kernels<PackedEncoding::frame>(widths);
+    static constexpr auto delta_kernels = unpack_kernels<PackedEncoding::delta>(widths);
+
+    assert( block.width <= 32 );
+
+    const auto& kernels = ( PackedEncoding::frame == block.encoding ) ? frame_kernels : delta_kernels;
+
+    kernels[block.width]( words + block.offset, block.reference, values );
+}
+
+//===------------------------------------------------------------------------===
+// • Reservation
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Type_>
+void reserve_for_append(Vector<Type_>& vector, uint32_t count) noexcept(false)
+{
+    if ( vector.available() < count ) {
+        vector.reserve( std::max(vector.size() + count, vector.size() + vector.size() / 2) );
+    }
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVector
+//
+//===------------------------------------------------------------------------===
+
+PackedIntVector::PackedIntVector(PackedIntVectorRef& ref, Atom* data) noexcept(false)
+    :
+        m_ref   { ref },
+        m_blocks{ ref.blocks, data },
+        m_words { ref.words,  data }
+{
+    if ( m_blocks.size() != ( m_ref.count + block_length - 1 ) / block_length ) {
+        throw false;
+    }
+
+    // • Blocks are packed one after another
+    //
+    auto offset = uint32_t{ 0 };
+
+    for ( const auto& block : m_blocks )
+    {
+        if (   offset != block.offset
+            || 32 < block.width
+            || ( PackedEncoding::frame != block.encoding && PackedEncoding::delta != block.encoding ) )
+        {
+            throw false;
+        }
+
+        offset += detail::packed_lanes * block.width;
+    }
+
+    if ( offset != m_words.size() ) {
+        throw false;
+    }
+}
+
+void PackedIntVector::decode(std::span<value_type> values) const noexcept
+{
+    assert( values.size() <= size() );
+
+    auto block_values = detail::packed_values{ };
+
+    for ( auto first = size_t{ 0 }; first < values.size(); first += block_length )
+    {
+        const auto& block = m_blocks[static_cast<size_type>(first / block_length)];
+
+        if ( first + block_length <= values.size() )
+        {
+            detail::unpack_block( block, m_words.data(), values.data() + first );
+        }
+        else
+        {
+            detail::unpack_block( block, m_words.data(), block_values.data() );
+
+            std::copy_n( block_values.begin(), values.size() - first, values.begin() + first );
+        }
+    }
+}
+
+void PackedIntVector::append(std::span<const value_type> values) noexcept(false)
+{
+    if ( std::numeric_limits<size_type>::max() - size() < values.size() ) {
+        throw false;
+    }
+
+    const auto block_count = static_cast<size_type>( ( size() + values.size() + block_length - 1 ) / block_length );
+
+    detail::reserve_for_append( m_blocks, block_count - m_blocks.size() );
+
+    // • The partial last block is replaced, with room reserved for it first so
+    //   that its values can't be lost
+    //
+    if ( const auto partial_count = size() % block_length; 0 < partial_count && !values.empty() )
+    {
+        auto head = detail::packed_values{ };
+
+        decode_block( m_blocks.size() - 1, head );
+
+        const auto fill_count = static_cast<size_type>( std::min<size_t>(block_length - partial_count, values.size()) );
+
+        std::copy_n( values.begin(), fill_count, head.begin() + partial_count );
+
+        values = values.subspan(fill_count);
+
+        detail::reserve_for_append( m_words, detail::packed_lanes * 32 );
+
+        m_words.resize_for_overwrite( m_blocks.back().offset );
+        m_blocks.pop_back();
+
+        m_ref.count -= partial_count;
+
+        append_block( head.data(), partial_count + fill_count );
+    }
+
+    for ( ; !values.empty(); values = values.subspan( std::min<size_t>(block_length, values.size()) ) )
+    {
+        append_block( values.data(), static_cast<size_type>( std::min<size_t>(block_length, values.size()) ) );
+    }
+}
+
+void PackedIntVector::append_block(const value_type* values, size_type count) noexcept(false)
+{
+    auto words = detail::packed_values{ };
+    auto block = detail::pack_block(values, count, words.data());
+
+    const auto word_count = detail::packed_lanes * block.width;
+
+    block.offset = m_words.size();
+
+    detail::reserve_for_append( m_words, word_count );
+    detail::reserve_for_append( m_blocks, 1 );
+
+    std::copy_n( words.begin(), word_count, m_words.append_uninitialized(word_count).begin() );
+
+    m_blocks.append_uninitialized(1)[0] = block;
+    m_ref.count += count;
+}
+
+} // namespace data
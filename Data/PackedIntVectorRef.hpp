@@ -0,0 +1,136 @@
+//
+//  PackedIntVectorRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • PackedEncoding
+//===------------------------------------------------------------------------===
+
+enum class PackedEncoding : uint32_t
+{
+    // • Each value less the reference, the minimum of the block
+    //
+    frame,
+
+    // • Each value less the one 4 before it, or the reference, the first value
+    //   of the block, for the first 4. Only used for blocks where the values
+    //   never decrease across 4
+    //
+    delta,
+};
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVectorRef
+//
+//===------------------------------------------------------------------------===
+
+// • Values in blocks of 128, each with a header in the blocks atom and its
+//   values packed in width * 4 words of the words atom. Value i of a block is
+//   in lane i % 4, at bit (i / 4) * width of that lane, and word w of lane l is
+//   words[4 * w + l], so that the 4 lanes unpack together. The last block is
+//   padded with its last value
+//
+struct PackedBlock
+{
+    uint32_t        reference;
+    uint32_t        offset;     // Offset in words of the packed values
+    uint32_t        width;      // Bits per packed value, 0 to 32
+    PackedEncoding  encoding;
+};
+
+struct PackedIntVectorRef
+{
+    uint32_t                count;
+    VectorRef<PackedBlock>  blocks;
+    VectorRef<uint32_t>     words;
+};
+
+static_assert( 16 ==  sizeof(PackedBlock), "Unexpected size" );
+static_assert( 20 ==  sizeof(PackedIntVectorRef), "Unexpected size" );
+static_assert(  4 == alignof(PackedIntVectorRef), "Unexpected alignment" );
+
+//===------------------------------------------------------------------------===
+// • Random access (Host and Metal)
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+enum : uint32_t
+{
+    packed_block_length = 128,
+    packed_lanes        = 4,
+};
+
+// • Packed field of value index of a block
+//
+template <typename Pointer_>
+uint32_t unpack_value(Pointer_ words, uint32_t width, uint32_t index)
+{
+    if ( 0 == width ) {
+        return 0;
+    }
+
+    const uint32_t bit   = ( index / packed_lanes ) * width;
+    const uint32_t word  = ( bit / 32 ) * packed_lanes + index % packed_lanes;
+    const uint32_t shift = bit % 32;
+
+    uint32_t value = words[word] >> shift;
+
+    if ( 32 < shift + width ) {
+        value |= words[word + packed_lanes] << ( 32 - shift );
+    }
+
+    return ( 32 == width ) ? value : value & ( ( uint32_t(1) << width ) - 1 );
+}
+
+// • Value index of a block. A delta block sums the fields of one lane
+//
+template <typename Pointer_>
+uint32_t packed_value(PackedBlock block, Pointer_ words, uint32_t index)
+{
+    words += block.offset;
+
+    if ( PackedEncoding::frame == block.encoding ) {
+        return block.reference + unpack_value(words, block.width, index);
+    }
+
+    uint32_t value = block.reference;
+
+    for ( uint32_t lane_index = index % packed_lanes; lane_index <= index; lane_index += packed_lanes ) {
+        value += unpack_value(words, block.width, lane_index);
+    }
+
+    return value;
+}
+
+} // namespace detail
+
+} // namespace data
@@ -0,0 +1,371 @@
+//
+//  Parallel.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Algorithm.hpp>
+#include <Data/ThreadPool.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • TrivialRange concept (Vector, std::span, contents_of(ref, data), ...)
+//===------------------------------------------------------------------------===
+
+template <class Range_>
+concept TrivialRange = std::ranges::contiguous_range<Range_>
+                    && std::ranges::sized_range<Range_>
+                    && TrivialLayout<std::ranges::range_value_t<Range_>>;
+
+namespace parallel
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Chunks
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+constexpr size_t cache_line_length = 64;
+constexpr size_t min_chunk_length  = 16384;     // In bytes
+constexpr size_t chunks_per_thread = 4;         // For stealing to balance the load
+
+// • Index of the first element, at or after index, that begins a cache line,
+//   or index itself if no element does
+//
+template <TrivialLayout Type_>
+size_t aligned_index(const Type_* values, size_t index) noexcept
+{
+    constexpr auto line = cache_line_length / std::gcd( cache_line_length, sizeof(Type_) );
+
+    const auto address = reinterpret_cast<uintptr_t>(values + index);
+
+    for ( auto offset = size_t{ 0 }; offset < line; ++offset )
+    {
+        if ( 0 == (address + offset*sizeof(Type_)) % cache_line_length ) {
+            return index + offset;
+        }
+    }
+
+    return index;
+}
+
+// • Chunks of whole cache lines, so that no two chunks write to the same line.
+//   The first chunk also takes the elements before the first line
+//
+struct Partition
+{
+    size_t  count;
+    size_t  first_length;
+    size_t  chunk_length;
+    size_t  chunks;
+
+    size_t begin(size_t chunk) const noexcept
+    {
+        return ( 0 == chunk ) ? 0 : std::min( count, first_length + (chunk - 1)*chunk_length );
+    }
+
+    size_t end(size_t chunk) const noexcept
+    {
+        return begin(chunk + 1);
+    }
+};
+
+template <TrivialLayout Type_>
+Partition partition(const Type_* values, size_t count, uint32_t thread_count) noexcept
+{
+    constexpr auto line = cache_line_length / std::gcd( cache_line_length, sizeof(Type_) );
+
+    const auto target       = std::max( min_chunk_length / sizeof(Type_) + 1, count / (thread_count*chunks_per_thread) );
+    const auto chunk_length = ( target + line - 1 ) / line * line;
+    const auto first_length = aligned_index(values, 0) + chunk_length;
+
+    return {
+        .count        = count,
+        .first_length = first_length,
+        .chunk_length = chunk_length,
+        .chunks       = ( count <= first_length ) ? 1 : 1 + ( count - first_length + chunk_length - 1 ) / chunk_length
+    };
+}
+
+// • Calls function(begin, end, chunk) for each chunk, the first on the calling
+//   thread and the others on the pool
+//
+template <class Function_>
+void run_chunks(ThreadPool& pool, const Partition& partition, Function_&& function) noexcept(false)
+{
+    if ( 1 == partition.chunks )
+    {
+        function( size_t{ 0 }, partition.count, size_t{ 0 } );
+        return;
+    }
+
+    auto group = TaskGroup{ pool };
+
+    for ( auto chunk = size_t{ 1 }; chunk < partition.chunks; ++chunk )
+    {
+        group.run( [&, chunk]() { function( partition.begin(chunk), partition.end(chunk), chunk ); } );
+    }
+
+    function( size_t{ 0 }, partition.end(0), size_t{ 0 } );
+
+    group.wait();
+}
+
+template <TrivialRange Range_>
+Partition partition_of(ThreadPool& pool, Range_&& values) noexcept
+{
+    return partition( std::ranges::data(values), std::ranges::size(values), pool.size() );
+}
+
+// • Split of the merge of lhs and rhs at output index: the count of elements
+//   taken from lhs, with ties taken from lhs first as std::merge does
+//
+template <TrivialLayout Type_, class Compare_>
+size_t merge_split( const Type_* lhs, size_t lhs_count, const Type_* rhs, size_t rhs_count,
+                    size_t index, Compare_& compare ) noexcept
+{
+    auto low  = ( rhs_count < index ) ? index - rhs_count : 0;
+    auto high = std::min( index, lhs_count );
+
+    while ( low < high )
+    {
+        const auto middle = low + (high - low) / 2;
+
+        if ( !compare( rhs[index - middle - 1], lhs[middle] ) ) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • Algorithms
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialRange Range_, class Function_>
+void for_each(ThreadPool& pool, Range_&& values, Function_ function) noexcept(false)
+{
+    const auto first = std::ranges::data(values);
+
+    detail::run_chunks( pool, detail::partition_of(pool, values), [&](size_t begin, size_t end, size_t ) {
+        for ( auto index = begin; index < end; ++index ) {
+            function( first[index] );
+        }
+    });
+}
+
+// • The destination must have room for all of source, and may be source itself
+//
+template <TrivialRange Source_, TrivialRange Dest_, class Function_>
+void transform(ThreadPool& pool, const Source_& source, Dest_&& dest, Function_ function) noexcept(false)
+{
+    assert( std::ranges::size(source) <= std::ranges::size(dest) );
+
+    const auto source_first = std::ranges::data(source);
+    const auto dest_first   = std::ranges::data(dest);
+
+    const auto partition = detail::partition( dest_first, std::ranges::size(source), pool.size() );
+
+    detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t ) {
+        for ( auto index = begin; index < end; ++index ) {
+            dest_first[index] = function( source_first[index] );
+        }
+    });
+}
+
+// • The operation must be associative. Chunks are combined in order, so it
+//   need not be commutative
+//
+template <TrivialRange Range_, class Type_, class BinaryOp_ = std::plus<>>
+Type_ reduce(ThreadPool& pool, const Range_& values, Type_ init, BinaryOp_ op = { }) noexcept(false)
+{
+    const auto first     = std::ranges::data(values);
+    const auto partition = detail::partition_of(pool, values);
+
+    if ( 0 == partition.count ) {
+        return init;
+    }
+
+    auto totals = std::vector<Type_>( partition.chunks, init );
+
+    detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t chunk) {
+        totals[chunk] = std::accumulate( first + begin + 1, first + end, static_cast<Type_>(first[begin]), op );
+    });
+
+    for ( const auto& total : totals ) {
+        init = op( init, total );
+    }
+
+    return init;
+}
+
+// • The operation must be associative. The destination must have room for all
+//   of source, and may be source itself
+//
+template <TrivialRange Source_, TrivialRange Dest_, class BinaryOp_ = std::plus<>>
+void inclusive_scan(ThreadPool& pool, const Source_& source, Dest_&& dest, BinaryOp_ op = { }) noexcept(false)
+{
+    using value_type = std::ranges::range_value_t<Dest_>;
+
+    assert( std::ranges::size(source) <= std::ranges::size(dest) );
+
+    const auto source_first = std::ranges::data(source);
+    const auto dest_first   = std::ranges::data(dest);
+
+    const auto partition = detail::partition( dest_first, std::ranges::size(source), pool.size() );
+
+    if ( 1 == partition.chunks )
+    {
+        std::inclusive_scan( source_first, source_first + partition.count, dest_first, op );
+        return;
+    }
+
+    // • Total of each chunk, then the scan of each chunk from the totals before it
+    //
+    auto carries = std::vector<value_type>( partition.chunks );
+
+    detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t chunk) {
+        carries[chunk] = std::accumulate( source_first + begin + 1, source_first + end,
+                                          static_cast<value_type>(source_first[begin]), op );
+    });
+
+    for ( auto chunk = size_t{ 1 }; chunk < partition.chunks; ++chunk ) {
+        carries[chunk] = op( carries[chunk - 1], carries[chunk] );
+    }
+
+    detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t chunk) {
+        if ( 0 == chunk ) {
+            std::inclusive_scan( source_first + begin, source_first + end, dest_first + begin, op );
+        }
+        else {
+            std::inclusive_scan( source_first + begin, source_first + end, dest_first + begin, op, carries[chunk - 1] );
+        }
+    });
+}
+
+// • Sorts each chunk, then merges pairs of runs until one remains, splitting
+//   each merge across the pool. The sort is not stable
+//
+template <TrivialRange Range_, class Compare_ = std::less<>>
+void sort(ThreadPool& pool, Range_&& values, Compare_ compare = { }) noexcept(false)
+{
+    using value_type = std::ranges::range_value_t<Range_>;
+
+    const auto first     = std::ranges::data(values);
+    const auto partition = detail::partition_of(pool, values);
+
+    detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t ) {
+        std::sort( first + begin, first + end, compare );
+    });
+
+    if ( 1 == partition.chunks ) {
+        return;
+    }
+
+    auto runs = std::vector<size_t>( partition.chunks + 1 );
+
+    for ( auto chunk = size_t{ 0 }; chunk <= partition.chunks; ++chunk ) {
+        runs[chunk] = partition.begin(chunk);
+    }
+
+    auto buffer = std::make_unique_for_overwrite<value_type[]>( partition.count );
+    auto source = first;
+    auto dest   = buffer.get();
+
+    while ( 2 < runs.size() )
+    {
+        auto group = TaskGroup{ pool };
+        auto next  = std::vector<size_t>{ };
+
+        for ( auto run = size_t{ 0 }; run + 1 < runs.size(); run += 2 )
+        {
+            const auto begin  = runs[run];
+            const auto middle = runs[run + 1];
+            const auto end    = ( run + 2 < runs.size() ) ? runs[run + 2] : middle;
+
+            next.push_back(begin);
+
+            // • Pieces of the merged run, each starting on a cache line
+            //
+            for ( auto piece = begin; piece < end; )
+            {
+                const auto piece_end = std::min( end, detail::aligned_index(dest, piece + partition.chunk_length) );
+
+                group.run( [=, &compare]()
+                {
+                    const auto lhs_count = middle - begin;
+                    const auto rhs_count = end - middle;
+
+                    const auto lhs_begin = detail::merge_split( source + begin, lhs_count, source + middle, rhs_count,
+                                                                piece - begin, compare );
+                    const auto lhs_end   = detail::merge_split( source + begin, lhs_count, source + middle, rhs_count,
+                                                                piece_end - begin, compare );
+
+                    std::merge( source + begin  + lhs_begin, source + begin  + lhs_end,
+                                source + middle + (piece - begin - lhs_begin),
+                                source + middle + (piece_end - begin - lhs_end),
+                                dest + piece, compare );
+                });
+
+                piece = piece_end;
+            }
+        }
+
+        next.push_back( partition.count );
+
+        group.wait();
+
+        runs = std::move(next);
+        std::swap(source, dest);
+    }
+
+    if ( source != first )
+    {
+        detail::run_chunks( pool, partition, [&](size_t begin, size_t end, size_t ) {
+            std::copy( source + begin, source + end, first + begin );
+        });
+    }
+}
+
+} // namespace parallel
+
+} // namespace data
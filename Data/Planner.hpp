@@ -0,0 +1,118 @@
+//
+//  Planner.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Allocation.hpp>
+#include <Data/Schema.hpp>
+
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Planning
+//
+//      The exact buffer length for a root with a schema and the final count of
+//      each of its VectorRef, in the order of vector_fields<Root>, laid out as:
+//
+//  [16 + root]             'data' atom
+// ([16 + contents]         'vctr' atom of each non-empty vector)*
+//  [16]                    'end ' atom
+//
+//      with every length aligned. References that aren't VectorRef, such as
+//      those of a HashTable, and the chunks of a SegmentedVector, aren't
+//      part of the plan
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+using VectorCounts = std::array<uint32_t, vector_fields<Root_>.size()>;
+
+// • Usable in constant expressions, where overflow is a compile error
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+constexpr uint32_t plan_length(const VectorCounts<Root_>& counts) noexcept(false)
+{
+    auto length = uint64_t{ atom_header_length + aligned_size<Root_>() + atom_header_length };
+
+    for ( auto index = size_t{ 0 }; index < counts.size(); ++index )
+    {
+        const auto contents_size = uint64_t{ counts[index] } * vector_fields<Root_>[index].element_size;
+
+        if ( 0 < contents_size ) {
+            length += atom_header_length + ( ( contents_size + alignment - 1 ) & ~uint64_t{ alignment - 1 } );
+        }
+    }
+
+    if ( std::numeric_limits<uint32_t>::max() < length ) {
+        throw false;
+    }
+
+    return static_cast<uint32_t>(length);
+}
+
+// • Formats a buffer of plan_length(counts) with every vector reserved in
+//   order, one after another, with no free atom left. The vectors have their
+//   final counts and zeroed contents, ready to be written in place
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+std::pair<Atom*, Root_*>
+format_planned(void* buffer, uint32_t buffer_length, const VectorCounts<Root_>& counts) noexcept(false)
+{
+    if ( plan_length<Root_>(counts) != buffer_length ) {
+        throw false;
+    }
+
+    auto [data, root] = format_for_data<Root_>(buffer, buffer_length);
+
+    for ( auto index = size_t{ 0 }; index < counts.size(); ++index )
+    {
+        const auto& field        = vector_fields<Root_>[index];
+        const auto contents_size = counts[index] * field.element_size;
+
+        assert( field.alignment <= alignment );
+
+        if ( 0 == contents_size ) {
+            continue;
+        }
+
+        auto vctr = detail::reserve( data, contents_size, AtomID::vector );
+
+        std::memset( detail::contents<uint8_t>(vctr), 0, detail::contents_size(vctr) );
+
+        vector_at(root, field) = {
+            .offset = detail::contents_offset(data, vctr),
+            .count  = counts[index]
+        };
+    }
+
+    return { data, root };
+}
+
+} // namespace data
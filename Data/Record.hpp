@@ -0,0 +1,133 @@
+//
+//  Record.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+
+#include <tuple>
+#include <utility>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Record fields
+//
+//      The fields of an aggregate record are counted from the number of
+//      initializers it accepts, and accessed with structured bindings. Members
+//      that are C arrays would be counted per element, so aren't supported
+//
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+struct AnyField
+{
+    template <class Type_>
+    constexpr operator Type_ (void) const noexcept;
+};
+
+template <class Record_, class... Fields_>
+consteval uint32_t count_fields(void) noexcept
+{
+    if constexpr ( requires { Record_{ Fields_{ }..., AnyField{ } }; } ) {
+        return count_fields<Record_, Fields_..., AnyField>();
+    }
+    else {
+        return sizeof...(Fields_);
+    }
+}
+
+} // namespace detail
+
+template <class Record_>
+    requires std::is_aggregate_v<Record_>
+constexpr uint32_t field_count = detail::count_fields<Record_>();
+
+// • Tuple of references to the fields of a record, of up to 12 fields
+//
+template <class Record_>
+    requires std::is_aggregate_v<std::remove_const_t<Record_>>
+constexpr auto tie_fields(Record_& record) noexcept
+{
+    constexpr auto count = field_count<std::remove_const_t<Record_>>;
+
+    static_assert( 0 < count && count <= 12, "Unsupported field count" );
+
+    if constexpr ( 1 == count ) {
+        auto& [f0] = record;
+        return std::tie(f0);
+    }
+    else if constexpr ( 2 == count ) {
+        auto& [f0, f1] = record;
+        return std::tie(f0, f1);
+    }
+    else if constexpr ( 3 == count ) {
+        auto& [f0, f1, f2] = record;
+        return std::tie(f0, f1, f2);
+    }
+    else if constexpr ( 4 == count ) {
+        auto& [f0, f1, f2, f3] = record;
+        return std::tie(f0, f1, f2, f3);
+    }
+    else if constexpr ( 5 == count ) {
+        auto& [f0, f1, f2, f3, f4] = record;
+        return std::tie(f0, f1, f2, f3, f4);
+    }
+    else if constexpr ( 6 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5);
+    }
+    else if constexpr ( 7 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5, f6] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6);
+    }
+    else if constexpr ( 8 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+    }
+    else if constexpr ( 9 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+    }
+    else if constexpr ( 10 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+    }
+    else if constexpr ( 11 == count ) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+    }
+    else {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = record;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+    }
+}
+
+template <class Record_, uint32_t Index_>
+using field_type = std::remove_reference_t<std::tuple_element_t<Index_, decltype( tie_fields(std::declval<Record_&>()) )>>;
+
+} // namespace data
@@ -0,0 +1,407 @@
+//
+//  RingBuffer.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/RingBufferRef.hpp>
+#include <Data/Vector-Host.hpp>
+
+#include <algorithm>
+#include <bit>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<RingHeader>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<RingBufferRef<int>>(), "Unexpected layout" );
+static_assert( __atomic_always_lock_free(sizeof(uint32_t), 0), "Unexpected atomics" );
+
+//===------------------------------------------------------------------------===
+// • Ring utilities
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+// • The indices are plain words in the buffer, which may be shared between
+//   processes, so they are accessed with the atomic builtins rather than
+//   through std::atomic
+//
+inline uint32_t load_acquire(const uint32_t& index) noexcept
+{
+    return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+}
+
+inline void store_release(uint32_t& index, uint32_t value) noexcept
+{
+    __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+}
+
+template <TrivialLayout Type_>
+constexpr uint32_t ring_length(uint32_t capacity) noexcept
+{
+    return static_cast<uint32_t>( sizeof(RingHeader) + sizeof(Type_) * capacity );
+}
+
+template <TrivialLayout Type_>
+struct RingContents
+{
+    RingHeader*     header;
+    Type_*          elements;
+    uint32_t        capacity;
+
+    uint32_t position(uint32_t index) const noexcept
+    {
+        return index & ( capacity - 1 );
+    }
+};
+
+template <TrivialLayout Type_>
+RingContents<Type_> ring_contents(const RingBufferRef<Type_>& ref, Atom* data) noexcept(false)
+{
+    if ( !std::has_single_bit(ref.capacity) ) {
+        throw false;
+    }
+
+    auto vctr   = allocation_header( VectorRef<uint8_t>{ ref.offset, ring_length<Type_>(ref.capacity) }, data );
+    auto header = contents<RingHeader>(vctr);
+
+    if ( ref.capacity < load_acquire(header->write) - load_acquire(header->read) ) {
+        throw false;
+    }
+
+    return {
+        .header   = header,
+        .elements = reinterpret_cast<Type_*>(header + 1),
+        .capacity = ref.capacity
+    };
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • Ring buffer
+//
+//===------------------------------------------------------------------------===
+
+// • Reserves the 'vctr' atom of an empty ring of capacity elements, a power of
+//   two. The atom never moves afterwards, so a producer and a consumer can each
+//   open the ring while the other is using it
+//
+template <TrivialLayout Type_>
+void format_ring(RingBufferRef<Type_>& ref, Atom* data, uint32_t capacity) noexcept(false)
+{
+    static_assert( alignof(Type_) <= alignment, "Unexpected alignment" );
+
+    if (   0 != ref.capacity
+        || !std::has_single_bit(capacity)
+        || ( std::numeric_limits<uint32_t>::max() - sizeof(RingHeader) ) / sizeof(Type_) < capacity )
+    {
+        throw false;
+    }
+
+    auto vctr = detail::reserve( data, detail::ring_length<Type_>(capacity), AtomID::vector );
+
+    *detail::contents<RingHeader>(vctr) = RingHeader{ };
+
+    ref.offset   = detail::contents_offset(data, vctr);
+    ref.capacity = capacity;
+}
+
+//===------------------------------------------------------------------------===
+// • RingProducer
+//===------------------------------------------------------------------------===
+
+// • The writing side of a ring. There must be only one at a time, and it must
+//   only be used from one thread
+//
+template <TrivialLayout Type_>
+class RingProducer
+{
+public:
+
+    // • Types
+    //
+    using ring_ref   = RingBufferRef<Type_>;
+    using value_type = Type_;
+    using size_type  = uint32_t;
+
+public:
+
+    // • Initialization
+    //
+    RingProducer(const ring_ref& ref, Atom* data) noexcept(false)
+        :
+            m_ring      { detail::ring_contents(ref, data) },
+            m_write     { detail::load_acquire(m_ring.header->write) },
+            m_read_cache{ detail::load_acquire(m_ring.header->read)  }
+    {
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    RingProducer(const RingProducer& ) = delete;
+    RingProducer(RingProducer&& ) = delete;
+    RingProducer(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    RingProducer& operator = (const RingProducer& ) = delete;
+    RingProducer& operator = (RingProducer&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    size_type capacity(void) const noexcept
+    {
+        return m_ring.capacity;
+    }
+
+    //      Number of elements that can be written
+    //
+    size_type available(void) noexcept
+    {
+        return writable( m_ring.capacity );
+    }
+
+    // • Methods : in place
+    //
+    //      Up to count free elements, contiguous in the ring, for the caller to
+    //      write before commit. It is shorter than count when the free space
+    //      wraps or is too small, and empty when the ring is full
+    //
+    std::span<value_type> prepare(size_type count) noexcept
+    {
+        const auto position = m_ring.position(m_write);
+        const auto length   = std::min({ count, writable(count), m_ring.capacity - position });
+
+        return { m_ring.elements + position, length };
+    }
+
+    //      Publishes count prepared elements to the consumer
+    //
+    void commit(size_type count) noexcept
+    {
+        assert( count <= m_ring.capacity - ( m_write - m_read_cache ) );
+
+        m_write += count;
+
+        detail::store_release(m_ring.header->write, m_write);
+    }
+
+    // • Methods : copying
+    //
+    //      Writes as many of values as there is room for, returning the number
+    //      written, and publishes them together
+    //
+    size_type push(std::span<const value_type> values) noexcept
+    {
+        const auto wanted = static_cast<size_type>( std::min<size_t>(values.size(), m_ring.capacity) );
+        const auto count  = std::min( wanted, writable(wanted) );
+
+        const auto position = m_ring.position(m_write);
+        const auto first    = std::min(count, m_ring.capacity - position);
+
+        std::copy_n( values.begin(), first, m_ring.elements + position );
+        std::copy_n( values.begin() + first, count - first, m_ring.elements );
+
+        commit(count);
+
+        return count;
+    }
+
+    bool try_push(const value_type& value) noexcept
+    {
+        return 1 == push( std::span{ &value, 1 } );
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    //      The consumer's index is only reloaded when the cached one doesn't
+    //      leave room for count, so a producer that keeps ahead rarely touches
+    //      the consumer's cache line
+    //
+    size_type writable(size_type count) noexcept
+    {
+        if ( m_ring.capacity - ( m_write - m_read_cache ) < count ) {
+            m_read_cache = detail::load_acquire(m_ring.header->read);
+        }
+
+        return m_ring.capacity - ( m_write - m_read_cache );
+    }
+
+private:
+
+    // • Data members
+    //
+    detail::RingContents<value_type>    m_ring;
+    uint32_t                            m_write;
+    uint32_t                            m_read_cache;
+};
+
+//===------------------------------------------------------------------------===
+// • RingConsumer
+//===------------------------------------------------------------------------===
+
+// • The reading side of a ring. There must be only one at a time, and it must
+//   only be used from one thread
+//
+template <TrivialLayout Type_>
+class RingConsumer
+{
+public:
+
+    // • Types
+    //
+    using ring_ref   = RingBufferRef<Type_>;
+    using value_type = Type_;
+    using size_type  = uint32_t;
+
+public:
+
+    // • Initialization
+    //
+    RingConsumer(const ring_ref& ref, Atom* data) noexcept(false)
+        :
+            m_ring       { detail::ring_contents(ref, data) },
+            m_read       { detail::load_acquire(m_ring.header->read)  },
+            m_write_cache{ detail::load_acquire(m_ring.header->write) }
+    {
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    RingConsumer(const RingConsumer& ) = delete;
+    RingConsumer(RingConsumer&& ) = delete;
+    RingConsumer(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    RingConsumer& operator = (const RingConsumer& ) = delete;
+    RingConsumer& operator = (RingConsumer&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    size_type capacity(void) const noexcept
+    {
+        return m_ring.capacity;
+    }
+
+    //      Number of elements that can be read
+    //
+    size_type available(void) noexcept
+    {
+        return readable( m_ring.capacity );
+    }
+
+    // • Methods : in place
+    //
+    //      Up to count written elements, contiguous in the ring, to be read in
+    //      place before release. It is shorter than count when the elements
+    //      wrap or fewer are written, and empty when the ring is empty
+    //
+    std::span<const value_type> peek(size_type count) noexcept
+    {
+        const auto position = m_ring.position(m_read);
+        const auto length   = std::min({ count, readable(count), m_ring.capacity - position });
+
+        return { m_ring.elements + position, length };
+    }
+
+    //      Returns count read elements to the producer
+    //
+    void release(size_type count) noexcept
+    {
+        assert( count <= m_write_cache - m_read );
+
+        m_read += count;
+
+        detail::store_release(m_ring.header->read, m_read);
+    }
+
+    // • Methods : copying
+    //
+    //      Reads as many elements as are written and fit in values, returning
+    //      the number read
+    //
+    size_type pop(std::span<value_type> values) noexcept
+    {
+        const auto wanted = static_cast<size_type>( std::min<size_t>(values.size(), m_ring.capacity) );
+        const auto count  = std::min( wanted, readable(wanted) );
+
+        const auto position = m_ring.position(m_read);
+        const auto first    = std::min(count, m_ring.capacity - position);
+
+        std::copy_n( m_ring.elements + position, first, values.begin() );
+        std::copy_n( m_ring.elements, count - first, values.begin() + first );
+
+        release(count);
+
+        return count;
+    }
+
+    bool try_pop(value_type& value) noexcept
+    {
+        return 1 == pop( std::span{ &value, 1 } );
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    //      The producer's index is only reloaded when the cached one doesn't
+    //      cover count
+    //
+    size_type readable(size_type count) noexcept
+    {
+        if ( m_write_cache - m_read < count ) {
+            m_write_cache = detail::load_acquire(m_ring.header->write);
+        }
+
+        return m_write_cache - m_read;
+    }
+
+private:
+
+    // • Data members
+    //
+    detail::RingContents<value_type>    m_ring;
+    uint32_t                            m_read;
+    uint32_t                            m_write_cache;
+};
+
+} // namespace data
@@ -0,0 +1,65 @@
+//
+//  RingBufferRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • RingBufferRef
+//
+//===------------------------------------------------------------------------===
+
+// • Contents of the 'vctr' atom:
+//
+//  [128]                   RingHeader
+//  [capacity * size]       elements
+//
+//   The indices count every element written and read, wrapping at 2^32, so the
+//   element at index i is at i & (capacity - 1). Each is written by one side
+//   only, and they are a cache line apart so that the sides don't contend
+//
+struct RingHeader
+{
+    uint32_t    write;          // Written by the producer
+    uint32_t    reserved0[15];
+    uint32_t    read;           // Written by the consumer
+    uint32_t    reserved1[15];
+};
+
+template <TRIVIAL_LAYOUT Type_>
+struct RingBufferRef
+{
+    uint32_t offset;    // Offset from the beginning of the Resource atom
+    uint32_t capacity;  // Zero or a power of two
+};
+
+static_assert( 128 ==  sizeof(RingHeader), "Unexpected size" );
+static_assert(   8 ==  sizeof(RingBufferRef<int>), "Unexpected size" );
+static_assert(   4 == alignof(RingBufferRef<int>), "Unexpected alignment" );
+
+} // namespace data
@@ -0,0 +1,401 @@
+//
+//  Schema.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/BitVectorRef.hpp>
+#include <Data/FlatMapRef.hpp>
+#include <Data/JaggedVectorRef.hpp>
+#include <Data/PackedIntVectorRef.hpp>
+#include <Data/SegmentedVectorRef.hpp>
+#include <Data/StringPoolRef.hpp>
+#include <Data/VectorView.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Schema
+//
+//      Schema<Type> lists the fields of a struct that hold references, so that
+//      the VectorRef of a root can be found at compile time. A specialization
+//      is declared with DATA_SCHEMA, at global scope:
+//
+//          struct SceneData
+//          {
+//              VectorRef<float>        positions;
+//              JaggedVectorRef<uint32_t> faces;
+//              Mesh                    meshes[4];  // Also with a schema
+//              uint32_t                flags;      // Not listed
+//          };
+//
+//          DATA_SCHEMA( SceneData, positions, faces, meshes );
+//
+//      Listed fields may be a VectorRef, a type with a schema, or an array of
+//      either. Fields that are not listed are only part of the layout hash
+//      through the size and alignment of the struct
+//
+//===------------------------------------------------------------------------===
+
+template <class Type_>
+struct Schema;
+
+template <class Type_>
+concept HasSchema = requires { typename Schema<Type_>::type; };
+
+// • A VectorRef in a root, at offset from the beginning of the root
+//
+struct VectorField
+{
+    uint32_t    offset;
+    uint32_t    element_size;
+    uint32_t    alignment;
+};
+
+// • Visited by the schema of a reference whose elements aren't reached through
+//   a listed VectorRef, so that their type is still part of the layout hash.
+//   It is not a field, and has no offset
+//
+template <class Type_>
+struct HashedElement { };
+
+//===------------------------------------------------------------------------===
+// • Macros
+//===------------------------------------------------------------------------===
+
+#define DATA_SCHEMA_EXPAND(x_) x_
+#define DATA_SCHEMA_CONCAT_(lhs_, rhs_) lhs_ ## rhs_
+#define DATA_SCHEMA_CONCAT(lhs_, rhs_) DATA_SCHEMA_CONCAT_(lhs_, rhs_)
+
+#define DATA_SCHEMA_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, count_, ...) count_
+#define DATA_SCHEMA_COUNT(...) DATA_SCHEMA_EXPAND(DATA_SCHEMA_COUNT_(__VA_ARGS__, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+
+#define DATA_SCHEMA_FOR_EACH_1(macro_, field_) macro_(field_)
+#define DATA_SCHEMA_FOR_EACH_2(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_1(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_3(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_2(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_4(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_3(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_5(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_4(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_6(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_5(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_7(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_6(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_8(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_7(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_9(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_8(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_10(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_9(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_11(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_10(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_12(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_11(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_13(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_12(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_14(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_13(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_15(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_14(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_16(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_15(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_17(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_16(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_18(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_17(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_19(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_18(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_20(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_19(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_21(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_20(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_22(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_21(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_23(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_22(macro_, __VA_ARGS__))
+#define DATA_SCHEMA_FOR_EACH_24(macro_, field_, ...) macro_(field_) DATA_SCHEMA_EXPAND(DATA_SCHEMA_FOR_EACH_23(macro_, __VA_ARGS__))
+
+#define DATA_SCHEMA_FOR_EACH(macro_, ...) \
+    DATA_SCHEMA_EXPAND(DATA_SCHEMA_CONCAT(DATA_SCHEMA_FOR_EACH_, DATA_SCHEMA_COUNT(__VA_ARGS__))(macro_, __VA_ARGS__))
+
+#define DATA_SCHEMA_VISIT(field_) \
+    visitor( std::type_identity<decltype(type::field_)>{ }, static_cast<uint32_t>( offsetof(type, field_) ) );
+
+// • Body of a Schema specialization for the struct named type
+//
+#define DATA_SCHEMA_FIELDS(...)                                                 \
+    template <class Visitor_>                                                   \
+    static constexpr void visit(Visitor_&& visitor)                             \
+    {                                                                           \
+        DATA_SCHEMA_FOR_EACH(DATA_SCHEMA_VISIT, __VA_ARGS__)                    \
+    }
+
+#define DATA_SCHEMA(Type_, ...)                                                 \
+    template <>                                                                 \
+    struct data::Schema<Type_>                                                  \
+    {                                                                           \
+        using type = Type_;                                                     \
+                                                                                \
+        DATA_SCHEMA_FIELDS(__VA_ARGS__)                                         \
+    }
+
+//===------------------------------------------------------------------------===
+// • Schemas of the library references
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Key_>
+struct Schema<FlatSetRef<Key_>>
+{
+    using type = FlatSetRef<Key_>;
+
+    DATA_SCHEMA_FIELDS(keys)
+};
+
+template <TrivialLayout Key_, TrivialLayout Value_>
+struct Schema<FlatMapRef<Key_, Value_>>
+{
+    using type = FlatMapRef<Key_, Value_>;
+
+    DATA_SCHEMA_FIELDS(keys, values)
+};
+
+template <TrivialLayout Type_>
+struct Schema<JaggedVectorRef<Type_>>
+{
+    using type = JaggedVectorRef<Type_>;
+
+    DATA_SCHEMA_FIELDS(offsets, values)
+};
+
+// • Only the chunk directory; the chunks are found through it, so the element
+//   type is hashed on its own
+//
+template <TrivialLayout Type_>
+struct Schema<SegmentedVectorRef<Type_>>
+{
+    using type = SegmentedVectorRef<Type_>;
+
+    template <class Visitor_>
+    static constexpr void visit(Visitor_&& visitor)
+    {
+        DATA_SCHEMA_VISIT(chunks)
+
+        visitor( std::type_identity<HashedElement<Type_>>{ }, uint32_t{ 0 } );
+    }
+};
+
+template <>
+struct Schema<BitVectorRef>
+{
+    using type = BitVectorRef;
+
+    DATA_SCHEMA_FIELDS(words, ranks)
+};
+
+template <>
+struct Schema<PackedIntVectorRef>
+{
+    using type = PackedIntVectorRef;
+
+    DATA_SCHEMA_FIELDS(blocks, words)
+};
+
+template <>
+struct Schema<StringPoolRef>
+{
+    using type = StringPoolRef;
+
+    DATA_SCHEMA_FIELDS(bytes, ends, index)
+};
+
+//===------------------------------------------------------------------------===
+// • Reflection
+//===------------------------------------------------------------------------===
+
+namespace detail
+{
+
+template <class Type_>
+struct is_vector_ref : std::false_type { };
+
+template <class Type_>
+struct is_vector_ref<VectorRef<Type_>> : std::true_type
+{
+    using element_type = Type_;
+};
+
+template <class Type_>
+struct is_hashed_element : std::false_type { };
+
+template <class Type_>
+struct is_hashed_element<HashedElement<Type_>> : std::true_type
+{
+    using element_type = Type_;
+};
+
+// • Calls fn(VectorField) for each VectorRef of Type_ at offset, depth first
+//   in the order of the schema, and element_fn(size, alignment) for each
+//   HashedElement
+//
+template <class Type_, class Function_, class ElementFunction_>
+constexpr void visit_vectors(Function_& fn, ElementFunction_& element_fn, uint32_t offset)
+{
+    if constexpr ( is_vector_ref<Type_>::value )
+    {
+        using element_type = typename is_vector_ref<Type_>::element_type;
+
+        fn( VectorField{ offset, sizeof(element_type), alignof(element_type) } );
+    }
+    else if constexpr ( is_hashed_element<Type_>::value )
+    {
+        using element_type = typename is_hashed_element<Type_>::element_type;
+
+        element_fn( static_cast<uint32_t>(sizeof(element_type)), static_cast<uint32_t>(alignof(element_type)) );
+    }
+    else if constexpr ( std::is_array_v<Type_> )
+    {
+        using element_type = std::remove_extent_t<Type_>;
+
+        for ( auto index = uint32_t{ 0 }; index < std::extent_v<Type_>; ++index ) {
+            visit_vectors<element_type>( fn, element_fn, offset + index * static_cast<uint32_t>(sizeof(element_type)) );
+        }
+    }
+    else
+    {
+        static_assert( HasSchema<Type_>, "Fields listed in a schema need a schema of their own" );
+
+        Schema<Type_>::visit( [&fn, &element_fn, offset](auto field, uint32_t field_offset) {
+            visit_vectors<typename decltype(field)::type>( fn, element_fn, offset + field_offset );
+        });
+    }
+}
+
+template <class Type_, class Function_>
+constexpr void visit_vectors(Function_& fn, uint32_t offset)
+{
+    auto skip = [](uint32_t, uint32_t) { };
+
+    visit_vectors<Type_>(fn, skip, offset);
+}
+
+template <class Root_>
+consteval uint32_t count_vectors(void)
+{
+    auto count = uint32_t{ 0 };
+    auto fn    = [&count](VectorField ) { ++count; };
+
+    visit_vectors<Root_>(fn, 0);
+
+    return count;
+}
+
+template <class Root_>
+consteval auto make_vector_fields(void)
+{
+    auto fields = std::array<VectorField, count_vectors<Root_>()>{ };
+    auto index  = size_t{ 0 };
+    auto fn     = [&](VectorField field) { fields[index++] = field; };
+
+    visit_vectors<Root_>(fn, 0);
+
+    return fields;
+}
+
+// • FNV-1a over the 32-bit words of the layout
+//
+template <class Root_>
+consteval uint64_t make_layout_hash(void)
+{
+    auto hash = uint64_t{ 0xcbf2'9ce4'8422'2325 };
+    auto fold = [&hash](uint32_t word) {
+        for ( auto byte = 0; byte < 4; ++byte )
+        {
+            hash ^= ( word >> ( 8 * byte ) ) & 0xff;
+            hash *= 0x0000'0100'0000'01b3;
+        }
+    };
+
+    fold( static_cast<uint32_t>(sizeof(Root_)) );
+    fold( static_cast<uint32_t>(alignof(Root_)) );
+
+    for ( const auto& field : make_vector_fields<Root_>() )
+    {
+        fold(field.offset);
+        fold(field.element_size);
+        fold(field.alignment);
+    }
+
+    // • Then the element types found only through HashedElement
+    //
+    auto skip    = [](VectorField ) { };
+    auto element = [&fold](uint32_t size, uint32_t alignment) {
+        fold(size);
+        fold(alignment);
+    };
+
+    visit_vectors<Root_>(skip, element, 0);
+
+    return hash;
+}
+
+} // namespace detail
+
+// • Every VectorRef of a root with a schema, including those of nested structs
+//   and arrays, in schema order
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+inline constexpr auto vector_fields = detail::make_vector_fields<Root_>();
+
+// • Changes whenever the size or alignment of the root, or the offset or
+//   element type size or alignment of any of its VectorRef, or the element
+//   type size or alignment of any of its SegmentedVectorRef, does
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+inline constexpr uint64_t layout_hash = detail::make_layout_hash<Root_>();
+
+//===------------------------------------------------------------------------===
+// • Whole buffer operations
+//===------------------------------------------------------------------------===
+
+// • Each VectorRef of a root, in place
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+const VectorRef<uint8_t>& vector_at(const Root_* root, const VectorField& field) noexcept
+{
+    return *detail::offset_by<VectorRef<uint8_t>>(root, field.offset);
+}
+
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+VectorRef<uint8_t>& vector_at(Root_* root, const VectorField& field) noexcept
+{
+    return *detail::offset_by<VectorRef<uint8_t>>(root, field.offset);
+}
+
+// • Every VectorRef of the root in the 'data' atom is null and empty, or
+//   refers to a 'vctr' atom large enough for its elements
+//
+template <TrivialLayout Root_>
+    requires HasSchema<Root_>
+bool validate_vectors(const Atom* data) noexcept
+{
+    const auto root = detail::contents<Root_>(data);
+
+    return std::all_of( vector_fields<Root_>.begin(), vector_fields<Root_>.end(), [&](const auto& field) {
+        const auto& ref   = vector_at(root, field);
+        const auto length = uint64_t{ ref.count } * field.element_size;
+
+        return length <= std::numeric_limits<uint32_t>::max()
+            && detail::is_valid_allocation( VectorRef<uint8_t>{ ref.offset, static_cast<uint32_t>(length) }, data );
+    });
+}
+
+} // namespace data
@@ -0,0 +1,514 @@
+//
+//  SegmentedVector-Host.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/SegmentedVectorRef.hpp>
+#include <Data/Vector-Host.hpp>
+
+#include <bit>
+#include <compare>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<SegmentedVectorRef<int>>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • SegmentedVector
+//
+//===------------------------------------------------------------------------===
+
+// • Vector of elements in fixed length chunks, each its own 'vctr' atom, found
+//   through a directory of chunk offsets. Growing adds chunks and never moves
+//   the elements already stored, so references to them stay valid until they
+//   are erased; only the directory is reallocated
+//
+template <TrivialLayout Type_>
+class SegmentedVector
+{
+public:
+
+    // • Types : values
+    //
+    using segmented_ref   = SegmentedVectorRef<Type_>;
+    using value_type      = Type_;
+    using size_type       = uint32_t;
+    using difference_type = int32_t;
+
+    // • Types : pointers and references
+    //
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = Type_*;
+    using const_pointer   = const Type_*;
+
+    // • Types : iterators, which cross chunks
+    //
+    template <bool Const_>
+    class basic_iterator
+    {
+    public:
+
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Type_;
+        using difference_type   = SegmentedVector::difference_type;
+        using pointer           = std::conditional_t<Const_, const Type_*, Type_*>;
+        using reference         = std::conditional_t<Const_, const Type_&, Type_&>;
+        using vector_pointer    = std::conditional_t<Const_, const SegmentedVector*, SegmentedVector*>;
+
+        basic_iterator(void) noexcept = default;
+
+        basic_iterator(vector_pointer vector, size_type index) noexcept
+            :
+                m_vector{ vector },
+                m_index { index  }
+        {
+        }
+
+        operator basic_iterator<true> (void) const noexcept requires ( !Const_ )
+        {
+            return { m_vector, m_index };
+        }
+
+        // • Access
+        //
+        reference operator * (void) const noexcept
+        {
+            return (*m_vector)[m_index];
+        }
+
+        pointer operator -> (void) const noexcept
+        {
+            return &(*m_vector)[m_index];
+        }
+
+        reference operator [] (difference_type offset) const noexcept
+        {
+            return (*m_vector)[m_index + offset];
+        }
+
+        // • Movement
+        //
+        basic_iterator& operator ++ (void) noexcept
+        {
+            ++m_index;
+
+            return *this;
+        }
+
+        basic_iterator& operator -- (void) noexcept
+        {
+            --m_index;
+
+            return *this;
+        }
+
+        basic_iterator operator ++ (int) noexcept
+        {
+            return { m_vector, m_index++ };
+        }
+
+        basic_iterator operator -- (int) noexcept
+        {
+            return { m_vector, m_index-- };
+        }
+
+        basic_iterator& operator += (difference_type offset) noexcept
+        {
+            m_index += offset;
+
+            return *this;
+        }
+
+        basic_iterator& operator -= (difference_type offset) noexcept
+        {
+            m_index -= offset;
+
+            return *this;
+        }
+
+        basic_iterator operator + (difference_type offset) const noexcept
+        {
+            return { m_vector, m_index + offset };
+        }
+
+        basic_iterator operator - (difference_type offset) const noexcept
+        {
+            return { m_vector, m_index - offset };
+        }
+
+        friend basic_iterator operator + (difference_type offset, const basic_iterator& it) noexcept
+        {
+            return it + offset;
+        }
+
+        difference_type operator - (const basic_iterator& other) const noexcept
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        // • Comparison
+        //
+        bool operator == (const basic_iterator& ) const noexcept = default;
+        auto operator <=> (const basic_iterator& ) const noexcept = default;
+
+    private:
+
+        vector_pointer  m_vector = nullptr;
+        size_type       m_index  = 0;
+    };
+
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // • Chunks of 64 KB by default
+    //
+    static constexpr size_type default_chunk_length = std::bit_floor( std::max<size_t>(1, 0x10000 / sizeof(Type_)) );
+
+public:
+
+    // • Initialization
+    //
+    SegmentedVector(segmented_ref& ref, Atom* data) noexcept(false)
+        :
+            SegmentedVector{ ref, data, stored_chunk_length(ref) }
+    {
+    }
+
+    //      The chunk length, a power of two, must match that of a vector which
+    //      already has chunks
+    //
+    SegmentedVector(segmented_ref& ref, Atom* data, size_type chunk_length) noexcept(false)
+        :
+            m_ref   { ref  },
+            m_data  { data },
+            m_chunks{ ref.chunks, data }
+    {
+        if ( !std::has_single_bit(chunk_length) || std::numeric_limits<uint32_t>::max() / sizeof(Type_) < chunk_length ) {
+            throw false;
+        }
+
+        const auto shift = static_cast<uint32_t>( std::countr_zero(chunk_length) );
+
+        if ( is_unset(m_ref) )
+        {
+            m_ref.shift = shift;
+        }
+        else if ( shift != m_ref.shift )
+        {
+            throw false;
+        }
+
+        if ( capacity() < m_ref.count ) {
+            throw false;
+        }
+
+        for ( auto offset : m_chunks ) {
+            detail::allocation_header( VectorRef<Type_>{ offset, chunk_length }, m_data );
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    SegmentedVector(const SegmentedVector& ) = delete;
+    SegmentedVector(SegmentedVector&& ) = delete;
+    SegmentedVector(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    SegmentedVector& operator = (const SegmentedVector& ) = delete;
+    SegmentedVector& operator = (SegmentedVector&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_ref.count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_ref.count;
+    }
+
+    size_type capacity(void) const noexcept
+    {
+        return static_cast<size_type>( std::min<uint64_t>( uint64_t{ m_chunks.size() } << m_ref.shift,
+                                                           std::numeric_limits<size_type>::max() ) );
+    }
+
+    size_type chunk_length(void) const noexcept
+    {
+        return size_type{ 1 } << m_ref.shift;
+    }
+
+    size_type chunk_count(void) const noexcept
+    {
+        return m_chunks.size();
+    }
+
+    // • Accessors : iterators
+    //
+    iterator begin(void) noexcept
+    {
+        return { this, 0 };
+    }
+
+    iterator end(void) noexcept
+    {
+        return { this, size() };
+    }
+
+    const_iterator begin(void) const noexcept
+    {
+        return { this, 0 };
+    }
+
+    const_iterator end(void) const noexcept
+    {
+        return { this, size() };
+    }
+
+    const_iterator cbegin(void) const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend(void) const noexcept
+    {
+        return end();
+    }
+
+    // • Accessors : elements
+    //
+    reference operator [] (size_type index) noexcept
+    {
+        assert( index < size() );
+
+        return chunk_data(index >> m_ref.shift)[index & ( chunk_length() - 1 )];
+    }
+
+    const_reference operator [] (size_type index) const noexcept
+    {
+        assert( index < size() );
+
+        return chunk_data(index >> m_ref.shift)[index & ( chunk_length() - 1 )];
+    }
+
+    reference front(void) noexcept
+    {
+        return (*this)[0];
+    }
+
+    const_reference front(void) const noexcept
+    {
+        return (*this)[0];
+    }
+
+    reference back(void) noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    const_reference back(void) const noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    //      The elements in use of a chunk, contiguous, for loops over a chunk
+    //      at a time
+    //
+    std::span<value_type> chunk(size_type index) noexcept
+    {
+        return { chunk_data(index), chunk_size(index) };
+    }
+
+    std::span<const value_type> chunk(size_type index) const noexcept
+    {
+        return { chunk_data(index), chunk_size(index) };
+    }
+
+    // • Methods : capacity
+    //
+    //      Adds chunks until there is room for capacity elements
+    //
+    void reserve(size_type capacity) noexcept(false)
+    {
+        const auto chunk_count = static_cast<size_type>( ( uint64_t{ capacity } + chunk_length() - 1 ) >> m_ref.shift );
+
+        if ( chunk_count <= m_chunks.size() )
+        {
+            // • No-op
+            //
+            return;
+        }
+
+        m_chunks.reserve( std::max(chunk_count, m_chunks.size() + m_chunks.size() / 2) );
+
+        while ( m_chunks.size() < chunk_count )
+        {
+            auto chunk = detail::reserve( m_data, chunk_length() * sizeof(value_type), AtomID::vector );
+
+            m_chunks.push_back( detail::contents_offset(m_data, chunk) );
+        }
+    }
+
+    //      Frees the chunks past the last element
+    //
+    void shrink_to_fit(void) noexcept(false)
+    {
+        const auto chunk_count = static_cast<size_type>( ( uint64_t{ size() } + chunk_length() - 1 ) >> m_ref.shift );
+
+        while ( chunk_count < m_chunks.size() )
+        {
+            detail::free( detail::allocation_header( VectorRef<value_type>{ m_chunks.back(), chunk_length() }, m_data ) );
+
+            m_chunks.pop_back();
+        }
+    }
+
+    // • Methods : container
+    //
+    void push_back(const_reference value) noexcept(false)
+    {
+        if ( capacity() == size() ) {
+            reserve( size() + 1 );
+        }
+
+        const auto index = m_ref.count++;
+
+        (*this)[index] = value;
+    }
+
+    void pop_back(void) noexcept
+    {
+        assert( !empty() );
+
+        --m_ref.count;
+    }
+
+    //      Copies a chunk at a time
+    //
+    void append(std::span<const value_type> values) noexcept(false)
+    {
+        if ( std::numeric_limits<size_type>::max() - size() < values.size() ) {
+            throw false;
+        }
+
+        reserve( size() + static_cast<size_type>(values.size()) );
+
+        while ( !values.empty() )
+        {
+            const auto offset = size() & ( chunk_length() - 1 );
+            const auto count  = std::min<size_t>( chunk_length() - offset, values.size() );
+
+            std::copy_n( values.begin(), count, chunk_data(size() >> m_ref.shift) + offset );
+
+            m_ref.count += static_cast<size_type>(count);
+            values       = values.subspan(count);
+        }
+    }
+
+    void resize(size_type count) noexcept(false)
+    {
+        reserve(count);
+
+        for ( auto index = size(); index < count; ++index ) {
+            chunk_data(index >> m_ref.shift)[index & ( chunk_length() - 1 )] = value_type{ };
+        }
+
+        m_ref.count = count;
+    }
+
+    //      Keeps the chunks for reuse
+    //
+    void clear(void) noexcept
+    {
+        m_ref.count = 0;
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    static bool is_unset(const segmented_ref& ref) noexcept
+    {
+        return 0 == ref.shift && detail::empty(ref.chunks);
+    }
+
+    //      The shift comes from the buffer: reject one that would overflow
+    //      the shift itself or the byte length of a chunk
+    //
+    static size_type stored_chunk_length(const segmented_ref& ref) noexcept(false)
+    {
+        if ( is_unset(ref) ) {
+            return default_chunk_length;
+        }
+
+        if ( 32 <= ref.shift || std::numeric_limits<uint32_t>::max() / sizeof(Type_) < ( uint64_t{ 1 } << ref.shift ) ) {
+            throw false;
+        }
+
+        return size_type{ 1 } << ref.shift;
+    }
+
+    pointer chunk_data(size_type chunk) noexcept
+    {
+        return detail::offset_by<value_type>( m_data, m_chunks[chunk] );
+    }
+
+    const_pointer chunk_data(size_type chunk) const noexcept
+    {
+        return detail::offset_by<value_type>( static_cast<const Atom*>(m_data), m_chunks[chunk] );
+    }
+
+    size_type chunk_size(size_type chunk) const noexcept
+    {
+        assert( chunk < chunk_count() );
+
+        const auto first = uint64_t{ chunk } << m_ref.shift;
+
+        return ( first < size() ) ? static_cast<size_type>( std::min<uint64_t>(chunk_length(), size() - first) ) : 0;
+    }
+
+private:
+
+    // • Data members
+    //
+    segmented_ref&      m_ref;
+    Atom*               m_data;
+    Vector<uint32_t>    m_chunks;
+};
+
+} // namespace data
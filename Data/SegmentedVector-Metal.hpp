@@ -0,0 +1,54 @@
+//
+//  SegmentedVector-Metal.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/SegmentedVectorRef.hpp>
+#include <Data/Vector-Metal.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • SegmentedVector utilities (Metal)
+//
+//===------------------------------------------------------------------------===
+
+template <TRIVIAL_LAYOUT Type_>
+const device Type_* element(SegmentedVectorRef<Type_> ref, const device uint8_t* base, uint32_t index)
+{
+    const uint32_t chunk_offset = contents(ref.chunks, base)[index >> ref.shift];
+
+    return reinterpret_cast<const device Type_*>(base + chunk_offset) + ( index & ( ( 1u << ref.shift ) - 1 ) );
+}
+
+template <TRIVIAL_LAYOUT Type_>
+device Type_* element(SegmentedVectorRef<Type_> ref, device uint8_t* base, uint32_t index)
+{
+    const uint32_t chunk_offset = contents(ref.chunks, static_cast<const device uint8_t*>(base))[index >> ref.shift];
+
+    return reinterpret_cast<device Type_*>(base + chunk_offset) + ( index & ( ( 1u << ref.shift ) - 1 ) );
+}
+
+} // namespace data
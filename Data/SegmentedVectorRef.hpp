@@ -0,0 +1,52 @@
+//
+//  SegmentedVectorRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • SegmentedVectorRef
+//
+//===------------------------------------------------------------------------===
+
+// • Elements in chunks of 2^shift, each its own 'vctr' atom. The directory
+//   holds the contents offset of each chunk, so element i is element
+//   i & (2^shift - 1) of chunk i >> shift
+//
+template <TRIVIAL_LAYOUT Type_>
+struct SegmentedVectorRef
+{
+    uint32_t                count;
+    uint32_t                shift;
+    VectorRef<uint32_t>     chunks;
+};
+
+static_assert( 16 ==  sizeof(SegmentedVectorRef<int>), "Unexpected size" );
+static_assert(  4 == alignof(SegmentedVectorRef<int>), "Unexpected alignment" );
+
+} // namespace data
@@ -0,0 +1,345 @@
+//
+//  SoAVector.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/ColumnsRef.hpp>
+#include <Data/Record.hpp>
+#include <Data/Vector.hpp>
+
+#include <array>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Verification
+//===------------------------------------------------------------------------===
+
+static_assert( data::is_trivial_layout<ColumnsRef<3>>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+//
+// • SoAVector
+//
+//===------------------------------------------------------------------------===
+
+// • Vector of records stored as one column per field, so that scans of a field
+//   only load that field. Rows are accessed through a proxy reference
+//
+template <TrivialLayout Record_>
+    requires std::is_aggregate_v<Record_>
+class SoAVector
+{
+public:
+
+    // • Types
+    //
+    static constexpr uint32_t column_count = field_count<Record_>;
+
+    using columns_ref = ColumnsRef<column_count>;
+    using value_type  = Record_;
+    using size_type   = uint32_t;
+
+    template <uint32_t Index_>
+    using column_type = field_type<Record_, Index_>;
+
+    // • Proxy reference to a row
+    //
+    class reference
+    {
+    public:
+
+        reference(SoAVector& vector, size_type index) noexcept
+            :
+                m_vector{ vector },
+                m_index { index  }
+        {
+        }
+
+        operator value_type (void) const noexcept
+        {
+            return m_vector.load(m_index);
+        }
+
+        reference& operator = (const value_type& record) noexcept
+        {
+            m_vector.store(m_index, record);
+
+            return *this;
+        }
+
+        template <uint32_t Index_>
+        column_type<Index_>& get(void) const noexcept
+        {
+            return m_vector.template column<Index_>()[m_index];
+        }
+
+    private:
+
+        SoAVector&  m_vector;
+        size_type   m_index;
+    };
+
+private:
+
+    using index_sequence = std::make_integer_sequence<uint32_t, column_count>;
+
+    template <uint32_t... Indices_>
+    static constexpr std::array<uint32_t, column_count> field_sizes(std::integer_sequence<uint32_t, Indices_...> ) noexcept
+    {
+        return { sizeof(column_type<Indices_>)... };
+    }
+
+    static constexpr auto column_sizes = field_sizes( index_sequence{ } );
+
+public:
+
+    // • Initialization
+    //
+    SoAVector(columns_ref& ref, Atom* data) noexcept(false)
+        :
+            m_ref  { ref  },
+            m_data { data },
+            m_vctrs{      }
+    {
+        for ( auto index = uint32_t{ 0 }; index < column_count; ++index )
+        {
+            if ( 0 != m_ref.offsets[index] )
+            {
+                m_vctrs[index] = detail::allocation_header( VectorRef<uint8_t>{ m_ref.offsets[index],
+                                                                                m_ref.count * column_sizes[index] }, m_data );
+            }
+            else if ( 0 != m_ref.count )
+            {
+                throw false;
+            }
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    SoAVector(const SoAVector& ) = delete;
+    SoAVector(SoAVector&& ) = delete;
+    SoAVector(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    SoAVector& operator = (const SoAVector& ) = delete;
+    SoAVector& operator = (SoAVector&& ) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_ref.count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_ref.count;
+    }
+
+    size_type capacity(void) const noexcept
+    {
+        auto capacity = std::numeric_limits<size_type>::max();
+
+        for ( auto index = uint32_t{ 0 }; index < column_count; ++index )
+        {
+            capacity = ( nullptr != m_vctrs[index] )
+                ? std::min( capacity, detail::contents_size(m_vctrs[index]) / column_sizes[index] )
+                : 0;
+        }
+
+        return capacity;
+    }
+
+    // • Accessors : columns
+    //
+    template <uint32_t Index_>
+    std::span<column_type<Index_>> column(void) noexcept
+    {
+        return { column_data<Index_>(), size() };
+    }
+
+    template <uint32_t Index_>
+    std::span<const column_type<Index_>> column(void) const noexcept
+    {
+        return { column_data<Index_>(), size() };
+    }
+
+    // • Accessors : rows
+    //
+    reference operator [] (size_type index) noexcept
+    {
+        assert( index < size() );
+
+        return { *this, index };
+    }
+
+    value_type operator [] (size_type index) const noexcept
+    {
+        assert( index < size() );
+
+        return load(index);
+    }
+
+    value_type load(size_type index) const noexcept
+    {
+        auto record = value_type{ };
+
+        load_fields( record, index, index_sequence{ } );
+
+        return record;
+    }
+
+    void store(size_type index, const value_type& record) noexcept
+    {
+        store_fields( index, record, index_sequence{ } );
+    }
+
+    // • Methods : capacity
+    //
+    //      Reserves every column with one pass over the atoms
+    //
+    void reserve(size_type capacity) noexcept(false)
+    {
+        if ( capacity <= this->capacity() )
+        {
+            // • No-op
+            //
+            return;
+        }
+
+        auto sizes = std::array<uint32_t, column_count>{ };
+
+        for ( auto index = uint32_t{ 0 }; index < column_count; ++index )
+        {
+            if ( std::numeric_limits<uint32_t>::max() / column_sizes[index] < capacity ) {
+                throw false;
+            }
+
+            sizes[index] = capacity * column_sizes[index];
+        }
+
+        detail::reserve( m_data, m_vctrs, sizes );
+
+        for ( auto index = uint32_t{ 0 }; index < column_count; ++index ) {
+            m_ref.offsets[index] = detail::contents_offset(m_data, m_vctrs[index]);
+        }
+    }
+
+    // • Methods : container
+    //
+    void push_back(const value_type& record) noexcept(false)
+    {
+        if ( capacity() < size() + 1 )
+        {
+            reserve( std::max(size() + 1, size() + size() / 2) );
+        }
+
+        store( m_ref.count++, record );
+    }
+
+    void append(std::span<const value_type> records) noexcept(false)
+    {
+        assert( records.size() <= std::numeric_limits<size_type>::max() - size() );
+
+        const auto count = static_cast<size_type>( records.size() );
+
+        if ( capacity() < size() + count )
+        {
+            reserve( std::max(size() + count, size() + size() / 2) );
+        }
+
+        for ( const auto& record : records ) {
+            store( m_ref.count++, record );
+        }
+    }
+
+    void resize(size_type count) noexcept(false)
+    {
+        if ( capacity() < count )
+        {
+            reserve(count);
+        }
+
+        for ( auto index = size(); index < count; ++index ) {
+            store( index, value_type{ } );
+        }
+
+        m_ref.count = count;
+    }
+
+    void pop_back(void) noexcept
+    {
+        assert( !empty() );
+
+        --m_ref.count;
+    }
+
+    void clear(void) noexcept
+    {
+        m_ref.count = 0;
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    template <uint32_t Index_>
+    column_type<Index_>* column_data(void) const noexcept
+    {
+        return ( nullptr != m_vctrs[Index_] ) ? detail::contents<column_type<Index_>>(m_vctrs[Index_]) : nullptr;
+    }
+
+    template <uint32_t... Indices_>
+    void load_fields(value_type& record, size_type index, std::integer_sequence<uint32_t, Indices_...> ) const noexcept
+    {
+        auto fields = tie_fields(record);
+
+        ( ( std::get<Indices_>(fields) = column_data<Indices_>()[index] ), ... );
+    }
+
+    template <uint32_t... Indices_>
+    void store_fields(size_type index, const value_type& record, std::integer_sequence<uint32_t, Indices_...> ) noexcept
+    {
+        const auto fields = tie_fields(record);
+
+        ( ( column_data<Indices_>()[index] = std::get<Indices_>(fields) ), ... );
+    }
+
+private:
+
+    // • Data members
+    //
+    columns_ref&                        m_ref;
+    Atom*                               m_data;
+    std::array<Atom*, column_count>     m_vctrs;
+};
+
+} // namespace data
@@ -0,0 +1,217 @@
+//
+//  StringPool.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/StringPool.hpp>
+#include <Data/HashTable.hpp>
+
+#include <bit>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+// • Index utilities
+//===------------------------------------------------------------------------===
+
+constexpr uint32_t max_string_load(uint32_t capacity) noexcept
+{
+    return capacity / 4 * 3;
+}
+
+inline uint32_t string_hash(std::string_view string) noexcept
+{
+    return static_cast<uint32_t>( hash_bytes(string.data(), string.size()) );
+}
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • StringPool
+//
+//===------------------------------------------------------------------------===
+
+StringPool::StringPool(StringPoolRef& ref, Atom* data) noexcept(false)
+    :
+        m_bytes{ ref.bytes, data },
+        m_ends { ref.ends,  data },
+        m_index{ ref.index, data }
+{
+    if ( !m_index.empty() && !std::has_single_bit(m_index.size()) ) {
+        throw false;
+    }
+
+    if ( detail::max_string_load(m_index.size()) < size() ) {
+        throw false;
+    }
+
+    if ( !empty() && m_bytes.size() < m_ends.back() ) {
+        throw false;
+    }
+}
+
+std::optional<StringHandle> StringPool::find(std::string_view string) const noexcept
+{
+    if ( m_index.empty() ) {
+        return std::nullopt;
+    }
+
+    const auto slot = m_index[ find_slot(string, detail::string_hash(string)) ];
+
+    return ( 0 != slot.handle ) ? std::optional{ StringHandle{ slot.handle - 1 } } : std::nullopt;
+}
+
+void StringPool::reserve(uint32_t string_count, uint32_t byte_count) noexcept(false)
+{
+    m_bytes.reserve(byte_count);
+    m_ends.reserve(string_count);
+
+    reserve_index(string_count);
+}
+
+StringHandle StringPool::intern(std::string_view string) noexcept(false)
+{
+    if ( std::numeric_limits<uint32_t>::max() - m_bytes.size() < string.size() ) {
+        throw false;
+    }
+
+    reserve_index(size() + 1);
+
+    const auto hash = detail::string_hash(string);
+    auto& slot      = m_index[ find_slot(string, hash) ];
+
+    if ( 0 != slot.handle ) {
+        return StringHandle{ slot.handle - 1 };
+    }
+
+    // • Append the string, growing by half again to amortize the reservations
+    //
+    const auto length = static_cast<uint32_t>( string.size() );
+
+    if ( m_bytes.available() < length ) {
+        m_bytes.reserve( std::max(m_bytes.size() + length, m_bytes.size() + m_bytes.size() / 2) );
+    }
+
+    if ( m_ends.available() < 1 ) {
+        m_ends.reserve( std::max(m_ends.size() + 1, m_ends.size() + m_ends.size() / 2) );
+    }
+
+    const auto append = m_bytes.append_uninitialized(length);
+
+    std::copy( string.begin(), string.end(), append.begin() );
+
+    m_ends.push_back( m_bytes.size() );
+
+    slot = { .hash = hash, .handle = size() };
+
+    return StringHandle{ size() - 1 };
+}
+
+std::vector<StringHandle> StringPool::intern(std::span<const std::string_view> strings) noexcept(false)
+{
+    auto byte_count = uint64_t{ m_bytes.size() };
+
+    for ( auto string : strings ) {
+        byte_count += string.size();
+    }
+
+    if ( std::numeric_limits<uint32_t>::max() < byte_count || std::numeric_limits<uint32_t>::max() - size() < strings.size() ) {
+        throw false;
+    }
+
+    // • Reserve for every string, as if none were already interned
+    //
+    reserve( size() + static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(byte_count) );
+
+    auto handles = std::vector<StringHandle>( strings.size() );
+
+    for ( auto index = size_t{ 0 }; index < strings.size(); ++index ) {
+        handles[index] = intern( strings[index] );
+    }
+
+    return handles;
+}
+
+uint32_t StringPool::find_slot(std::string_view string, uint32_t hash) const noexcept
+{
+    const auto mask = m_index.size() - 1;
+
+    for ( auto index = hash & mask; ; index = (index + 1) & mask )
+    {
+        const auto& slot = m_index[index];
+
+        if ( 0 == slot.handle || ( hash == slot.hash && string == view( StringHandle{ slot.handle - 1 } ) ) ) {
+            return index;
+        }
+    }
+}
+
+void StringPool::reserve_index(uint32_t string_count) noexcept(false)
+{
+    if ( string_count <= detail::max_string_load(m_index.size()) )
+    {
+        // • No-op
+        //
+        return;
+    }
+
+    auto capacity = std::max( 16u, m_index.size() );
+
+    while ( detail::max_string_load(capacity) < string_count )
+    {
+        if ( std::numeric_limits<uint32_t>::max() / 2 < capacity ) {
+            throw false;
+        }
+
+        capacity *= 2;
+    }
+
+    // • Reinsert the strings, with their stored hashes
+    //
+    const auto slots = std::vector<StringSlot>( m_index.begin(), m_index.end() );
+
+    for ( auto& slot : m_index.resize_for_overwrite(capacity) ) {
+        slot = { };
+    }
+
+    for ( const auto& slot : slots )
+    {
+        if ( 0 == slot.handle ) {
+            continue;
+        }
+
+        for ( auto index = slot.hash & (capacity - 1); ; index = (index + 1) & (capacity - 1) )
+        {
+            if ( 0 == m_index[index].handle )
+            {
+                m_index[index] = slot;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace data
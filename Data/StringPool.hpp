@@ -0,0 +1,129 @@
+//
+//  StringPool.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/StringPoolRef.hpp>
+#include <Data/Vector.hpp>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • StringPool
+//
+//===------------------------------------------------------------------------===
+
+// • Append-only pool of unique strings. The interning index is stored with the
+//   strings, so a mapped pool is searched without being rebuilt. It hashes
+//   the strings as HashTable hashes keys, with detail::hash_bytes
+//
+class StringPool
+{
+public:
+
+    // • Initialization
+    //
+    StringPool(StringPoolRef& ref, Atom* data) noexcept(false);
+
+private:
+
+    // • Initialization (deleted)
+    //
+    StringPool(const StringPool& ) = delete;
+    StringPool(StringPool&& ) = delete;
+    StringPool(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    StringPool& operator = (const StringPool& ) = delete;
+    StringPool& operator = (StringPool&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint32_t size(void) const noexcept
+    {
+        return m_ends.size();
+    }
+
+    bool empty(void) const noexcept
+    {
+        return m_ends.empty();
+    }
+
+    //      The view refers to the buffer, and is valid until the next insertion
+    //
+    std::string_view view(StringHandle handle) const noexcept
+    {
+        const auto index = static_cast<uint32_t>(handle);
+
+        assert( index < size() );
+
+        const auto begin = ( 0 < index ) ? m_ends[index - 1] : 0;
+
+        return { m_bytes.data() + begin, m_ends[index] - begin };
+    }
+
+    std::string_view operator [] (StringHandle handle) const noexcept
+    {
+        return view(handle);
+    }
+
+    std::optional<StringHandle> find(std::string_view string) const noexcept;
+
+    // • Methods
+    //
+    void reserve(uint32_t string_count, uint32_t byte_count) noexcept(false);
+
+    StringHandle intern(std::string_view string) noexcept(false);
+
+    //      Reserves once for all of the strings, then interns them in order
+    //
+    std::vector<StringHandle> intern(std::span<const std::string_view> strings) noexcept(false);
+
+private:
+
+    // • Utilities (private)
+    //
+    uint32_t find_slot(std::string_view string, uint32_t hash) const noexcept;
+
+    void reserve_index(uint32_t string_count) noexcept(false);
+
+private:
+
+    // • Data members
+    //
+    Vector<char>        m_bytes;
+    Vector<uint32_t>    m_ends;
+    Vector<StringSlot>  m_index;
+};
+
+} // namespace data
@@ -0,0 +1,67 @@
+//
+//  StringPoolRef.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/VectorRef.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • StringPoolRef
+//
+//===------------------------------------------------------------------------===
+
+// • Index of a string in its pool. Equal strings of a pool have equal handles
+//
+enum class StringHandle : uint32_t { };
+
+// • Slot of the interning index, an open addressing table with linear probing.
+//   It isn't a HashTable: a HashTableRef isn't a VectorRef, so the index would
+//   be invisible to the schema, and thus to merge, inspect and the planner.
+//   HashTable also compares the keys it stores, where these are strings in
+//   the bytes of the pool
+//
+struct StringSlot
+{
+    uint32_t    hash;       // Low bits of the string hash
+    uint32_t    handle;     // Handle + 1, or zero if the slot is empty
+};
+
+struct StringPoolRef
+{
+    VectorRef<char>         bytes;      // Strings, concatenated without terminators
+    VectorRef<uint32_t>     ends;       // End offset of each string in bytes
+    VectorRef<StringSlot>   index;      // Zero or a power of two slots
+};
+
+static_assert(  8 ==  sizeof(StringSlot), "Unexpected size" );
+static_assert( 24 ==  sizeof(StringPoolRef), "Unexpected size" );
+static_assert(  4 == alignof(StringPoolRef), "Unexpected alignment" );
+
+static_assert( data::is_trivial_layout<StringHandle>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<StringPoolRef>(), "Unexpected layout" );
+
+} // namespace data
@@ -0,0 +1,314 @@
+//
+//  ThreadPool.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/ThreadPool.hpp>
+#include <Data/Trace.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <utility>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace detail
+{
+
+//===------------------------------------------------------------------------===
+// • Worker of the calling thread
+//===------------------------------------------------------------------------===
+
+struct CurrentWorker
+{
+    const ThreadPool*   pool  = nullptr;
+    uint32_t            index = 0;
+};
+
+thread_local auto current_worker = CurrentWorker{ };
+
+} // namespace detail
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadPool
+//
+//===------------------------------------------------------------------------===
+
+ThreadPool::ThreadPool(uint32_t thread_count) noexcept(false)
+    :
+        m_pending { 0     },
+        m_stopping{ false },
+        m_next    { 0     }
+{
+    if ( 0 == thread_count ) {
+        thread_count = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+
+    for ( auto index = uint32_t{ 0 }; index < thread_count; ++index ) {
+        m_workers.push_back( std::make_unique<Worker>() );
+    }
+
+    for ( auto index = uint32_t{ 0 }; index < thread_count; ++index ) {
+        m_workers[index]->thread = std::thread( [this, index]() { run(index); } );
+    }
+}
+
+ThreadPool::~ThreadPool(void) noexcept
+{
+    {
+        auto lock = std::lock_guard{ m_mutex };
+
+        m_stopping = true;
+    }
+
+    m_wake.notify_all();
+
+    for ( auto& worker : m_workers ) {
+        worker->thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared(void) noexcept(false)
+{
+    static auto pool = ThreadPool{ };
+
+    return pool;
+}
+
+void ThreadPool::submit(Task task) noexcept(false)
+{
+    // • Workers push onto their own deque, other threads distribute the tasks
+    //
+    const auto index = ( this == detail::current_worker.pool ) ? detail::current_worker.index
+                                                              : m_next++ % size();
+    auto& worker = *m_workers[index];
+
+    // • Counted before it is published, so that the worker which pops it never
+    //   decrements m_pending below zero
+    //
+    {
+        auto lock = std::lock_guard{ m_mutex };
+
+        ++m_pending;
+    }
+
+    try
+    {
+        auto lock = std::lock_guard{ worker.mutex };
+
+        worker.tasks.push_back( std::move(task) );
+    }
+    catch ( ... )
+    {
+        auto lock = std::lock_guard{ m_mutex };
+
+        --m_pending;
+        throw;
+    }
+
+    m_wake.notify_one();
+}
+
+bool ThreadPool::run_pending(void) noexcept
+{
+    auto task = Task{ };
+
+    const auto found = ( this == detail::current_worker.pool )
+                     ? pop(detail::current_worker.index, task) || steal(detail::current_worker.index, task)
+                     : steal(m_next % size(), task);
+
+    if ( found ) {
+        task();
+    }
+
+    return found;
+}
+
+void ThreadPool::run(uint32_t index) noexcept
+{
+    DATA_TRACE_THREAD();
+
+    detail::current_worker = { .pool = this, .index = index };
+
+    for ( auto task = Task{ }; ; )
+    {
+        if ( pop(index, task) || steal(index, task) )
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        auto lock = std::unique_lock{ m_mutex };
+
+        m_wake.wait( lock, [this]() { return m_stopping || 0 < m_pending; } );
+
+        if ( m_stopping && 0 == m_pending ) {
+            break;
+        }
+    }
+}
+
+bool ThreadPool::pop(uint32_t index, Task& task) noexcept
+{
+    auto& worker = *m_workers[index];
+
+    {
+        auto lock = std::lock_guard{ worker.mutex };
+
+        if ( worker.tasks.empty() ) {
+            return false;
+        }
+
+        task = std::move( worker.tasks.back() );
+        worker.tasks.pop_back();
+    }
+
+    auto lock = std::lock_guard{ m_mutex };
+
+    assert( 0 < m_pending );
+
+    --m_pending;
+
+    return true;
+}
+
+bool ThreadPool::steal(uint32_t index, Task& task) noexcept
+{
+    for ( auto offset = uint32_t{ 1 }; offset <= size(); ++offset )
+    {
+        auto& worker = *m_workers[(index + offset) % size()];
+
+        {
+            auto lock = std::lock_guard{ worker.mutex };
+
+            if ( worker.tasks.empty() ) {
+                continue;
+            }
+
+            task = std::move( worker.tasks.front() );
+            worker.tasks.pop_front();
+        }
+
+        auto lock = std::lock_guard{ m_mutex };
+
+        assert( 0 < m_pending );
+
+        --m_pending;
+
+        return true;
+    }
+
+    return false;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • TaskGroup
+//
+//===------------------------------------------------------------------------===
+
+TaskGroup::TaskGroup(ThreadPool& pool) noexcept
+    :
+        m_pool     { pool },
+        m_remaining{ 0    }
+{
+}
+
+TaskGroup::~TaskGroup(void) noexcept
+{
+    // • Tasks refer to the group, so they must complete before it is destroyed
+    //
+    join();
+}
+
+void TaskGroup::run(ThreadPool::Task task) noexcept(false)
+{
+    ++m_remaining;
+
+    try
+    {
+        m_pool.submit( [this, task = std::move(task)]()
+        {
+            try
+            {
+                task();
+            }
+            catch ( ... )
+            {
+                auto lock = std::lock_guard{ m_mutex };
+
+                if ( !m_exception ) {
+                    m_exception = std::current_exception();
+                }
+            }
+
+            // • Notified with the lock held, so that join cannot return and
+            //   the group be destroyed before notify_all returns
+            //
+            auto lock = std::lock_guard{ m_mutex };
+
+            if ( 0 == --m_remaining ) {
+                m_done.notify_all();
+            }
+        });
+    }
+    catch ( ... )
+    {
+        --m_remaining;
+        throw;
+    }
+}
+
+void TaskGroup::wait(void) noexcept(false)
+{
+    join();
+
+    if ( auto exception = std::exchange(m_exception, nullptr) ) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::join(void) noexcept
+{
+    while ( 0 < m_remaining )
+    {
+        if ( m_pool.run_pending() ) {
+            continue;
+        }
+
+        // • The remaining tasks are running elsewhere. Sleep until they
+        //   complete, looking for new tasks to help with now and then
+        //
+        auto lock = std::unique_lock{ m_mutex };
+
+        m_done.wait_for( lock, std::chrono::milliseconds(1), [this]() { return 0 == m_remaining; } );
+    }
+
+    // • The last task may still hold the lock to notify
+    //
+    auto lock = std::lock_guard{ m_mutex };
+}
+
+} // namespace data
@@ -0,0 +1,187 @@
+//
+//  ThreadPool.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadPool
+//
+//===------------------------------------------------------------------------===
+
+// • Fixed set of worker threads, each with its own task deque. A worker runs
+//   its most recent task first and, when its deque is empty, steals the oldest
+//   task of another worker. Tasks submitted from a worker go to its own deque
+//
+class ThreadPool
+{
+public:
+
+    using Task = std::function<void(void)>;
+
+    // • Initialization
+    //
+    //      A thread count of zero uses the hardware concurrency
+    //
+    explicit ThreadPool(uint32_t thread_count = 0) noexcept(false);
+
+    ~ThreadPool(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    ThreadPool(const ThreadPool& ) = delete;
+    ThreadPool(ThreadPool&& ) = delete;
+
+    // • Assignment (deleted)
+    //
+    ThreadPool& operator = (const ThreadPool& ) = delete;
+    ThreadPool& operator = (ThreadPool&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint32_t size(void) const noexcept
+    {
+        return static_cast<uint32_t>( m_workers.size() );
+    }
+
+    // • Pool shared by the process, created on first use
+    //
+    static ThreadPool& shared(void) noexcept(false);
+
+    // • Methods
+    //
+    void submit(Task task) noexcept(false);
+
+    //      Runs one pending task on the calling thread, so that a thread
+    //      waiting for tasks helps to complete them. Returns false if none
+    //
+    bool run_pending(void) noexcept;
+
+private:
+
+    struct Worker
+    {
+        std::mutex          mutex;
+        std::deque<Task>    tasks;
+        std::thread         thread;
+    };
+
+    // • Utilities (private)
+    //
+    void run(uint32_t index) noexcept;
+
+    bool pop(uint32_t index, Task& task) noexcept;
+    bool steal(uint32_t index, Task& task) noexcept;
+
+private:
+
+    // • Data members
+    //
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    uint32_t                m_pending;
+    bool                    m_stopping;
+
+    std::atomic<uint32_t>   m_next;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • TaskGroup
+//
+//===------------------------------------------------------------------------===
+
+// • Tasks submitted to a pool that are waited for together. The waiting thread
+//   runs pending tasks, so groups may be nested within tasks. The first
+//   exception thrown by a task is rethrown by wait()
+//
+class TaskGroup
+{
+public:
+
+    // • Initialization
+    //
+    explicit TaskGroup(ThreadPool& pool) noexcept;
+
+    ~TaskGroup(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    TaskGroup(const TaskGroup& ) = delete;
+    TaskGroup(TaskGroup&& ) = delete;
+    TaskGroup(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    TaskGroup& operator = (const TaskGroup& ) = delete;
+    TaskGroup& operator = (TaskGroup&& ) = delete;
+
+public:
+
+    // • Methods
+    //
+    void run(ThreadPool::Task task) noexcept(false);
+
+    void wait(void) noexcept(false);
+
+private:
+
+    // • Utilities (private)
+    //
+    void join(void) noexcept;
+
+private:
+
+    // • Data members
+    //
+    ThreadPool&             m_pool;
+    std::atomic<uint32_t>   m_remaining;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_done;
+    std::exception_ptr      m_exception;
+};
+
+} // namespace data
@@ -0,0 +1,275 @@
+//
+//  Trace.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Trace.hpp>
+
+#if DATA_TRACING
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+//===------------------------------------------------------------------------===
+// • namespace data::trace
+//===------------------------------------------------------------------------===
+
+namespace data::trace
+{
+
+namespace
+{
+
+//===------------------------------------------------------------------------===
+// • Registry
+//===------------------------------------------------------------------------===
+
+// • A timestamp and the steady clock at the same moment, to convert ticks
+//
+struct ClockSample
+{
+    uint64_t                                ticks;
+    std::chrono::steady_clock::time_point   time;
+
+    static ClockSample now(void) noexcept
+    {
+        return { timestamp(), std::chrono::steady_clock::now() };
+    }
+};
+
+struct Registry
+{
+    std::mutex                                  mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>>  buffers;
+    uint32_t                                    next_thread_id = 1;
+    ClockSample                                 start = ClockSample::now();
+};
+
+Registry& registry(void) noexcept
+{
+    static auto registry = Registry{ };
+
+    return registry;
+}
+
+// • Constant-initialized, so reading it never allocates
+//
+thread_local ThreadBuffer* current_buffer = nullptr;
+
+void write_string(std::ostream& stream, const char* string)
+{
+    stream << '"';
+
+    for ( ; '\0' != *string; ++string )
+    {
+        if ( '"' == *string || '\\' == *string ) {
+            stream << '\\';
+        }
+
+        stream << ( static_cast<unsigned char>(*string) < ' ' ? ' ' : *string );
+    }
+
+    stream << '"';
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadBuffer
+//
+//===------------------------------------------------------------------------===
+
+ThreadBuffer::ThreadBuffer(uint32_t thread_id) noexcept(false)
+    :
+        m_slots    { std::make_unique<Slot[]>(capacity) },
+        m_claimed  { 0         },
+        m_written  { 0         },
+        m_thread_id{ thread_id }
+{
+}
+
+std::vector<Event> ThreadBuffer::snapshot(void) const noexcept(false)
+{
+    const auto written = m_written.load(std::memory_order_acquire);
+    const auto first   = capacity < written ? written - capacity : 0;
+
+    auto events = std::vector<Event>{ };
+
+    events.reserve( written - first );
+
+    for ( auto index = first; index < written; ++index )
+    {
+        const auto& slot = m_slots[ index % capacity ];
+
+        events.push_back({
+            .name  = slot.name.load(std::memory_order_relaxed),
+            .begin = slot.begin.load(std::memory_order_relaxed),
+            .end   = slot.end.load(std::memory_order_relaxed)
+        });
+    }
+
+    // • Drop the oldest events whose slots were claimed again during the copy
+    //
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const auto claimed = m_claimed.load(std::memory_order_relaxed);
+
+    if ( first + capacity < claimed )
+    {
+        const auto overwritten = std::min<uint64_t>( claimed - capacity - first, events.size() );
+
+        events.erase( events.begin(), events.begin() + static_cast<ptrdiff_t>(overwritten) );
+    }
+
+    return events;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadRegistration
+//
+//===------------------------------------------------------------------------===
+
+ThreadRegistration::ThreadRegistration(void) noexcept
+{
+    if ( nullptr != current_buffer ) {
+        return;
+    }
+
+    auto& registry = data::trace::registry();
+
+    try
+    {
+        auto lock = std::lock_guard{ registry.mutex };
+
+        m_buffer = std::make_shared<ThreadBuffer>( registry.next_thread_id );
+
+        registry.buffers.push_back(m_buffer);
+        ++registry.next_thread_id;
+    }
+    catch ( ... )
+    {
+        m_buffer = nullptr;
+        return;
+    }
+
+    current_buffer = m_buffer.get();
+}
+
+ThreadRegistration::~ThreadRegistration(void) noexcept
+{
+    if ( nullptr == m_buffer ) {
+        return;
+    }
+
+    current_buffer = nullptr;
+
+    // • A concurrent export keeps its own reference until it is done
+    //
+    auto& registry = data::trace::registry();
+    auto  lock     = std::lock_guard{ registry.mutex };
+
+    std::erase( registry.buffers, m_buffer );
+}
+
+ThreadBuffer* thread_buffer(void) noexcept
+{
+    return current_buffer;
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Export
+//
+//===------------------------------------------------------------------------===
+
+void write_chrome_trace(std::ostream& stream) noexcept(false)
+{
+    auto& registry = data::trace::registry();
+
+    auto buffers = std::vector<std::shared_ptr<ThreadBuffer>>{ };
+    {
+        auto lock = std::lock_guard{ registry.mutex };
+
+        buffers = registry.buffers;
+    }
+
+    // • Ticks per microsecond, over at least a millisecond since the registry
+    //   was created
+    //
+    if ( std::chrono::steady_clock::now() - registry.start.time < std::chrono::milliseconds(1) ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+    }
+
+    const auto sample       = ClockSample::now();
+    const auto microseconds = std::chrono::duration<double, std::micro>( sample.time - registry.start.time ).count();
+    const auto scale        = microseconds / double( sample.ticks - registry.start.ticks );
+
+    // • Times from the earliest event
+    //
+    auto snapshots = std::vector<std::vector<Event>>{ };
+    auto origin    = registry.start.ticks;
+
+    for ( const auto& buffer : buffers )
+    {
+        snapshots.push_back( buffer->snapshot() );
+
+        for ( const auto& event : snapshots.back() ) {
+            origin = std::min(origin, event.begin);
+        }
+    }
+
+    const auto flags     = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    auto separator = "\n";
+
+    for ( auto index = size_t{ 0 }; index < buffers.size(); ++index )
+    {
+        const auto thread_id = buffers[index]->thread_id();
+
+        stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_id
+               << ",\"args\":{\"name\":\"thread " << thread_id << "\"}}";
+
+        separator = ",\n";
+
+        for ( const auto& event : snapshots[index] )
+        {
+            stream << separator << "{\"name\":";
+            write_string(stream, event.name);
+            stream << ",\"cat\":\"data\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id
+                   << ",\"ts\":" << ( double(event.begin - origin) * scale )
+                   << ",\"dur\":" << ( double(std::max(event.end, event.begin) - event.begin) * scale ) << '}';
+        }
+    }
+
+    stream << "\n]}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+} // namespace data::trace
+
+#endif
@@ -0,0 +1,307 @@
+//
+//  Trace.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+//===------------------------------------------------------------------------===
+//
+// • Tracing
+//
+//      DATA_TRACE_SCOPE(name) records the cycle counter at the beginning and
+//      end of the enclosing scope into a ring buffer of the calling thread,
+//      for write_chrome_trace. Only the threads that declare
+//      DATA_TRACE_THREAD() have a buffer; the events of other threads are
+//      dropped. Built with DATA_TRACING=1 only (the CMake option
+//      FORMAT_TRACING); otherwise both compile to nothing, and the rest of
+//      this header is not declared. The allocator primitives and
+//      Vector::reserve and prepare_insert are traced, as are the ThreadPool
+//      workers
+//
+//===------------------------------------------------------------------------===
+
+#if !defined ( DATA_TRACING )
+#define DATA_TRACING 0
+#endif
+
+#define DATA_TRACE_CONCAT_(lhs_, rhs_) lhs_ ## rhs_
+#define DATA_TRACE_CONCAT(lhs_, rhs_) DATA_TRACE_CONCAT_(lhs_, rhs_)
+
+#if DATA_TRACING
+#define DATA_TRACE_SCOPE(name_) \
+    const ::data::trace::Scope DATA_TRACE_CONCAT(data_trace_scope_, __LINE__){ name_ }
+#define DATA_TRACE_THREAD() \
+    const ::data::trace::ThreadRegistration DATA_TRACE_CONCAT(data_trace_thread_, __LINE__){ }
+#else
+#define DATA_TRACE_SCOPE(name_) static_cast<void>(0)
+#define DATA_TRACE_THREAD() static_cast<void>(0)
+#endif
+
+#if DATA_TRACING
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#include <x86intrin.h>
+#elif !defined ( __aarch64__ )
+#include <chrono>
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace data::trace
+//===------------------------------------------------------------------------===
+
+namespace data::trace
+{
+
+//===------------------------------------------------------------------------===
+// • Timestamps
+//===------------------------------------------------------------------------===
+
+// • The time stamp counter where there is one, converted to time only when
+//   exported
+//
+inline uint64_t timestamp(void) noexcept
+{
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+    return __rdtsc();
+#elif defined ( __aarch64__ )
+    uint64_t ticks;
+
+    asm volatile ( "mrs %0, cntvct_el0" : "=r" (ticks) );
+
+    return ticks;
+#else
+    return static_cast<uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() );
+#endif
+}
+
+struct Event
+{
+    const char* name;       // A string literal
+    uint64_t    begin;
+    uint64_t    end;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadBuffer
+//
+//===------------------------------------------------------------------------===
+
+// • Ring of the latest events of one thread, written only by that thread and
+//   read by any. Recording never blocks or allocates; when full, the oldest
+//   events are overwritten. Each write is claimed before the slot is written,
+//   so that a snapshot can drop the events overwritten while it was copied
+//
+class ThreadBuffer
+{
+public:
+
+    enum : uint32_t
+    {
+        capacity = 1u << 14
+    };
+
+    // • Initialization
+    //
+    explicit ThreadBuffer(uint32_t thread_id) noexcept(false);
+
+private:
+
+    // • Initialization (deleted)
+    //
+    ThreadBuffer(const ThreadBuffer& ) = delete;
+    ThreadBuffer(ThreadBuffer&& ) = delete;
+    ThreadBuffer(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    ThreadBuffer& operator = (const ThreadBuffer& ) = delete;
+    ThreadBuffer& operator = (ThreadBuffer&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    uint32_t thread_id(void) const noexcept
+    {
+        return m_thread_id;
+    }
+
+    // • Events recorded, including those since overwritten
+    //
+    uint64_t recorded(void) const noexcept
+    {
+        return m_written.load(std::memory_order_acquire);
+    }
+
+    // • Methods
+    //
+    void record(const char* name, uint64_t begin, uint64_t end) noexcept
+    {
+        const auto index = m_claimed.load(std::memory_order_relaxed);
+        auto&      slot  = m_slots[ index % capacity ];
+
+        m_claimed.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+
+        m_written.store(index + 1, std::memory_order_release);
+    }
+
+    // • The events still in the ring, oldest first
+    //
+    std::vector<Event> snapshot(void) const noexcept(false);
+
+private:
+
+    // • Types (private)
+    //
+    struct Slot
+    {
+        std::atomic<const char*>    name;
+        std::atomic<uint64_t>       begin;
+        std::atomic<uint64_t>       end;
+    };
+
+    // • Data members
+    //
+    std::unique_ptr<Slot[]>     m_slots;
+    std::atomic<uint64_t>       m_claimed;
+    std::atomic<uint64_t>       m_written;
+    uint32_t                    m_thread_id;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadRegistration
+//
+//===------------------------------------------------------------------------===
+
+// • Gives the calling thread a buffer for as long as it lives, which is when
+//   the buffer is allocated and registered for export. The buffer and its
+//   events are released by the destructor, usually as the thread exits. A
+//   thread already registered keeps its buffer, and one whose buffer cannot
+//   be allocated is not traced
+//
+class ThreadRegistration
+{
+public:
+
+    // • Initialization
+    //
+    ThreadRegistration(void) noexcept;
+
+    ~ThreadRegistration(void) noexcept;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    ThreadRegistration(const ThreadRegistration& ) = delete;
+    ThreadRegistration(ThreadRegistration&& ) = delete;
+
+    // • Assignment (deleted)
+    //
+    ThreadRegistration& operator = (const ThreadRegistration& ) = delete;
+    ThreadRegistration& operator = (ThreadRegistration&& ) = delete;
+
+private:
+
+    // • Data members
+    //
+    std::shared_ptr<ThreadBuffer>   m_buffer;
+};
+
+// • The buffer of the calling thread, or nullptr if it is not registered.
+//   Never blocks or allocates
+//
+ThreadBuffer* thread_buffer(void) noexcept;
+
+//===------------------------------------------------------------------------===
+//
+// • Scope
+//
+//===------------------------------------------------------------------------===
+
+class Scope
+{
+public:
+
+    // • Initialization
+    //
+    explicit Scope(const char* name) noexcept
+        :
+            m_buffer{ thread_buffer() },
+            m_name  { name            },
+            m_begin { m_buffer ? timestamp() : 0 }
+    {
+    }
+
+    ~Scope(void) noexcept
+    {
+        if ( m_buffer ) {
+            m_buffer->record( m_name, m_begin, timestamp() );
+        }
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    Scope(const Scope& ) = delete;
+    Scope(Scope&& ) = delete;
+    Scope(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    Scope& operator = (const Scope& ) = delete;
+    Scope& operator = (Scope&& ) = delete;
+
+private:
+
+    // • Data members
+    //
+    ThreadBuffer*   m_buffer;
+    const char*     m_name;
+    uint64_t        m_begin;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • Export
+//
+//===------------------------------------------------------------------------===
+
+// • The events of every registered thread as Chrome trace event JSON, as
+//   complete ('X') events in microseconds, which chrome://tracing and
+//   Perfetto both open. Threads may keep recording while this runs
+//
+void write_chrome_trace(std::ostream& stream) noexcept(false);
+
+} // namespace data::trace
+
+#endif
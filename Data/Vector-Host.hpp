@@ -21,8 +21,11 @@
 
 #include <Data/VectorRef.hpp>
 #include <Data/Allocation.hpp>
+#include <Data/Mutator.hpp>
+#include <Data/Trace.hpp>
 
 #include <algorithm>
+#include <span>
 
 //===------------------------------------------------------------------------===
 // • namespace data
@@ -64,26 +67,35 @@ constexpr bool is_null(const VectorRef<Type_>& ref) noexcept
 // • Vector header offset
 //===------------------------------------------------------------------------===
 
+// • Whether ref is empty or names a 'vctr' atom large enough for its count
+//
 template <TrivialLayout Type_>
-Atom* allocation_header(const VectorRef<Type_>& ref, Atom* data) noexcept(false)
+bool is_valid_allocation(const VectorRef<Type_>& ref, const Atom* data) noexcept
 {
-    if ( !is_aligned(ref.offset) || ref.offset < 2*atom_header_length )
-    {
-        assert( false );
-        throw false;
+    if ( is_null(ref) ) {
+        return empty(ref);
     }
 
-    auto allocation_offset = ref.offset - atom_header_length;
-    auto allocation        = detail::offset_by(data, allocation_offset);
+    if ( !is_aligned(ref.offset) || ref.offset < 2*atom_header_length ) {
+        return false;
+    }
+
+    auto allocation = offset_by(data, ref.offset - atom_header_length);
+
+    return AtomID::vector == allocation->identifier
+        && atom_header_length + uint64_t{ ref.count } * sizeof(Type_) <= allocation->length;
+}
 
-    if ( AtomID::vector != allocation->identifier
-        || allocation->length < atom_header_length + ref.count*sizeof(Type_) )
+template <TrivialLayout Type_>
+Atom* allocation_header(const VectorRef<Type_>& ref, Atom* data) noexcept(false)
+{
+    if ( is_null(ref) || !is_valid_allocation(ref, data) )
     {
         assert( false );
         throw false;
     }
 
-    return allocation;
+    return detail::offset_by(data, ref.offset - atom_header_length);
 }
 
 } // namespace detail
@@ -131,9 +143,10 @@ public:
     //
     Vector(vector_ref& ref, Atom* data) noexcept(false)
         :
-            m_ref { ref     },
-            m_data{ data    },
-            m_vctr{ nullptr }
+            m_ref    { ref     },
+            m_data   { data    },
+            m_vctr   { nullptr },
+            m_mutator{ nullptr }
     {
         if ( !detail::is_null(m_ref) )
         {
@@ -145,6 +158,15 @@ public:
         }
     }
 
+    // • Initialization : observed mutations
+    //
+    Vector(vector_ref& ref, Mutator& mutator) noexcept(false)
+        :
+            Vector{ ref, mutator.data() }
+    {
+        m_mutator = &mutator;
+    }
+
 private:
 
     // • Initialization (deleted)
@@ -332,47 +354,73 @@ public:
             return;
         }
 
+        DATA_TRACE_SCOPE("Vector::reserve");
+
         const auto contents_size = static_cast<uint32_t>( sizeof(value_type) * capacity );
 
-        m_vctr = ( nullptr == m_vctr )
-            ? detail::reserve(m_data, contents_size, AtomID::vector)
-            : detail::reserve(m_data, m_vctr, contents_size);
+        if ( nullptr != m_mutator )
+        {
+            m_vctr = ( nullptr == m_vctr )
+                ? m_mutator->reserve(contents_size, AtomID::vector)
+                : m_mutator->reserve(m_vctr, contents_size);
+        }
+        else
+        {
+            m_vctr = ( nullptr == m_vctr )
+                ? detail::reserve(m_data, contents_size, AtomID::vector)
+                : detail::reserve(m_data, m_vctr, contents_size);
+        }
 
         m_ref.offset = detail::contents_offset(m_data, m_vctr);
+
+        did_update();
     }
 
     // * Methods : container
     //
-    void clear(void) noexcept
+    //      With a Mutator, even the methods that only shrink the vector notify
+    //      its observers, which may throw. Without one, clear, erase and
+    //      pop_back never throw
+    //
+    void clear(void) noexcept(false)
     {
         m_ref.count = 0;
+
+        did_update();
     }
 
-    void shrink_to_fit(void) noexcept
+    void shrink_to_fit(void) noexcept(false)
     {
-        assert( false ); // TODO: Remove once this path has been tested
-
         if ( empty() && nullptr != m_vctr )
         {
-            assert( false ); // TODO: Remove once this path has been tested
-
-            detail::free(m_vctr);
+            if ( nullptr != m_mutator )
+            {
+                m_mutator->free(m_vctr);
+            }
+            else
+            {
+                detail::free(m_vctr);
+            }
 
             m_vctr       = nullptr;
             m_ref.offset = 0;
+
+            did_update();
         }
         else if ( size() < capacity() )
         {
-            assert( false ); // TODO: Remove once this path has been tested
-
-            const auto contents_size = static_cast<uint32_t>( sizeof(value_type) * m_ref->count );
+            const auto contents_size = static_cast<uint32_t>( sizeof(value_type) * m_ref.count );
 
-            m_vctr       = detail::reserve(m_data, m_vctr, contents_size);
+            m_vctr       = ( nullptr != m_mutator )
+                ? m_mutator->reserve(m_vctr, contents_size)
+                : detail::reserve(m_data, m_vctr, contents_size);
             m_ref.offset = detail::contents_offset(m_data, m_vctr);
+
+            did_update();
         }
     }
 
-    iterator erase(const_iterator begin_pos, const_iterator end_pos) noexcept
+    iterator erase(const_iterator begin_pos, const_iterator end_pos) noexcept(false)
     {
         assert( cbegin() <= begin_pos && begin_pos <= end_pos && end_pos <= cend() );
 
@@ -392,10 +440,13 @@ public:
 
         m_ref.count -= erase_count;
 
+        did_write(destIt, end());
+        did_update();
+
         return destIt;
     }
 
-    iterator erase(const_iterator pos) noexcept
+    iterator erase(const_iterator pos) noexcept(false)
     {
         if ( pos == cend() )
         {
@@ -416,13 +467,51 @@ public:
         }
 
         data()[m_ref.count++] = value;
+
+        did_write(std::prev(end()), end());
+        did_update();
     }
 
-    void pop_back(void) noexcept
+    void pop_back(void) noexcept(false)
     {
         assert( !empty() );
 
         --m_ref.count;
+
+        did_update();
+    }
+
+    // • Methods : container, uninitialized
+    //
+    //      The returned elements are left as they were in the buffer for the
+    //      caller to write directly, and only valid until the next reservation.
+    //      Writes to an observed vector are reported with Mutator::write
+    //
+    std::span<value_type> append_uninitialized(size_type count) noexcept(false)
+    {
+        assert( count <= max_size() && size() <= max_size() - count );
+
+        const auto append_offset = size();
+
+        resize_for_overwrite(size() + count);
+
+        return { data() + append_offset, count };
+    }
+
+    std::span<value_type> resize_for_overwrite(size_type count) noexcept(false)
+    {
+        assert( count <= max_size() );
+
+        if ( capacity() < count )
+        {
+            reserve(count);
+        }
+
+        m_ref.count = count;
+
+        did_update();
+
+        return { data(), size() };
     }
 
     // • Assignment
@@ -435,7 +524,7 @@ public:
 
         if ( begin < end )
         {
-            const auto new_count = static_cast<difference_type>( std::distance(begin, end) );
+            const auto new_count = static_cast<size_type>( std::distance(begin, end) );
 
             if ( capacity() < new_count )
             {
@@ -445,6 +534,9 @@ public:
             std::copy( begin, end, data() );
 
             m_ref.count = new_count;
+
+            did_write(this->begin(), this->end());
+            did_update();
         }
         else
         {
@@ -463,6 +555,8 @@ private:
     //
     iterator prepare_insert(const_iterator pos, size_type insert_count) noexcept(false)
     {
+        DATA_TRACE_SCOPE("Vector::prepare_insert");
+
         assert( 0 < insert_count );
 
         const auto insert_offset = std::distance( cbegin(), pos );
@@ -485,6 +579,24 @@ private:
         return destIt;
     }
 
+    void did_write(const_iterator first, const_iterator last) noexcept(false)
+    {
+        if ( nullptr != m_mutator )
+        {
+            const auto length = static_cast<uint32_t>( sizeof(value_type) * std::distance(first, last) );
+
+            m_mutator->write(first, length);
+        }
+    }
+
+    void did_update(void) noexcept(false)
+    {
+        if ( nullptr != m_mutator )
+        {
+            m_mutator->update(m_ref);
+        }
+    }
+
 public:
 
     // • Insertion
@@ -505,6 +617,9 @@ public:
 
             std::fill_n( destIt, count, value );
 
+            did_write(destIt, end());
+            did_update();
+
             return destIt;
         }
     }
@@ -535,6 +650,9 @@ public:
 
             std::copy( begin, end, destIt );
 
+            did_write(destIt, this->end());
+            did_update();
+
             return destIt;
         }
     }
@@ -551,6 +669,7 @@ private:
     vector_ref& m_ref;
     Atom*       m_data;
     Atom*       m_vctr;
+    Mutator*    m_mutator;
 };
 
 //===------------------------------------------------------------------------===
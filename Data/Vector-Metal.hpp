@@ -46,10 +46,14 @@ device Type_* contents(VectorRef<Type_> ref, device uint8_t* base)
     return reinterpret_cast<device Type_*>(base + ref.offset);
 }
 
+#if !defined ( DATA_METAL_EMULATION )
+
 template <TRIVIAL_LAYOUT Type_>
 constant Type_* contents(VectorRef<Type_> ref, constant uint8_t* base)
 {
     return reinterpret_cast<constant Type_*>(base + ref.offset);
 }
 
+#endif
+
 } // namespace data
@@ -0,0 +1,158 @@
+//
+//  VectorView.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Vector-Host.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • VectorView
+//
+//===------------------------------------------------------------------------===
+
+// • Read-only view of the contents of a VectorRef, as contents(ref, base) on
+//   Metal. Nothing is checked in release builds, so it costs no more than the
+//   pointer arithmetic, and only stays valid until the vector is reserved or
+//   freed. Use Vector to modify the contents or to validate untrusted buffers
+//
+template <TrivialLayout Type_>
+class VectorView
+{
+public:
+
+    // • Types
+    //
+    using vector_ref      = VectorRef<Type_>;
+    using value_type      = Type_;
+    using size_type       = uint32_t;
+    using difference_type = int32_t;
+    using const_reference = const value_type&;
+    using const_pointer   = const Type_*;
+    using const_iterator  = const_pointer;
+
+public:
+
+    // • Initialization
+    //
+    VectorView(const vector_ref& ref, const Atom* data) noexcept
+        :
+            m_contents{ detail::offset_by<value_type>(data, ref.offset) },
+            m_count   { ref.count }
+    {
+        assert( detail::is_valid_allocation(ref, data) );
+    }
+
+    //      The base is the address of the 'data' atom, as given to Metal
+    //
+    VectorView(const vector_ref& ref, const uint8_t* base) noexcept
+        :
+            VectorView{ ref, reinterpret_cast<const Atom*>(base) }
+    {
+    }
+
+    VectorView(const VectorView& ) noexcept = default;
+    VectorView& operator = (const VectorView& ) noexcept = default;
+
+private:
+
+    // • Initialization (deleted)
+    //
+    VectorView(void) = delete;
+
+public:
+
+    // • Accessors : capacity
+    //
+    size_type size(void) const noexcept
+    {
+        return m_count;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return 0 == m_count;
+    }
+
+    // • Accessors : iterators
+    //
+    const_iterator begin(void) const noexcept
+    {
+        return m_contents;
+    }
+
+    const_iterator end(void) const noexcept
+    {
+        return m_contents + m_count;
+    }
+
+    // • Accessors : elements
+    //
+    const_reference operator [] (size_type index) const noexcept
+    {
+        assert( index < m_count );
+
+        return m_contents[index];
+    }
+
+    const_reference front(void) const noexcept
+    {
+        assert( !empty() );
+
+        return m_contents[0];
+    }
+
+    const_reference back(void) const noexcept
+    {
+        assert( !empty() );
+
+        return m_contents[m_count - 1];
+    }
+
+    const_pointer data(void) const noexcept
+    {
+        return m_contents;
+    }
+
+    std::span<const value_type> span(void) const noexcept
+    {
+        return { m_contents, m_count };
+    }
+
+    operator std::span<const value_type> (void) const noexcept
+    {
+        return span();
+    }
+
+private:
+
+    // • Data members
+    //
+    const_pointer   m_contents;
+    size_type       m_count;
+};
+
+} // namespace data
@@ -0,0 +1,332 @@
+//
+//  SchemaFile.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <InspectFormat/SchemaFile.hpp>
+
+#include <limits>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+namespace
+{
+
+//===------------------------------------------------------------------------===
+//
+// • JsonReader
+//
+//===------------------------------------------------------------------------===
+
+// • Just enough JSON for a schema file: objects, arrays, strings without
+//   escapes other than \" and \\, unsigned integers, and skipping anything
+//   else that is well formed. Objects and arrays nest at most max_depth deep,
+//   so that a hostile file cannot exhaust the stack
+//
+class JsonReader
+{
+public:
+
+    enum : uint32_t
+    {
+        max_depth = 64
+    };
+
+    // • Initialization
+    //
+    explicit JsonReader(std::string_view json) noexcept
+        :
+            m_json    { json },
+            m_position{ 0 },
+            m_depth   { 0 }
+    {
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    JsonReader(const JsonReader& ) = delete;
+    JsonReader(JsonReader&& ) = delete;
+    JsonReader(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    JsonReader& operator = (const JsonReader& ) = delete;
+    JsonReader& operator = (JsonReader&& ) = delete;
+
+public:
+
+    // • Methods
+    //
+    char peek(void) noexcept
+    {
+        skip_space();
+
+        return m_position < m_json.size() ? m_json[m_position] : '\0';
+    }
+
+    void expect(char c) noexcept(false)
+    {
+        if ( c != peek() ) {
+            throw false;
+        }
+
+        ++m_position;
+    }
+
+    bool consume(char c) noexcept
+    {
+        if ( c != peek() ) {
+            return false;
+        }
+
+        ++m_position;
+
+        return true;
+    }
+
+    void expect_end(void) noexcept(false)
+    {
+        if ( '\0' != peek() || m_position != m_json.size() ) {
+            throw false;
+        }
+    }
+
+    std::string read_string(void) noexcept(false)
+    {
+        expect('"');
+
+        auto string = std::string{ };
+
+        for ( ; m_position < m_json.size() && '"' != m_json[m_position]; ++m_position )
+        {
+            if ( '\\' == m_json[m_position] )
+            {
+                if ( ++m_position == m_json.size() || ( '"' != m_json[m_position] && '\\' != m_json[m_position] ) ) {
+                    throw false;
+                }
+            }
+
+            string.push_back( m_json[m_position] );
+        }
+
+        expect('"');
+
+        return string;
+    }
+
+    uint32_t read_uint32(void) noexcept(false)
+    {
+        skip_space();
+
+        auto value  = uint64_t{ 0 };
+        auto digits = 0;
+
+        for ( ; m_position < m_json.size() && '0' <= m_json[m_position] && m_json[m_position] <= '9'; ++m_position, ++digits )
+        {
+            value = 10 * value + uint64_t( m_json[m_position] - '0' );
+
+            if ( std::numeric_limits<uint32_t>::max() < value ) {
+                throw false;
+            }
+        }
+
+        if ( 0 == digits ) {
+            throw false;
+        }
+
+        return static_cast<uint32_t>(value);
+    }
+
+    // • Calls member(key) for each member of an object, which reads the value
+    //
+    template <class Function_>
+    void read_object(Function_&& member) noexcept(false)
+    {
+        expect('{');
+        enter();
+
+        if ( !consume('}') )
+        {
+            do
+            {
+                auto key = read_string();
+
+                expect(':');
+                member(key);
+            }
+            while ( consume(',') );
+
+            expect('}');
+        }
+
+        leave();
+    }
+
+    template <class Function_>
+    void read_array(Function_&& element) noexcept(false)
+    {
+        expect('[');
+        enter();
+
+        if ( !consume(']') )
+        {
+            do
+            {
+                element();
+            }
+            while ( consume(',') );
+
+            expect(']');
+        }
+
+        leave();
+    }
+
+    void skip_value(void) noexcept(false)
+    {
+        switch ( peek() )
+        {
+            case '{':   read_object([this](const std::string& ) { skip_value(); }); break;
+            case '[':   read_array([this] { skip_value(); }); break;
+            case '"':   read_string(); break;
+
+            default:
+            {
+                // • Numbers, true, false and null
+                //
+                const auto begin = m_position;
+
+                while ( m_position < m_json.size() && std::string_view{ "+-.0123456789Eaeflnrstu" }.find(m_json[m_position]) != std::string_view::npos ) {
+                    ++m_position;
+                }
+
+                if ( begin == m_position ) {
+                    throw false;
+                }
+            }
+        }
+    }
+
+private:
+
+    // • Utilities (private)
+    //
+    void enter(void) noexcept(false)
+    {
+        if ( max_depth <= m_depth ) {
+            throw false;
+        }
+
+        ++m_depth;
+    }
+
+    void leave(void) noexcept
+    {
+        --m_depth;
+    }
+
+    void skip_space(void) noexcept
+    {
+        while ( m_position < m_json.size() && std::string_view{ " \t\r\n" }.find(m_json[m_position]) != std::string_view::npos ) {
+            ++m_position;
+        }
+    }
+
+private:
+
+    // • Data members
+    //
+    std::string_view    m_json;
+    size_t              m_position;
+    uint32_t            m_depth;
+};
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+//
+// • Schema file
+//
+//===------------------------------------------------------------------------===
+
+SchemaFile read_schema_file(std::string_view json) noexcept(false)
+{
+    auto reader = JsonReader{ json };
+    auto schema = SchemaFile{ };
+
+    reader.read_object([&](const std::string& key) {
+
+        if ( "root" == key ) {
+            schema.root = reader.read_string();
+        }
+        else if ( "vectors" == key )
+        {
+            reader.read_array([&] {
+
+                auto vector       = NamedVectorField{
+                    .name  = { },
+                    .field = { .offset = 0, .element_size = 0, .alignment = 4 }
+                };
+                auto has_offset   = false;
+                auto has_size     = false;
+
+                reader.read_object([&](const std::string& member) {
+
+                    if ( "name" == member ) {
+                        vector.name = reader.read_string();
+                    }
+                    else if ( "offset" == member ) {
+                        vector.field.offset = reader.read_uint32();
+                        has_offset          = true;
+                    }
+                    else if ( "element_size" == member ) {
+                        vector.field.element_size = reader.read_uint32();
+                        has_size                  = true;
+                    }
+                    else if ( "alignment" == member ) {
+                        vector.field.alignment = reader.read_uint32();
+                    }
+                    else {
+                        reader.skip_value();
+                    }
+                });
+
+                if ( !has_offset || !has_size || 0 == vector.field.element_size ) {
+                    throw false;
+                }
+
+                schema.vectors.push_back( std::move(vector) );
+            });
+        }
+        else {
+            reader.skip_value();
+        }
+    });
+
+    reader.expect_end();
+
+    return schema;
+}
+
+} // namespace data
@@ -0,0 +1,69 @@
+//
+//  SchemaFile.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Schema.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Schema file
+//
+//      The VectorRef fields of a root, as JSON, for buffers inspected without
+//      the root type:
+//
+//          {
+//              "root": "SceneData",
+//              "vectors": [
+//                  { "name": "positions", "offset": 0, "element_size": 12, "alignment": 4 },
+//                  { "name": "faces.offsets", "offset": 8, "element_size": 4 }
+//              ]
+//          }
+//
+//      offset is from the beginning of the root, as in vector_fields, and
+//      alignment defaults to 4. Other members are ignored
+//
+//===------------------------------------------------------------------------===
+
+struct NamedVectorField
+{
+    std::string name;
+    VectorField field;
+};
+
+struct SchemaFile
+{
+    std::string                     root;
+    std::vector<NamedVectorField>   vectors;
+};
+
+SchemaFile read_schema_file(std::string_view json) noexcept(false);
+
+} // namespace data
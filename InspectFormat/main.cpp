@@ -0,0 +1,364 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Inspect.hpp>
+#include <InspectFormat/SchemaFile.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • InspectFormat
+//
+//      InspectFormat [--schema schema.json] [--cells count] [--max-atoms count] buffer
+//
+//      Validates a formatted buffer dumped to a file, and prints its atoms,
+//      its free space and, with a schema file of the root, the vectors that
+//      hold more than their count. Exits with 1 for an invalid buffer
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+//===------------------------------------------------------------------------===
+// • MappedFile
+//===------------------------------------------------------------------------===
+
+class MappedFile
+{
+public:
+
+    // • Initialization
+    //
+    explicit MappedFile(const char* path) noexcept(false)
+    {
+        const auto file = ::open(path, O_RDONLY);
+
+        if ( file < 0 ) {
+            throw false;
+        }
+
+        struct stat status;
+
+        if (   0 != ::fstat(file, &status)
+            || status.st_size <= 0
+            || std::numeric_limits<uint32_t>::max() < uint64_t(status.st_size) )
+        {
+            ::close(file);
+            throw false;
+        }
+
+        m_length   = static_cast<uint32_t>(status.st_size);
+        m_contents = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, file, 0);
+
+        ::close(file);
+
+        if ( MAP_FAILED == m_contents ) {
+            throw false;
+        }
+    }
+
+    ~MappedFile(void) noexcept
+    {
+        ::munmap(m_contents, m_length);
+    }
+
+private:
+
+    // • Initialization (deleted)
+    //
+    MappedFile(const MappedFile& ) = delete;
+    MappedFile(MappedFile&& ) = delete;
+    MappedFile(void) = delete;
+
+    // • Assignment (deleted)
+    //
+    MappedFile& operator = (const MappedFile& ) = delete;
+    MappedFile& operator = (MappedFile&& ) = delete;
+
+public:
+
+    // • Accessors
+    //
+    const void* contents(void) const noexcept
+    {
+        return m_contents;
+    }
+
+    uint32_t length(void) const noexcept
+    {
+        return m_length;
+    }
+
+private:
+
+    // • Data members
+    //
+    void*       m_contents;
+    uint32_t    m_length;
+};
+
+//===------------------------------------------------------------------------===
+// • Reports
+//===------------------------------------------------------------------------===
+
+std::string identifier_name(AtomID identifier)
+{
+    auto name = std::string( 4, ' ' );
+
+    for ( auto index = 0; index < 4; ++index )
+    {
+        const auto c = char( uint32_t(identifier) >> ( 8 * ( 3 - index ) ) );
+
+        name[index] = ( ' ' <= c && c <= '~' ) ? c : '?';
+    }
+
+    return name;
+}
+
+void print_atoms( const std::vector<AtomEntry>& chain, const std::optional<LayoutFault>& fault,
+                  uint32_t max_atoms )
+{
+    std::printf( "\natoms:\n    %-10s  %-6s  %10s  %10s\n", "offset", "id", "length", "previous" );
+
+    for ( auto index = size_t{ 0 }; index < chain.size(); ++index )
+    {
+        const auto& atom     = chain[index];
+        const auto  is_fault = fault && fault->offset == atom.offset;
+
+        // • Elide the middle of long chains, but never the faulting atom
+        //
+        if ( 0 < max_atoms && max_atoms / 2 <= index && index + max_atoms / 2 < chain.size() && !is_fault )
+        {
+            if ( max_atoms / 2 == index ) {
+                std::printf( "    ...\n" );
+            }
+
+            continue;
+        }
+
+        std::printf( "    0x%08x  '%s'  %10u  %10u%s%s\n",
+                     atom.offset, identifier_name(atom.identifier).c_str(), atom.length, atom.previous,
+                     is_fault ? "  <-- " : "", is_fault ? fault->reason : "" );
+    }
+}
+
+void print_free_space(const MappedFile& file, uint32_t cell_count)
+{
+    const auto free = free_space( file.contents(), file.length() );
+
+    std::printf( "\nfree space: %u atoms, %llu bytes (%.1f%%), largest %u, fragmentation %.3f\n",
+                 free.free_count, static_cast<unsigned long long>(free.free_length),
+                 100.0 * double(free.free_length) / double(file.length()),
+                 free.largest_free, free.fragmentation() );
+
+    const auto largest_count = *std::max_element( free.histogram.begin(), free.histogram.end() );
+
+    for ( auto bucket = size_t{ 0 }; bucket < free.histogram.size(); ++bucket )
+    {
+        if ( 0 == free.histogram[bucket] ) {
+            continue;
+        }
+
+        const auto bar = std::string( ( 40 * free.histogram[bucket] + largest_count - 1 ) / largest_count, '#' );
+
+        std::printf( "    [2^%-2zu, 2^%-2zu)  %8u  %s\n", bucket, bucket + 1, free.histogram[bucket], bar.c_str() );
+    }
+
+    const auto map   = occupancy_map( file.contents(), file.length(), cell_count );
+    const auto width = size_t{ 64 };
+
+    std::printf( "\noccupancy: %u bytes per cell, '#' used, ':' in part free, '.' free\n",
+                 static_cast<uint32_t>( ( uint64_t{ file.length() } + map.size() - 1 ) / map.size() ) );
+
+    for ( auto line = size_t{ 0 }; line < map.size(); line += width ) {
+        std::printf( "    %s\n", map.substr(line, width).c_str() );
+    }
+}
+
+void print_vector_usage(const MappedFile& file, const SchemaFile& schema)
+{
+    auto fields = std::vector<VectorField>{ };
+
+    for ( const auto& vector : schema.vectors ) {
+        fields.push_back(vector.field);
+    }
+
+    const auto usage = vector_usage( file.contents(), file.length(), fields );
+
+    // • Most reclaimable first, with invalid references after
+    //
+    auto order = std::vector<size_t>( usage.size() );
+
+    for ( auto index = size_t{ 0 }; index < order.size(); ++index ) {
+        order[index] = index;
+    }
+
+    std::stable_sort( order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        if ( usage[lhs].is_valid != usage[rhs].is_valid ) {
+            return usage[lhs].is_valid;
+        }
+
+        return usage[rhs].reclaimable() < usage[lhs].reclaimable();
+    });
+
+    std::printf( "\nvectors of %s:\n    %-24s  %10s  %10s  %10s  %11s\n",
+                 schema.root.empty() ? "the root" : schema.root.c_str(),
+                 "name", "count", "used", "allocated", "reclaimable" );
+
+    auto reclaimable = uint64_t{ 0 };
+
+    for ( auto index : order )
+    {
+        const auto& entry = usage[index];
+        const auto& name  = schema.vectors[index].name;
+
+        reclaimable += entry.reclaimable();
+
+        if ( entry.is_valid && 0 == entry.reclaimable() ) {
+            continue;
+        }
+
+        if ( entry.is_valid ) {
+            std::printf( "    %-24s  %10u  %10u  %10u  %11u\n",
+                         name.c_str(), entry.count, entry.used_length, entry.allocated_length, entry.reclaimable() );
+        }
+        else {
+            std::printf( "    %-24s  %10u  invalid reference\n", name.c_str(), entry.count );
+        }
+    }
+
+    std::printf( "    %llu bytes reclaimable\n", static_cast<unsigned long long>(reclaimable) );
+}
+
+int usage(void)
+{
+    std::fprintf( stderr, "usage: InspectFormat [--schema schema.json] [--cells count] [--max-atoms count] buffer\n" );
+
+    return 2;
+}
+
+} // namespace
+
+//===------------------------------------------------------------------------===
+// • main
+//===------------------------------------------------------------------------===
+
+int main(int argc, const char* argv[])
+{
+    auto buffer_path = static_cast<const char*>(nullptr);
+    auto schema_path = static_cast<const char*>(nullptr);
+    auto cell_count  = uint32_t{ 1024 };
+    auto max_atoms   = uint32_t{ 0 };
+
+    for ( auto index = 1; index < argc; ++index )
+    {
+        const auto has_value = index + 1 < argc;
+
+        if ( 0 == std::strcmp(argv[index], "--schema") && has_value ) {
+            schema_path = argv[++index];
+        }
+        else if ( 0 == std::strcmp(argv[index], "--cells") && has_value ) {
+            cell_count = static_cast<uint32_t>( std::strtoul(argv[++index], nullptr, 10) );
+        }
+        else if ( 0 == std::strcmp(argv[index], "--max-atoms") && has_value ) {
+            max_atoms = static_cast<uint32_t>( std::strtoul(argv[++index], nullptr, 10) );
+        }
+        else if ( '-' != argv[index][0] && nullptr == buffer_path ) {
+            buffer_path = argv[index];
+        }
+        else {
+            return usage();
+        }
+    }
+
+    if ( nullptr == buffer_path || 0 == cell_count ) {
+        return usage();
+    }
+
+    auto schema = SchemaFile{ };
+
+    if ( nullptr != schema_path )
+    {
+        auto stream = std::ifstream{ schema_path };
+        auto json   = std::stringstream{ };
+
+        json << stream.rdbuf();
+
+        try
+        {
+            schema = read_schema_file( json.str() );
+        }
+        catch ( ... )
+        {
+            std::fprintf( stderr, "%s: not a readable schema file\n", schema_path );
+            return 2;
+        }
+    }
+
+    try
+    {
+        const auto file  = MappedFile{ buffer_path };
+        const auto fault = diagnose_layout( file.contents(), file.length() );
+
+        std::printf( "%s: %u bytes\n", buffer_path, file.length() );
+
+        if ( fault ) {
+            std::printf( "layout: invalid at offset 0x%08x, %s\n", fault->offset, fault->reason );
+        }
+        else {
+            std::printf( "layout: valid\n" );
+        }
+
+        if ( valid_alignment_and_length( file.contents(), file.length() ) ) {
+            print_atoms( atom_chain( file.contents(), file.length() ), fault, max_atoms );
+        }
+
+        if ( fault ) {
+            return 1;
+        }
+
+        print_free_space( file, cell_count );
+
+        if ( nullptr != schema_path ) {
+            print_vector_usage( file, schema );
+        }
+    }
+    catch ( ... )
+    {
+        std::fprintf( stderr, "%s: could not be read\n", buffer_path );
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+//
+//  TestAlgorithm.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Algorithm.hpp>
+
+#include <numeric>
+#include <random>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Algorithm tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+template <Arithmetic Type_>
+class algorithm : public ::testing::Test
+{
+protected:
+
+    // • Sizes around each vector width, with tails
+    //
+    static constexpr auto sizes = std::array<uint32_t, 9>{ 1, 3, 15, 16, 17, 63, 64, 65, 1031 };
+
+    static std::vector<Type_> make_values(uint32_t count, uint32_t seed)
+    {
+        auto engine = std::mt19937{ seed };
+        auto values = std::vector<Type_>( count );
+
+        // • A small range, so there are repeated and matching values
+        //
+        for ( auto& value : values ) {
+            value = static_cast<Type_>( engine() % 100 );
+        }
+
+        return values;
+    }
+};
+
+using ArithmeticTypes = ::testing::Types< int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
+                                          int64_t, uint64_t, float, double >;
+
+} // namespace
+
+TYPED_TEST_SUITE( algorithm, ArithmeticTypes );
+
+TYPED_TEST( algorithm, search )
+{
+    for ( auto size : TestFixture::sizes )
+    {
+        const auto values = TestFixture::make_values(size, size);
+        const auto value  = values[size / 2];
+
+        EXPECT_EQ( data::find(values, value), std::distance( values.begin(), std::find(values.begin(), values.end(), value) ) );
+        EXPECT_EQ( data::find(values, TypeParam(101)), size );
+        EXPECT_EQ( data::count(values, value), std::count(values.begin(), values.end(), value) );
+
+        EXPECT_EQ( data::count_if(values, Compare::less, value),
+                   std::count_if(values.begin(), values.end(), [=](auto v) { return v < value; }) );
+        EXPECT_EQ( data::count_if(values, Compare::greater_equal, value),
+                   std::count_if(values.begin(), values.end(), [=](auto v) { return v >= value; }) );
+        EXPECT_EQ( data::count_if(values, Compare::not_equal, value),
+                   std::count_if(values.begin(), values.end(), [=](auto v) { return v != value; }) );
+    }
+
+    // • Counts beyond the range of the narrowest lanes
+    //
+    const auto values = std::vector<TypeParam>( 70000, TypeParam(7) );
+
+    EXPECT_EQ( data::count(values, TypeParam(7)), 70000 );
+}
+
+TYPED_TEST( algorithm, reduction )
+{
+    for ( auto size : TestFixture::sizes )
+    {
+        const auto values = TestFixture::make_values(size, size + 1);
+
+        EXPECT_EQ( data::min(values), *std::min_element(values.begin(), values.end()) );
+        EXPECT_EQ( data::max(values), *std::max_element(values.begin(), values.end()) );
+        EXPECT_EQ( data::argmin(values), std::distance( values.begin(), std::min_element(values.begin(), values.end()) ) );
+        EXPECT_EQ( data::argmax(values), std::distance( values.begin(), std::max_element(values.begin(), values.end()) ) );
+
+        // • Small integer values, so floating point sums are exact
+        //
+        EXPECT_EQ( data::sum(values), std::accumulate(values.begin(), values.end(), sum_type<TypeParam>{ 0 }) );
+    }
+}
+
+TYPED_TEST( algorithm, fill_and_compare )
+{
+    for ( auto size : TestFixture::sizes )
+    {
+        auto lhs = TestFixture::make_values(size, size + 2);
+        auto rhs = lhs;
+
+        EXPECT_TRUE( data::equal(lhs, rhs) );
+        EXPECT_EQ( data::mismatch(lhs, rhs), size );
+
+        rhs[size - 1] = TypeParam(101);
+
+        EXPECT_FALSE( data::equal(lhs, rhs) );
+        EXPECT_EQ( data::mismatch(lhs, rhs), size - 1 );
+
+        data::fill( lhs, TypeParam(42) );
+
+        EXPECT_EQ( std::count(lhs.begin(), lhs.end(), TypeParam(42)), size );
+    }
+}
+
+TYPED_TEST( algorithm, copy_if )
+{
+    for ( auto size : TestFixture::sizes )
+    {
+        const auto values = TestFixture::make_values(size, size + 3);
+        const auto value  = TypeParam(50);
+
+        auto expected = std::vector<TypeParam>{ };
+        auto copied   = std::vector<TypeParam>( size );
+
+        std::copy_if( values.begin(), values.end(), std::back_inserter(expected), [=](auto v) { return v > value; } );
+
+        copied.resize( data::copy_if(values, Compare::greater, value, copied.data()) );
+
+        EXPECT_EQ( copied, expected );
+    }
+}
+
+TEST( algorithm, vector_contents )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto data            = data::format(contents.get(), contents_length);
+
+        auto ref    = VectorRef<int32_t>{ };
+        auto vector = Vector<int32_t>{ ref, data };
+
+        ASSERT_NO_THROW( vector.assign({ 5, 3, 9, -2, 7, 3, 11, 3, 0, 4, 3, 8, 1, 6, 2, 10, 3 }) );
+
+        EXPECT_EQ( data::min(vector), -2 );
+        EXPECT_EQ( data::argmax(vector), 6 );
+        EXPECT_EQ( data::count(vector, 3), 5 );
+        EXPECT_EQ( data::sum(contents_of(ref, data)), 76 );
+
+        auto filtered_ref = VectorRef<int32_t>{ };
+        auto filtered     = Vector<int32_t>{ filtered_ref, data };
+
+        EXPECT_EQ( data::copy_if(vector, Compare::less, 3, filtered), 4 );
+        EXPECT_THAT( filtered, ElementsAre(-2, 0, 1, 2) );
+
+        data::fill( vector, 1 );
+
+        EXPECT_EQ( data::count(vector, 1), vector.size() );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
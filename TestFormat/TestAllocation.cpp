@@ -167,6 +167,69 @@ TEST( allocation, reallocation )
         EXPECT_EQ( detail::contents_size(realloc1), 128 );
 
         EXPECT_EQ( alloc1->identifier, AtomID::free );
+
+        // • Reallocation into exactly the free region that follows, leaving none
+        //
+        auto alloc3 = detail::reserve(data, 32, AtomID::vector);
+
+        EXPECT_EQ( detail::distance(data, alloc3), 16 );
+
+        auto realloc3 = detail::reserve(data, alloc3, 48);
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        EXPECT_EQ( realloc3, alloc3 );
+        EXPECT_EQ( realloc3->length, 64 );
+        EXPECT_EQ( detail::next(realloc3), alloc2 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( allocation, batch_reservation )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto data            = format( contents.get(), contents_length );
+
+        auto alloc1 = detail::reserve(data, 32, AtomID::vector);
+        auto alloc2 = detail::reserve(data, 32, AtomID::vector);
+
+        std::memset( detail::contents<uint8_t>(alloc1), 0x11, 32 );
+        std::memset( detail::contents<uint8_t>(alloc2), 0x22, 32 );
+
+        // • The first moves past the second, the second extends in place, and
+        //   the third is new
+        //
+        auto allocations = std::array<Atom*, 3>{ alloc1, alloc2, nullptr };
+        auto sizes       = std::array<uint32_t, 3>{ 64, 96, 48 };
+
+        detail::reserve( data, allocations, sizes );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        EXPECT_NE( allocations[0], alloc1 );
+        EXPECT_EQ( allocations[1], alloc2 );
+        EXPECT_EQ( alloc1->identifier, AtomID::free );
+
+        for ( auto index = 0; index < 3; ++index )
+        {
+            EXPECT_EQ( allocations[index]->identifier, AtomID::vector );
+            EXPECT_EQ( detail::contents_size(allocations[index]), sizes[index] );
+        }
+
+        EXPECT_EQ( detail::contents<uint8_t>(allocations[0])[31], 0x11 );
+        EXPECT_EQ( detail::contents<uint8_t>(allocations[1])[31], 0x22 );
+
+        // • The new atoms fill the first free regions that fit, in order
+        //
+        EXPECT_EQ( detail::distance(data, allocations[1]), 64 );
+        EXPECT_EQ( detail::distance(data, allocations[0]), 176 );
+        EXPECT_EQ( detail::distance(data, allocations[2]), 256 );
     }
     catch ( ... )
     {
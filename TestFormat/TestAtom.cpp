@@ -198,3 +198,64 @@ TEST( atom, minimum_layout )
         FAIL();
     }
 }
+
+TEST( atom, diagnose_layout )
+{
+    const auto layout = std::vector<uint8_t>{ {
+
+        // Atom: length, identifier, previous, user_defined
+        16,0,0,0,   'a','t','a','d',     0,0,0,0,   0,0,0,0,
+        32,0,0,0,   'e','e','r','f',    16,0,0,0,   0,0,0,0,
+            0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
+        48,0,0,0,   'r','t','c','v',    32,0,0,0,   0,0,0,0,
+            0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
+            0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
+        16,0,0,0,   ' ','d','n','e',    48,0,0,0,   0,0,0,0,
+    } };
+
+    const auto diagnose = [](std::vector<uint8_t> contents) {
+        return diagnose_layout( contents.data(), static_cast<uint32_t>( contents.size() ) );
+    };
+
+    EXPECT_FALSE( diagnose(layout).has_value() );
+
+    // • The offset of the first atom that fails, as validate_layout
+    //
+    auto wrong_previous = layout;
+
+    wrong_previous[56] = 16;
+
+    ASSERT_TRUE( diagnose(wrong_previous).has_value() );
+    EXPECT_EQ( diagnose(wrong_previous)->offset, 48 );
+    EXPECT_FALSE( validate_layout( wrong_previous.data(), static_cast<uint32_t>( wrong_previous.size() ) ) );
+
+    auto unknown_identifier = layout;
+
+    unknown_identifier[52] = 'x';
+
+    ASSERT_TRUE( diagnose(unknown_identifier).has_value() );
+    EXPECT_EQ( diagnose(unknown_identifier)->offset, 48 );
+
+    auto overlong_free = layout;
+
+    overlong_free[16] = 112;
+
+    ASSERT_TRUE( diagnose(overlong_free).has_value() );
+    EXPECT_EQ( diagnose(overlong_free)->offset, 16 );
+
+    // • A 'data' atom past 'end ' is reported without reading past the contents
+    //
+    auto overlong_data = layout;
+
+    overlong_data[1] = 1;
+
+    ASSERT_TRUE( diagnose(overlong_data).has_value() );
+    EXPECT_EQ( diagnose(overlong_data)->offset, 0 );
+
+    auto missing_end = layout;
+
+    missing_end[100] = 'x';
+
+    ASSERT_TRUE( diagnose(missing_end).has_value() );
+    EXPECT_EQ( diagnose(missing_end)->offset, 96 );
+}
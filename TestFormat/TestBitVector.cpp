@@ -0,0 +1,269 @@
+//
+//  TestBitVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/BitVector.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • BitVector tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct MaskData
+{
+    BitVectorRef    visible;
+    BitVectorRef    selected;
+};
+
+std::vector<bool> random_bits(uint32_t count, double density, uint32_t seed)
+{
+    auto engine = std::mt19937{ seed };
+    auto dist   = std::bernoulli_distribution{ density };
+    auto bits   = std::vector<bool>( count );
+
+    for ( auto index = uint32_t{ 0 }; index < count; ++index ) {
+        bits[index] = dist(engine);
+    }
+
+    return bits;
+}
+
+void assign(BitVector& vector, const std::vector<bool>& bits)
+{
+    vector.resize( static_cast<uint32_t>(bits.size()) );
+
+    for ( auto index = uint32_t{ 0 }; index < bits.size(); ++index ) {
+        vector.set(index, bits[index]);
+    }
+}
+
+} // namespace
+
+TEST( bit_vector, bits )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<MaskData>(contents.get(), contents_length);
+
+        auto visible = BitVector{ root->visible, data };
+
+        EXPECT_TRUE( visible.empty() );
+        EXPECT_TRUE( visible.none() );
+        EXPECT_EQ( visible.find_first(), BitVector::npos );
+
+        for ( auto index = uint32_t{ 0 }; index < 100; ++index ) {
+            ASSERT_NO_THROW( visible.push_back(0 == index % 3) );
+        }
+
+        EXPECT_EQ( visible.size(), 100 );
+        EXPECT_EQ( visible.words().size(), 2 );
+        EXPECT_EQ( visible.count(), 34 );
+        EXPECT_TRUE( visible[99] );
+        EXPECT_FALSE( visible[98] );
+
+        visible.flip(98);
+        visible.reset(99);
+
+        EXPECT_TRUE( visible.test(98) );
+        EXPECT_FALSE( visible.test(99) );
+        EXPECT_EQ( visible.find_next(97), 98 );
+        EXPECT_EQ( visible.find_next(99), BitVector::npos );
+
+        // • Ranges across word boundaries, keeping the bits past the size clear
+        //
+        visible.reset_range(0, 100);
+
+        EXPECT_TRUE( visible.none() );
+
+        visible.set_range(60, 70);
+
+        EXPECT_EQ( visible.count(), 10 );
+        EXPECT_EQ( visible.find_first(), 60 );
+        EXPECT_THAT( std::vector( visible.words().begin(), visible.words().end() ), ElementsAre(0xf000'0000'0000'0000, 0x3f) );
+
+        visible.flip();
+
+        EXPECT_EQ( visible.count(), 90 );
+        EXPECT_EQ( visible.words()[1], 0xf'ffff'ffc0 );
+
+        visible.set_range(0, 100);
+
+        EXPECT_TRUE( visible.all() );
+
+        // • Growing sets only the new bits, shrinking clears the tail
+        //
+        ASSERT_NO_THROW( visible.resize(64) );
+        ASSERT_NO_THROW( visible.resize(130, false) );
+
+        EXPECT_EQ( visible.count(), 64 );
+
+        ASSERT_NO_THROW( visible.resize(200, true) );
+
+        EXPECT_EQ( visible.count(), 134 );
+        EXPECT_FALSE( visible.test(129) );
+        EXPECT_TRUE( visible.test(130) );
+        EXPECT_EQ( visible.words().back(), 0xff );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( bit_vector, combine )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<MaskData>(contents.get(), contents_length);
+
+        auto visible  = BitVector{ root->visible, data };
+        auto selected = BitVector{ root->selected, data };
+
+        const auto visible_bits  = random_bits(1000, 0.5, 1);
+        const auto selected_bits = random_bits(1000, 0.1, 2);
+
+        assign(visible, visible_bits);
+        assign(selected, selected_bits);
+
+        selected &= visible;
+
+        for ( auto index = uint32_t{ 0 }; index < 1000; ++index ) {
+            EXPECT_EQ( selected[index], visible_bits[index] && selected_bits[index] );
+        }
+
+        visible.and_not(selected);
+
+        auto expected = std::vector<uint32_t>{ };
+
+        for ( auto index = uint32_t{ 0 }; index < 1000; ++index )
+        {
+            if ( visible_bits[index] && !selected_bits[index] ) {
+                expected.push_back(index);
+            }
+        }
+
+        auto indices = std::vector<uint32_t>{ };
+
+        visible.for_each_set( [&](auto index) { indices.push_back(index); } );
+
+        EXPECT_EQ( indices, expected );
+
+        visible |= selected;
+        visible ^= selected;
+
+        EXPECT_EQ( visible.count(), expected.size() );
+
+        // • Sizes must match
+        //
+        ASSERT_NO_THROW( selected.push_back(true) );
+
+        EXPECT_THROW( visible &= selected, bool );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( bit_vector, rank_select )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<MaskData>(contents.get(), contents_length);
+
+        auto visible = BitVector{ root->visible, data };
+
+        const auto bits = random_bits(5000, 0.3, 3);
+
+        assign(visible, bits);
+
+        auto ranks = std::vector<uint32_t>{ 0 };
+        auto ones  = std::vector<uint32_t>{ };
+
+        for ( auto index = uint32_t{ 0 }; index < bits.size(); ++index )
+        {
+            ranks.push_back( ranks.back() + bits[index] );
+
+            if ( bits[index] ) {
+                ones.push_back(index);
+            }
+        }
+
+        auto check = [&]{
+            for ( auto index = uint32_t{ 0 }; index <= bits.size(); ++index ) {
+                ASSERT_EQ( visible.rank(index), ranks[index] );
+            }
+
+            for ( auto rank = uint32_t{ 0 }; rank < ones.size(); ++rank ) {
+                ASSERT_EQ( visible.select(rank), ones[rank] );
+            }
+
+            EXPECT_EQ( visible.select( static_cast<uint32_t>(ones.size()) ), BitVector::npos );
+        };
+
+        // • The same answers with and without the index
+        //
+        EXPECT_FALSE( visible.has_rank_index() );
+        check();
+
+        ASSERT_NO_THROW( visible.build_rank_index() );
+
+        EXPECT_TRUE( visible.has_rank_index() );
+        EXPECT_EQ( root->visible.ranks.count, 11 );
+        check();
+
+        // • Changes make the index stale, and it reopens as it was left
+        //
+        auto reopened = BitVector{ root->visible, data };
+
+        EXPECT_TRUE( reopened.has_rank_index() );
+
+        visible.flip(0);
+
+        EXPECT_FALSE( visible.has_rank_index() );
+        EXPECT_FALSE( reopened.has_rank_index() );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
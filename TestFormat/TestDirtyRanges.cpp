@@ -0,0 +1,228 @@
+//
+//  TestDirtyRanges.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/DirtyRanges.hpp>
+#include <Data/FlatMap.hpp>
+#include <Data/Vector.hpp>
+
+#include <cstring>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • DirtyRanges tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct FrameData
+{
+    VectorRef<float>            positions;
+    VectorRef<uint32_t>         indices;
+    FlatMapRef<uint32_t, float> weights;
+};
+
+// • Stands in for the device copy of the buffer, as a didModifyRange sink
+//
+struct MockUpload
+{
+    std::vector<uint8_t>    device;
+    uint64_t                uploaded = 0;
+
+    void upload(const uint8_t* contents, uint32_t offset, uint32_t length)
+    {
+        std::memcpy( device.data() + offset, contents + offset, length );
+
+        uploaded += length;
+    }
+};
+
+} // namespace
+
+TEST( dirty_ranges, mark )
+{
+    auto dirty = DirtyRanges{ 4096, 64 };
+
+    EXPECT_TRUE( dirty.empty() );
+    EXPECT_EQ( dirty.granularity(), 64 );
+
+    // • Widened to granules, and kept sorted
+    //
+    dirty.mark(100, 8);
+    dirty.mark(1000, 1);
+    dirty.mark(10, 0);
+
+    EXPECT_THAT( std::vector( dirty.ranges().begin(), dirty.ranges().end() ), ElementsAre( DirtyRange{ 64, 64 }, DirtyRange{ 960, 64 } ) );
+
+    // • Coalesced with adjacent and overlapping ranges
+    //
+    dirty.mark(130, 2);
+    dirty.mark(1100, 200);
+
+    EXPECT_THAT( std::vector( dirty.ranges().begin(), dirty.ranges().end() ), ElementsAre( DirtyRange{ 64, 128 }, DirtyRange{ 960, 64 }, DirtyRange{ 1088, 256 } ) );
+
+    dirty.mark(100, 1000);
+
+    EXPECT_THAT( std::vector( dirty.ranges().begin(), dirty.ranges().end() ), ElementsAre( DirtyRange{ 64, 1280 } ) );
+    EXPECT_EQ( dirty.dirty_length(), 1280 );
+
+    // • Bounded by the buffer, and consumed once
+    //
+    dirty.mark(4090, 6);
+
+    EXPECT_THAT( std::vector( dirty.ranges().begin(), dirty.ranges().end() ), ElementsAre( DirtyRange{ 64, 1280 }, DirtyRange{ 4032, 64 } ) );
+
+    auto consumed = dirty.consume();
+
+    EXPECT_EQ( consumed.size(), 2 );
+    EXPECT_TRUE( dirty.empty() );
+
+    dirty.mark_all();
+
+    auto calls = 0;
+
+    dirty.consume( [&](uint32_t offset, uint32_t length)
+    {
+        EXPECT_EQ( offset, 0 );
+        EXPECT_EQ( length, 4096 );
+        ++calls;
+    });
+
+    EXPECT_EQ( calls, 1 );
+    EXPECT_TRUE( dirty.empty() );
+
+    EXPECT_THROW( DirtyRanges( 4096, 48 ), bool );
+}
+
+TEST( dirty_ranges, mark_random )
+{
+    auto engine = std::mt19937{ 9 };
+
+    for ( auto granularity : { 1u, 16u, 256u } )
+    {
+        auto dirty    = DirtyRanges{ 10000, granularity };
+        auto expected = std::vector<bool>( 10000 );
+
+        for ( auto mark = 0; mark < 200; ++mark )
+        {
+            const auto offset = static_cast<uint32_t>( engine() % 10000 );
+            const auto length = static_cast<uint32_t>( engine() % std::min( 50u, 10000 - offset ) );
+
+            dirty.mark(offset, length);
+
+            for ( auto index = offset; index < offset + length; ++index ) {
+                expected[index] = true;
+            }
+        }
+
+        // • Every marked byte is covered, by disjoint ranges on granules
+        //
+        auto covered = std::vector<bool>( 10000 );
+        auto end     = std::optional<uint32_t>{ };
+
+        for ( const auto& range : dirty.ranges() )
+        {
+            if ( end ) {
+                EXPECT_LT( *end, range.offset );
+            }
+
+            EXPECT_EQ( range.offset % granularity, 0 );
+
+            for ( auto index = range.offset; index < range.end(); ++index ) {
+                covered[index] = true;
+            }
+
+            end = range.end();
+        }
+
+        for ( auto index = 0u; index < expected.size(); ++index )
+        {
+            if ( expected[index] ) {
+                ASSERT_TRUE( covered[index] ) << index;
+            }
+        }
+
+        if ( 1 == granularity ) {
+            EXPECT_EQ( covered, expected );
+        }
+    }
+}
+
+TEST( dirty_ranges, mutator )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 18 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<FrameData>(contents.get(), contents_length);
+
+        auto dirty   = DirtyRanges{ contents_length, 256 };
+        auto mutator = Mutator{ data, contents_length, { &dirty } };
+        auto upload  = MockUpload{ };
+
+        auto positions = Vector<float>{ root->positions, mutator };
+        auto indices   = Vector<uint32_t>{ root->indices, mutator };
+        auto weights   = FlatMap<uint32_t, float>{ root->weights, mutator };
+
+        upload.device.assign( contents.get(), contents.get() + contents_length );
+
+        auto engine = std::mt19937{ 4 };
+
+        for ( auto frame = 0; frame < 50; ++frame )
+        {
+            // • Growth, relocation, writes and insertions, as in a frame
+            //
+            for ( auto count = 0; count < 40; ++count )
+            {
+                positions.push_back( static_cast<float>( engine() % 1000 ) );
+                indices.push_back( engine() );
+            }
+
+            if ( 0 == frame % 10 ) {
+                positions.reserve( positions.size() * 2 );
+            }
+
+            weights.insert_or_assign( engine() % 5000, static_cast<float>(frame) );
+
+            dirty.consume( [&](uint32_t offset, uint32_t length) {
+                upload.upload( contents.get(), offset, length );
+            });
+
+            ASSERT_EQ( 0, std::memcmp( upload.device.data(), contents.get(), contents_length ) ) << frame;
+        }
+
+        // • Only a small part of the buffer was uploaded each frame
+        //
+        EXPECT_LT( upload.uploaded, uint64_t{ 50 } * contents_length / 20 );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,247 @@
+//
+//  TestEpoch.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/EpochMutator.hpp>
+#include <Data/Journal.hpp>
+#include <Data/Vector.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Epoch tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct SharedData
+{
+    VectorRef<uint32_t> values;
+    VectorRef<uint32_t> others;
+};
+
+} // namespace
+
+TEST( epoch, readers )
+{
+    auto domain = EpochDomain{ };
+
+    const auto first_epoch = domain.epoch();
+
+    EXPECT_EQ( domain.min_reader_epoch(), first_epoch );
+
+    {
+        auto reader = EpochReader{ domain };
+        auto guard  = EpochGuard{ reader };
+
+        EXPECT_EQ( domain.advance(), first_epoch + 1 );
+        EXPECT_EQ( domain.min_reader_epoch(), first_epoch );
+    }
+
+    EXPECT_EQ( domain.min_reader_epoch(), first_epoch + 1 );
+
+    // • Slots are released with their readers
+    //
+    auto readers = std::vector<std::unique_ptr<EpochReader>>{ };
+
+    for ( auto index = 0u; index < EpochDomain::max_readers; ++index ) {
+        readers.push_back( std::make_unique<EpochReader>(domain) );
+    }
+
+    EXPECT_THROW( EpochReader{ domain }, bool );
+
+    readers.pop_back();
+
+    EXPECT_NO_THROW( EpochReader{ domain } );
+}
+
+TEST( epoch, deferred_free )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 4096 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<SharedData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto domain  = EpochDomain{ };
+        auto reader  = EpochReader{ domain };
+        auto journal = Journal{ };
+        auto mutator = EpochMutator{ data, contents_length, domain, { &journal } };
+
+        auto values = Vector<uint32_t>{ root->values, mutator };
+        auto others = Vector<uint32_t>{ root->others, mutator };
+
+        values.assign({ 1, 2, 3, 4 });
+        others.assign({ 5, 6, 7, 8 });
+
+        // • A reader within the first atom keeps it through a relocation
+        //
+        reader.enter();
+
+        const auto first        = values.data();
+        const auto first_offset = root->values.offset - atom_header_length;
+
+        values.push_back(5);
+
+        ASSERT_NE( values.data(), first );
+        EXPECT_EQ( mutator.retired_count(), 1 );
+        EXPECT_EQ( mutator.reclaim(), 0 );
+
+        EXPECT_THAT( std::vector( first, first + 4 ), ElementsAre( 1, 2, 3, 4 ) );
+        EXPECT_THAT( values, ElementsAre( 1, 2, 3, 4, 5 ) );
+
+        // • Freed once the reader has left
+        //
+        reader.leave();
+
+        EXPECT_EQ( mutator.reclaim(), 1 );
+        EXPECT_EQ( mutator.retired_count(), 0 );
+        EXPECT_EQ( detail::offset_by(data, first_offset)->identifier, AtomID::free );
+
+        // • Shrinks are skipped and frees are deferred as well
+        //
+        auto alloc = mutator.reserve(64, AtomID::vector);
+
+        reader.enter();
+
+        EXPECT_EQ( mutator.reserve(alloc, 16), alloc );
+        EXPECT_EQ( detail::contents_size(alloc), 64 );
+
+        mutator.free(alloc);
+
+        EXPECT_EQ( alloc->identifier, AtomID::vector );
+        EXPECT_EQ( mutator.reclaim(), 0 );
+
+        reader.leave();
+
+        EXPECT_EQ( mutator.reclaim(), 1 );
+        EXPECT_EQ( alloc->identifier, AtomID::free );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        // • Relocations and reclamations are journaled in the order they happened
+        //
+        EXPECT_TRUE( replay( checkpoint.get(), contents_length, journal.records(), journal.size() ) );
+        EXPECT_EQ( 0, std::memcmp(checkpoint.get(), contents.get(), contents_length) );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
+
+TEST( epoch, concurrent_readers )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 22 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<SharedData>(contents.get(), contents_length);
+
+        auto domain  = EpochDomain{ };
+        auto mutator = EpochMutator{ data, contents_length, domain };
+
+        // • The writer publishes each ref after writing the values it covers
+        //
+        auto published = std::atomic<uint64_t>{ 0 };
+        auto done      = std::atomic<bool>{ false };
+        auto failures  = std::atomic<uint32_t>{ 0 };
+
+        const auto base  = reinterpret_cast<const uint8_t*>(data);
+        const auto count = uint32_t{ 4000 };
+
+        auto readers = std::vector<std::thread>{ };
+
+        for ( auto thread = 0; thread < 3; ++thread )
+        {
+            readers.emplace_back( [&]()
+            {
+                auto reader = EpochReader{ domain };
+
+                while ( !done.load() )
+                {
+                    auto guard    = EpochGuard{ reader };
+                    auto snapshot = published.load(std::memory_order_acquire);
+
+                    const auto offset = static_cast<uint32_t>(snapshot >> 32);
+                    const auto size   = static_cast<uint32_t>(snapshot);
+                    const auto values = reinterpret_cast<const uint32_t*>(base + offset);
+
+                    for ( auto index = uint32_t{ 0 }; index < size; index += 1 + size / 64 )
+                    {
+                        if ( values[index] != index ) {
+                            ++failures;
+                        }
+                    }
+                }
+            });
+        }
+
+        {
+            auto values = Vector<uint32_t>{ root->values, mutator };
+            auto others = Vector<uint32_t>{ root->others, mutator };
+
+            for ( auto index = uint32_t{ 0 }; index < count; ++index )
+            {
+                values.push_back(index);
+                others.push_back(index);
+
+                published.store( uint64_t{ root->values.offset } << 32 | root->values.count,
+                                 std::memory_order_release );
+
+                if ( 0 == index % 16 ) {
+                    mutator.reclaim();
+                }
+            }
+        }
+
+        done.store(true);
+
+        for ( auto& reader : readers ) {
+            reader.join();
+        }
+
+        EXPECT_EQ( failures, 0 );
+
+        mutator.reclaim();
+
+        EXPECT_EQ( mutator.retired_count(), 0 );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,218 @@
+//
+//  TestFlatMap.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/FlatMap.hpp>
+#include <Data/Journal.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • FlatMap tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct IndexData
+{
+    FlatSetRef<uint32_t>        ids;
+    FlatMapRef<uint64_t, float> weights;
+};
+
+} // namespace
+
+TEST( flat_map, lower_bound )
+{
+    const auto keys = std::vector<int>{ 1, 3, 3, 5, 8, 13, 21 };
+
+    for ( auto key = -1; key < 23; ++key )
+    {
+        for ( auto count = 0u; count <= keys.size(); ++count )
+        {
+            EXPECT_EQ( detail::lower_bound(keys.data(), count, key),
+                       std::distance( keys.begin(), std::lower_bound(keys.begin(), keys.begin() + count, key) ) );
+        }
+    }
+}
+
+TEST( flat_map, set )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<IndexData>(contents.get(), contents_length);
+
+        auto ids      = FlatSet<uint32_t>{ root->ids, data };
+        auto expected = std::set<uint32_t>{ };
+
+        EXPECT_TRUE( ids.insert(7) );
+        EXPECT_FALSE( ids.insert(7) );
+        EXPECT_TRUE( ids.insert(3) );
+
+        expected.insert({ 3, 7 });
+
+        // • Batches with duplicates, both within them and of existing keys
+        //
+        auto engine = std::mt19937{ 31 };
+
+        for ( auto batch = 0; batch < 8; ++batch )
+        {
+            auto keys = std::vector<uint32_t>( 200 );
+
+            for ( auto& key : keys ) {
+                key = engine() % 2000;
+            }
+
+            const auto previous_size = expected.size();
+
+            expected.insert( keys.begin(), keys.end() );
+
+            EXPECT_EQ( ids.insert(keys.begin(), keys.end()), expected.size() - previous_size );
+        }
+
+        EXPECT_TRUE( std::equal(ids.begin(), ids.end(), expected.begin(), expected.end()) );
+        EXPECT_TRUE( ids.contains(7) );
+        EXPECT_EQ( ids.erase(7), 1 );
+        EXPECT_EQ( ids.erase(7), 0 );
+        EXPECT_FALSE( ids.contains(7) );
+        EXPECT_EQ( ids.find(2001), ids.end() );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( flat_map, map )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<IndexData>(contents.get(), contents_length);
+
+        auto weights  = FlatMap<uint64_t, float>{ root->weights, data };
+        auto expected = std::map<uint64_t, float>{ };
+
+        EXPECT_TRUE( weights.insert_or_assign(40, 1.0f) );
+        EXPECT_FALSE( weights.insert_or_assign(40, 2.0f) );
+
+        expected[40] = 2.0f;
+
+        // • The last of equivalent keys in a batch is assigned
+        //
+        auto engine = std::mt19937{ 17 };
+
+        for ( auto batch = 0; batch < 8; ++batch )
+        {
+            auto keys   = std::vector<uint64_t>( 100 );
+            auto values = std::vector<float>( 100 );
+
+            for ( auto pair = 0u; pair < keys.size(); ++pair )
+            {
+                keys[pair]   = engine() % 500;
+                values[pair] = static_cast<float>( engine() % 100 );
+            }
+
+            const auto previous_size = expected.size();
+
+            for ( auto pair = 0u; pair < keys.size(); ++pair ) {
+                expected[keys[pair]] = values[pair];
+            }
+
+            EXPECT_EQ( weights.insert_or_assign(keys, values), expected.size() - previous_size );
+        }
+
+        ASSERT_EQ( weights.size(), expected.size() );
+
+        auto index = 0u;
+
+        for ( const auto& [key, value] : expected )
+        {
+            EXPECT_EQ( weights.keys()[index], key );
+            EXPECT_EQ( weights.values()[index], value );
+            ++index;
+        }
+
+        EXPECT_EQ( weights.at(40), expected[40] );
+        EXPECT_EQ( weights.find(501), nullptr );
+        EXPECT_THROW( weights.at(501), bool );
+
+        EXPECT_EQ( weights.erase(40), 1 );
+        EXPECT_FALSE( weights.contains(40) );
+        EXPECT_EQ( root->weights.keys.count, root->weights.values.count );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( flat_map, journal )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 14 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<IndexData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto journal = Journal{ };
+        auto mutator = Mutator{ data, contents_length, { &journal } };
+        auto ids     = FlatSet<uint32_t>{ root->ids, mutator };
+        auto weights = FlatMap<uint64_t, float>{ root->weights, mutator };
+
+        ASSERT_EQ( ids.insert({ 9, 1, 5 }), 3 );
+        ASSERT_EQ( ids.insert({ 4, 1, 12 }), 2 );
+
+        const auto keys   = std::vector<uint64_t>{ 30, 10, 20 };
+        const auto values = std::vector<float>{ 3.0f, 1.0f, 2.0f };
+
+        ASSERT_EQ( weights.insert_or_assign(keys, values), 3 );
+        ASSERT_FALSE( weights.insert_or_assign(20, 4.0f) );
+
+        // • Replaying onto the checkpoint reproduces the buffer
+        //
+        EXPECT_TRUE( replay( checkpoint.get(), contents_length, journal.records(), journal.size() ) );
+        EXPECT_EQ( 0, std::memcmp(checkpoint.get(), contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,183 @@
+//
+//  TestHashTable.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/HashTable.hpp>
+
+#include <random>
+#include <unordered_map>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • HashTable tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct TableData
+{
+    HashTableRef<uint64_t, uint32_t>    ids;
+};
+
+} // namespace
+
+TEST( hash_table, match_control )
+{
+    alignas(16) auto group = std::array<uint8_t, 16>{ };
+
+    group.fill( detail::control_empty );
+
+    group[0]  = 0x12;
+    group[5]  = 0x12;
+    group[9]  = detail::control_erased;
+    group[15] = 0x12;
+
+    EXPECT_EQ( detail::match_control(group.data(), 0x12), (1u << 0) | (1u << 5) | (1u << 15) );
+    EXPECT_EQ( detail::match_empty(group.data()), 0xffffu & ~((1u << 0) | (1u << 5) | (1u << 9) | (1u << 15)) );
+    EXPECT_EQ( detail::match_available(group.data()), 0xffffu & ~((1u << 0) | (1u << 5) | (1u << 15)) );
+}
+
+TEST( hash_table, operations )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 20 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<TableData>(contents.get(), contents_length);
+
+        auto table    = HashTable<uint64_t, uint32_t>{ root->ids, data };
+        auto expected = std::unordered_map<uint64_t, uint32_t>{ };
+        auto engine   = std::mt19937_64{ 5 };
+
+        EXPECT_TRUE( table.empty() );
+        EXPECT_EQ( table.find(1), nullptr );
+
+        // • Mixed insertions and erasures over a small key range, so that there
+        //   are assignments, erased slots and rehashes
+        //
+        for ( auto operation = 0; operation < 20000; ++operation )
+        {
+            const auto key = engine() % 4000;
+
+            if ( 0 == engine() % 3 )
+            {
+                EXPECT_EQ( table.erase(key), expected.erase(key) );
+            }
+            else
+            {
+                const auto value = static_cast<uint32_t>( engine() );
+
+                EXPECT_EQ( table.insert_or_assign(key, value), !expected.contains(key) );
+
+                expected[key] = value;
+            }
+        }
+
+        ASSERT_EQ( table.size(), expected.size() );
+
+        for ( auto key = uint64_t{ 0 }; key < 4000; ++key )
+        {
+            auto value = table.find(key);
+
+            ASSERT_EQ( nullptr != value, expected.contains(key) );
+
+            if ( nullptr != value ) {
+                EXPECT_EQ( *value, expected[key] );
+            }
+        }
+
+        auto visited = size_t{ 0 };
+
+        table.for_each( [&](const auto& key, const auto& value) {
+            EXPECT_EQ( value, expected[key] );
+            ++visited;
+        });
+
+        EXPECT_EQ( visited, expected.size() );
+        EXPECT_THROW( table.at(4001), bool );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        table.clear();
+
+        EXPECT_TRUE( table.empty() );
+        EXPECT_FALSE( table.contains(0) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( hash_table, relocated_buffer )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<TableData>(contents.get(), contents_length);
+
+        {
+            auto table = HashTable<uint64_t, uint32_t>{ root->ids, data };
+
+            ASSERT_NO_THROW( table.reserve(1000) );
+
+            const auto capacity = table.capacity();
+
+            for ( auto key = uint64_t{ 0 }; key < 1000; ++key ) {
+                ASSERT_TRUE( table.insert_or_assign(key * 7919, static_cast<uint32_t>(key)) );
+            }
+
+            EXPECT_EQ( table.capacity(), capacity );
+        }
+
+        // • The table is used in place at another address
+        //
+        auto copy = std::make_unique<uint8_t[]>(contents_length);
+
+        std::memcpy( copy.get(), contents.get(), contents_length );
+
+        auto copy_data = data_atom(copy.get(), contents_length);
+        auto copy_root = detail::contents<TableData>(copy_data);
+        auto table     = HashTable<uint64_t, uint32_t>{ copy_root->ids, copy_data };
+
+        for ( auto key = uint64_t{ 0 }; key < 1000; ++key ) {
+            EXPECT_EQ( table.at(key * 7919), key );
+        }
+
+        // • An inconsistent ref is rejected
+        //
+        auto invalid = HashTableRef<uint64_t, uint32_t>{ copy_root->ids };
+
+        invalid.capacity = 48;
+
+        EXPECT_THROW( (HashTable<uint64_t, uint32_t>{ invalid, copy_data }), bool );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
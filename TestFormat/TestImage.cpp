@@ -0,0 +1,160 @@
+//
+//  TestImage.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Image.hpp>
+#include <Data/Planner.hpp>
+#include <Data/VectorView.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Image tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct UnitTable
+{
+    uint32_t            version;
+    float               scale;
+    VectorRef<uint32_t> codes;
+    VectorRef<double>   factors;
+    VectorRef<char>     symbols;
+};
+
+} // namespace
+
+DATA_SCHEMA( UnitTable, codes, factors, symbols );
+
+namespace
+{
+
+constexpr auto unit_codes   = std::array<uint32_t, 5>{ 2, 3, 5, 7, 11 };
+constexpr auto unit_factors = std::array<double, 5>{ 1.0, 0.001, 1000.0, 0.0254, 0.3048 };
+constexpr auto unit_symbols = std::string_view{ "mmmkminft" };
+
+constexpr auto unit_length  = plan_length<UnitTable>({ 5, 5, 9 });
+
+constexpr auto unit_image = []
+{
+    auto builder = ImageBuilder<UnitTable, unit_length>{ };
+
+    const auto root = UnitTable{
+        .version = 3,
+        .scale   = 0.5f,
+        .codes   = builder.add_vector(unit_codes),
+        .factors = builder.add_vector(unit_factors),
+        .symbols = builder.add_vector(unit_symbols)
+    };
+
+    builder.set_root(root);
+
+    return builder.finish();
+}();
+
+// • Built entirely at compile time
+//
+static_assert( 16 + 32 + ( 16 + 32 ) + ( 16 + 48 ) + ( 16 + 16 ) + 16 == unit_image.size() );
+
+static_assert( 'd' == unit_image.bytes[7] && 'a' == unit_image.bytes[4] );
+static_assert( 'e' == unit_image.bytes[unit_image.size() - 9] );
+static_assert( 3 == unit_image.bytes[16] );
+
+} // namespace
+
+TEST( image, planned )
+{
+    try
+    {
+        EXPECT_TRUE( validate_layout(unit_image.bytes.data(), unit_image.size()) );
+
+        auto data = unit_image.data();
+        auto root = unit_image.root();
+
+        EXPECT_TRUE( validate_vectors<UnitTable>(data) );
+
+        EXPECT_EQ( root->version, 3 );
+        EXPECT_EQ( root->scale, 0.5f );
+
+        EXPECT_THAT( VectorView(root->codes, data), ElementsAreArray(unit_codes) );
+        EXPECT_THAT( VectorView(root->factors, data), ElementsAreArray(unit_factors) );
+        EXPECT_THAT( VectorView(root->symbols, data), ElementsAreArray(unit_symbols) );
+
+        // • Every atom is in use
+        //
+        for ( auto atom = detail::next(data); !detail::is_end(atom); atom = detail::next(atom) ) {
+            EXPECT_EQ( atom->identifier, AtomID::vector );
+        }
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
+
+TEST( image, remainder )
+{
+    try
+    {
+        static constexpr auto image = []
+        {
+            auto builder = ImageBuilder<UnitTable, 256>{ };
+            const auto root = UnitTable{
+                .version = 1,
+                .scale   = 1.0f,
+                .codes   = builder.add_vector(unit_codes),
+                .factors = { },
+                .symbols = { }
+            };
+
+            builder.set_root(root);
+
+            return builder.finish();
+        }();
+
+        EXPECT_TRUE( validate_layout(image.bytes.data(), image.size()) );
+
+        auto data = image.data();
+        auto root = image.root();
+
+        EXPECT_EQ( root->version, 1 );
+        EXPECT_EQ( root->factors.count, 0 );
+        EXPECT_THAT( VectorView(root->codes, data), ElementsAreArray(unit_codes) );
+
+        // • The remaining length is one 'free' atom before the end
+        //
+        auto vctr = detail::next(data);
+        auto free = detail::next(vctr);
+
+        EXPECT_EQ( vctr->identifier, AtomID::vector );
+        EXPECT_EQ( free->identifier, AtomID::free );
+        EXPECT_EQ( free->length, 256 - 48 - 48 - 16 );
+        EXPECT_TRUE( detail::is_end(detail::next(free)) );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
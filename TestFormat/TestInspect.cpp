@@ -0,0 +1,237 @@
+//
+//  TestInspect.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Allocation.hpp>
+#include <Data/Inspect.hpp>
+#include <Data/Vector.hpp>
+#include <InspectFormat/SchemaFile.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Inspection tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct InspectData
+{
+    VectorRef<uint32_t> indices;
+    VectorRef<uint32_t> unused;
+    VectorRef<uint64_t> keys;
+};
+
+} // namespace
+
+DATA_SCHEMA( InspectData, indices, unused, keys );
+
+TEST( inspect, atom_chain )
+{
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto data = format( contents.get(), contents_length );
+    auto vctr = detail::reserve( data, 1000, AtomID::vector );
+
+    auto chain = atom_chain( contents.get(), contents_length );
+
+    ASSERT_EQ( chain.size(), 4 );
+    EXPECT_EQ( chain[0].identifier, AtomID::data );
+    EXPECT_EQ( chain[1].identifier, AtomID::vector );
+    EXPECT_EQ( chain[1].offset, 16 );
+    EXPECT_EQ( chain[1].length, vctr->length );
+    EXPECT_EQ( chain[2].identifier, AtomID::free );
+    EXPECT_EQ( chain[2].previous, vctr->length );
+    EXPECT_EQ( chain[3].identifier, AtomID::end );
+    EXPECT_EQ( chain[3].offset, contents_length - atom_header_length );
+
+    // • Stops at an atom running past the contents
+    //
+    detail::next(vctr)->length = 2 * contents_length;
+
+    chain = atom_chain( contents.get(), contents_length );
+
+    ASSERT_EQ( chain.size(), 3 );
+    EXPECT_EQ( chain.back().identifier, AtomID::free );
+    EXPECT_EQ( chain.back().length, 2 * contents_length );
+
+    EXPECT_THROW( atom_chain( contents.get() + 8, contents_length - 16 ), bool );
+}
+
+TEST( inspect, free_space )
+{
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto data = format( contents.get(), contents_length );
+
+    auto free = free_space( contents.get(), contents_length );
+
+    EXPECT_EQ( free.free_count, 1 );
+    EXPECT_EQ( free.free_length, contents_length - 2 * atom_header_length );
+    EXPECT_EQ( free.largest_free, free.free_length );
+    EXPECT_EQ( free.histogram[11], 1 );
+    EXPECT_EQ( free.fragmentation(), 0.0 );
+
+    // • A hole of 256 bytes between two vectors
+    //
+    detail::reserve( data, 240, AtomID::vector );
+
+    auto hole = detail::reserve( data, 240, AtomID::vector );
+
+    detail::reserve( data, 240, AtomID::vector );
+    detail::free(hole);
+
+    // • Placed after the hole, which is too small
+    //
+    detail::reserve( data, 1000, AtomID::vector );
+
+    free = free_space( contents.get(), contents_length );
+
+    EXPECT_EQ( free.free_count, 2 );
+    EXPECT_EQ( free.free_length, contents_length - 2 * atom_header_length - 2 * 256 - 1024 );
+    EXPECT_EQ( free.histogram[8], 1 );
+    EXPECT_EQ( free.histogram[11], 1 );
+    EXPECT_EQ( free.largest_free, free.free_length - 256 );
+    EXPECT_GT( free.fragmentation(), 0.0 );
+}
+
+TEST( inspect, occupancy_map )
+{
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto data = format( contents.get(), contents_length );
+
+    EXPECT_EQ( occupancy_map( contents.get(), contents_length, 16 ), ":..............:" );
+
+    detail::reserve( data, 1000, AtomID::vector );
+
+    EXPECT_EQ( occupancy_map( contents.get(), contents_length, 16 ), "####:..........:" );
+
+    // • No more cells than bytes, and cells of unequal length still add up
+    //
+    EXPECT_EQ( occupancy_map( contents.get(), contents_length, 8192 ).size(), contents_length );
+    EXPECT_EQ( occupancy_map( contents.get(), contents_length, 3 ), ":.:" );
+
+    EXPECT_THROW( occupancy_map( contents.get(), contents_length, 0 ), bool );
+}
+
+TEST( inspect, vector_usage )
+{
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<InspectData>( contents.get(), contents_length );
+
+    auto indices = Vector<uint32_t>{ root->indices, data };
+    auto keys    = Vector<uint64_t>{ root->keys, data };
+
+    indices.reserve(100);
+    indices.push_back(1);
+    indices.push_back(2);
+
+    keys.reserve(2);
+    keys.push_back(1);
+    keys.push_back(2);
+
+    auto usage = vector_usage( contents.get(), contents_length, vector_fields<InspectData> );
+
+    ASSERT_EQ( usage.size(), 3 );
+
+    EXPECT_TRUE( usage[0].is_valid );
+    EXPECT_EQ( usage[0].count, 2 );
+    EXPECT_EQ( usage[0].used_length, 8 );
+    EXPECT_EQ( usage[0].allocated_length, 400 );
+    EXPECT_EQ( usage[0].reclaimable(), 392 );
+
+    EXPECT_TRUE( usage[1].is_valid );
+    EXPECT_EQ( usage[1].allocated_length, 0 );
+    EXPECT_EQ( usage[1].reclaimable(), 0 );
+
+    EXPECT_TRUE( usage[2].is_valid );
+    EXPECT_EQ( usage[2].used_length, 16 );
+    EXPECT_EQ( usage[2].reclaimable(), 0 );
+
+    // • References past the root, into the middle of an atom, or to fewer
+    //   bytes than their count are invalid
+    //
+    const auto fields = std::vector<VectorField>{
+        { .offset = aligned_size<InspectData>(), .element_size = 4, .alignment = 4 },
+        { .offset = 0, .element_size = 400, .alignment = 4 }
+    };
+
+    usage = vector_usage( contents.get(), contents_length, fields );
+
+    EXPECT_FALSE( usage[0].is_valid );
+    EXPECT_FALSE( usage[1].is_valid );
+    EXPECT_EQ( usage[1].reclaimable(), 0 );
+
+    root->keys.offset += 16;
+
+    usage = vector_usage( contents.get(), contents_length, vector_fields<InspectData> );
+
+    EXPECT_FALSE( usage[2].is_valid );
+}
+
+TEST( inspect, schema_file )
+{
+    const auto schema = read_schema_file( R"({
+        "root": "InspectData",
+        "version": [ 1, { "minor": 2.5e0 } ],
+        "vectors": [
+            { "name": "indices", "offset": 0, "element_size": 4 },
+            { "name": "unused", "offset": 8, "element_size": 4, "alignment": 4, "note": null },
+            { "name": "ke\"ys", "offset": 16, "element_size": 8, "alignment": 8 }
+        ]
+    })" );
+
+    EXPECT_EQ( schema.root, "InspectData" );
+    ASSERT_EQ( schema.vectors.size(), 3 );
+
+    for ( auto index = size_t{ 0 }; index < schema.vectors.size(); ++index )
+    {
+        EXPECT_EQ( schema.vectors[index].field.offset, vector_fields<InspectData>[index].offset );
+        EXPECT_EQ( schema.vectors[index].field.element_size, vector_fields<InspectData>[index].element_size );
+        EXPECT_EQ( schema.vectors[index].field.alignment, vector_fields<InspectData>[index].alignment );
+    }
+
+    EXPECT_EQ( schema.vectors[2].name, "ke\"ys" );
+
+    EXPECT_THROW( read_schema_file( R"({ "vectors": [ { "offset": 0 } ] })" ), bool );
+    EXPECT_THROW( read_schema_file( R"({ "vectors": [ { "offset": -1, "element_size": 4 } ] })" ), bool );
+    EXPECT_THROW( read_schema_file( R"({ "vectors": [] } trailing)" ), bool );
+    EXPECT_THROW( read_schema_file( R"({ "vectors": [ )" ), bool );
+
+    // • Nesting is limited, including within the members that are skipped
+    //
+    const auto nested = [](size_t depth) {
+        return R"({ "vectors": [], "note": )" + std::string( depth, '[' ) + std::string( depth, ']' ) + " }";
+    };
+
+    EXPECT_NO_THROW( read_schema_file( nested(63) ) );
+    EXPECT_THROW( read_schema_file( nested(64) ), bool );
+    EXPECT_THROW( read_schema_file( nested(1 << 20) ), bool );
+}
@@ -0,0 +1,147 @@
+//
+//  TestJaggedVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/JaggedVector.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • JaggedVector tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct GraphData
+{
+    JaggedVectorRef<uint32_t>   edges;
+};
+
+} // namespace
+
+TEST( jagged_vector, append )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<GraphData>(contents.get(), contents_length);
+
+        auto edges = JaggedVector<uint32_t>{ root->edges, data };
+
+        EXPECT_TRUE( edges.empty() );
+
+        const auto row = std::vector<uint32_t>{ 1, 2, 3 };
+
+        ASSERT_NO_THROW( edges.push_back(row) );
+        ASSERT_NO_THROW( edges.push_back({ }) );
+
+        const auto values = std::vector<uint32_t>{ 4, 5, 6, 7, 8 };
+        const auto counts = std::vector<uint32_t>{ 2, 0, 3 };
+
+        ASSERT_NO_THROW( edges.append(values, counts) );
+
+        EXPECT_EQ( edges.size(), 5 );
+        EXPECT_EQ( edges.value_count(), 8 );
+        EXPECT_THAT( std::vector( edges[0].begin(), edges[0].end() ), ElementsAre(1, 2, 3) );
+        EXPECT_THAT( edges[1], IsEmpty() );
+        EXPECT_THAT( std::vector( edges[2].begin(), edges[2].end() ), ElementsAre(4, 5) );
+        EXPECT_THAT( edges[3], IsEmpty() );
+        EXPECT_THAT( std::vector( edges[4].begin(), edges[4].end() ), ElementsAre(6, 7, 8) );
+
+        // • Counts that don't match the values are rejected without change
+        //
+        EXPECT_THROW( edges.append(values, row), bool );
+        EXPECT_EQ( edges.size(), 5 );
+
+        const auto offsets = contents_of(root->edges.offsets, data);
+
+        EXPECT_THAT( std::vector( offsets.begin(), offsets.end() ), ElementsAre(0, 3, 3, 5, 5, 8) );
+
+        for ( auto index = 0; index < 1000; ++index ) {
+            ASSERT_NO_THROW( edges.push_back(row) );
+        }
+
+        EXPECT_EQ( edges.size(), 1005 );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( jagged_vector, parallel_construction )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 22 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<GraphData>(contents.get(), contents_length);
+
+        auto edges  = JaggedVector<uint32_t>{ root->edges, data };
+        auto pool   = ThreadPool{ 4 };
+        auto engine = std::mt19937{ 3 };
+
+        ASSERT_NO_THROW( edges.push_back( std::vector<uint32_t>{ 9, 9 } ) );
+
+        auto counts = std::vector<uint32_t>( 100000 );
+
+        for ( auto& count : counts ) {
+            count = engine() % 8;
+        }
+
+        ASSERT_NO_THROW( edges.append_for_overwrite(pool, counts) );
+        ASSERT_EQ( edges.size(), counts.size() + 1 );
+
+        // • Each row is written by its own task, from its index
+        //
+        auto rows = std::vector<uint32_t>( counts.size() );
+
+        std::iota( rows.begin(), rows.end(), 1u );
+
+        parallel::for_each( pool, rows, [&](auto row) {
+            std::fill( edges[row].begin(), edges[row].end(), row );
+        });
+
+        EXPECT_THAT( std::vector( edges[0].begin(), edges[0].end() ), ElementsAre(9, 9) );
+
+        for ( auto row = 1u; row < edges.size(); ++row )
+        {
+            ASSERT_EQ( edges[row].size(), counts[row - 1] );
+            EXPECT_EQ( std::count(edges[row].begin(), edges[row].end(), row), counts[row - 1] );
+        }
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,292 @@
+//
+//  TestJournal.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Journal.hpp>
+#include <Data/Vector.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Journal tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct JournalData
+{
+    VectorRef<int>      values;
+    VectorRef<uint8_t>  bytes;
+};
+
+} // namespace
+
+TEST( journal, replay )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<JournalData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto journal = Journal{ };
+        auto mutator = Mutator{ data, contents_length, { &journal } };
+        auto values  = Vector<int>{ root->values, mutator };
+        auto bytes   = Vector<uint8_t>{ root->bytes, mutator };
+
+        EXPECT_TRUE( journal.empty() );
+
+        // • Interleave the two vectors so that growing the first relocates it
+        //
+        ASSERT_NO_THROW( values.assign({ 0, 1, 2, 3, 4, 5, 6 }) );
+        ASSERT_NO_THROW( bytes.assign({ 'a', 'b', 'c' }) );
+        ASSERT_NO_THROW( values.insert( values.cbegin() + 2, { 10, 11, 12, 13, 14 }) );
+        ASSERT_NO_THROW( values.erase( values.cbegin() ) );
+        ASSERT_NO_THROW( bytes.push_back('d') );
+
+        values[0] = 42;
+        mutator.write( values.data(), sizeof(int) );
+
+        EXPECT_FALSE( journal.empty() );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        // • Replaying onto the checkpoint reproduces the buffer
+        //
+        EXPECT_TRUE( replay( checkpoint.get(), contents_length, journal.records(), journal.size() ) );
+        EXPECT_EQ( 0, std::memcmp(checkpoint.get(), contents.get(), contents_length) );
+
+        auto replayed = detail::contents<JournalData>( data_atom(checkpoint.get(), contents_length) );
+
+        EXPECT_EQ( replayed->values.offset, root->values.offset );
+        EXPECT_EQ( replayed->values.count, 11 );
+        EXPECT_EQ( replayed->bytes.count, 4 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( journal, torn_tail )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 512 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<JournalData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto journal = Journal{ };
+        auto mutator = Mutator{ data, contents_length, { &journal } };
+        auto values  = Vector<int>{ root->values, mutator };
+
+        ASSERT_NO_THROW( values.assign({ 0, 1, 2, 3 }) );
+
+        const auto durable_length = journal.size();
+
+        ASSERT_NO_THROW( values.assign({ 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 }) );
+
+        // • Drop part of the final write as if the append had been interrupted
+        //
+        auto records = std::vector<uint8_t>( journal.records(), journal.records() + journal.size() );
+
+        records.resize( records.size() - 40 );
+
+        EXPECT_TRUE( replay( checkpoint.get(), contents_length, records.data(), records.size() ) );
+
+        auto replayed = detail::contents<JournalData>( data_atom(checkpoint.get(), contents_length) );
+
+        EXPECT_EQ( replayed->values.count, 4 );
+
+        // • Corruption before the final record is rejected
+        //
+        //      'rsrv' 'vref' 'writ' [payload] 'vref' ...
+        //
+        EXPECT_EQ( durable_length, 5*sizeof(JournalRecord) );
+
+        records.assign( journal.records(), journal.records() + journal.size() );
+        records[3*sizeof(JournalRecord)] ^= 0xff;
+
+        EXPECT_FALSE( replay( checkpoint.get(), contents_length, records.data(), records.size() ) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( journal, shrink_to_fit )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<JournalData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto journal = Journal{ };
+        auto mutator = Mutator{ data, contents_length, { &journal } };
+        auto values  = Vector<int>{ root->values, mutator };
+        auto bytes   = Vector<uint8_t>{ root->bytes, mutator };
+
+        ASSERT_NO_THROW( values.reserve(64) );
+        ASSERT_NO_THROW( values.assign({ 0, 1, 2, 3, 4, 5 }) );
+        ASSERT_NO_THROW( bytes.assign({ 'a', 'b', 'c' }) );
+
+        // • Shrinking in place frees the tail, and an empty vector frees its atom
+        //
+        ASSERT_NO_THROW( values.shrink_to_fit() );
+
+        EXPECT_EQ( values.capacity(), 8 );
+        EXPECT_THAT( values, ElementsAre( 0, 1, 2, 3, 4, 5 ) );
+
+        bytes.clear();
+
+        ASSERT_NO_THROW( bytes.shrink_to_fit() );
+
+        EXPECT_EQ( root->bytes.offset, 0 );
+        EXPECT_EQ( bytes.capacity(), 0 );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        EXPECT_TRUE( replay( checkpoint.get(), contents_length, journal.records(), journal.size() ) );
+        EXPECT_EQ( 0, std::memcmp(checkpoint.get(), contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( journal, invalid_records )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 512 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto checkpoint      = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<JournalData>(contents.get(), contents_length);
+
+        std::memcpy( checkpoint.get(), contents.get(), contents_length );
+
+        auto journal = Journal{ };
+        auto mutator = Mutator{ data, contents_length, { &journal } };
+        auto values  = Vector<int>{ root->values, mutator };
+
+        ASSERT_NO_THROW( values.assign({ 0, 1, 2, 3 }) );
+        ASSERT_NO_THROW( values.reserve(16) );
+
+        const auto records = std::vector<uint8_t>( journal.records(), journal.records() + journal.size() );
+
+        const auto replay_onto_checkpoint = [&](const std::vector<uint8_t>& records) {
+            auto copy = std::make_unique<uint8_t[]>(contents_length);
+
+            std::memcpy( copy.get(), checkpoint.get(), contents_length );
+
+            return replay( copy.get(), contents_length, records.data(), records.size() );
+        };
+
+        EXPECT_TRUE( replay_onto_checkpoint(records) );
+
+        // • A checkpoint with an invalid layout is rejected before any record
+        //
+        auto corrupt = std::make_unique<uint8_t[]>(contents_length);
+
+        std::memcpy( corrupt.get(), checkpoint.get(), contents_length );
+        reinterpret_cast<Atom*>( corrupt.get() + 32 )->length = 0;
+
+        EXPECT_FALSE( replay( corrupt.get(), contents_length, records.data(), records.size() ) );
+
+        // • 'rsiz' of an offset that is not an atom, aligned or not
+        //
+        //      'rsrv' 'vref' 'writ' [payload] 'vref' 'rsiz' 'vref'
+        //
+        const auto resize_offset = records.size() - 2*sizeof(JournalRecord);
+
+        auto record = JournalRecord{ };
+
+        std::memcpy( &record, records.data() + resize_offset, sizeof(record) );
+
+        ASSERT_EQ( record.identifier, JournalID::resize );
+
+        for ( auto offset : { record.offset + 4, record.offset + 16 } )
+        {
+            auto misplaced = records;
+            auto moved     = JournalRecord{ record.identifier, offset, record.size, record.result };
+
+            std::memcpy( misplaced.data() + resize_offset, &moved, sizeof(moved) );
+
+            EXPECT_FALSE( replay_onto_checkpoint(misplaced) );
+        }
+
+        // • Sizes that do not fit the contents, or that wrap when aligned
+        //
+        for ( auto size : { contents_length - 32, contents_length, 0xfffffff0u, 0xffffffffu } )
+        {
+            auto reserve = records;
+
+            std::memcpy( &record, reserve.data(), sizeof(record) );
+
+            ASSERT_EQ( record.identifier, JournalID::reserve );
+
+            record.size = size;
+            std::memcpy( reserve.data(), &record, sizeof(record) );
+
+            EXPECT_FALSE( replay_onto_checkpoint(reserve) );
+
+            auto resize = records;
+
+            std::memcpy( &record, resize.data() + resize_offset, sizeof(record) );
+
+            record.size = size;
+            std::memcpy( resize.data() + resize_offset, &record, sizeof(record) );
+
+            EXPECT_FALSE( replay_onto_checkpoint(resize) );
+
+            auto write = std::vector<uint8_t>( sizeof(JournalRecord) );
+
+            record = JournalRecord{ JournalID::write, 64, size, 0 };
+            std::memcpy( write.data(), &record, sizeof(record) );
+            write.resize( write.size() + 64, 0 );
+
+            if ( contents_length < size ) {
+                EXPECT_FALSE( replay_onto_checkpoint(write) );
+            }
+        }
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,225 @@
+//
+//  TestMerge.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/JaggedVector.hpp>
+#include <Data/Merge.hpp>
+#include <Data/VectorView.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Merge tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct ShardData
+{
+    uint32_t                    shard;
+    VectorRef<uint32_t>         ids;
+    VectorRef<double>           weights;
+    JaggedVectorRef<uint32_t>   rows;
+};
+
+struct IngestData
+{
+    VectorRef<ShardData>    shards;
+    VectorRef<uint8_t>      header;
+};
+
+// • Each shard has values derived from its index, in vectors of its own sizes
+//
+void build_shard(Atom* data, ShardData* root, uint32_t shard)
+{
+    root->shard = shard;
+
+    auto ids     = Vector<uint32_t>{ root->ids, data };
+    auto weights = Vector<double>{ root->weights, data };
+    auto rows    = JaggedVector<uint32_t>{ root->rows, data };
+
+    // • A free region between atoms is copied as it is
+    //
+    auto scratch = VectorRef<uint32_t>{ };
+
+    Vector<uint32_t>{ scratch, data }.reserve(64);
+
+    for ( auto index = uint32_t{ 0 }; index < 1000 * shard; ++index )
+    {
+        ids.push_back( shard * 100000 + index );
+        weights.push_back( shard + index * 0.5 );
+    }
+
+    for ( auto row = uint32_t{ 0 }; row < 50 * shard; ++row )
+    {
+        auto values = std::vector<uint32_t>( row % 7, shard + row );
+
+        rows.push_back(values);
+    }
+
+    detail::free( detail::allocation_header(scratch, data) );
+}
+
+void expect_shard(const ShardData& root, const Atom* data, uint32_t shard)
+{
+    EXPECT_EQ( root.shard, shard );
+
+    auto ids     = VectorView(root.ids, data);
+    auto weights = VectorView(root.weights, data);
+    auto offsets = VectorView(root.rows.offsets, data);
+    auto values  = VectorView(root.rows.values, data);
+
+    ASSERT_EQ( ids.size(), 1000 * shard );
+    ASSERT_EQ( weights.size(), 1000 * shard );
+
+    for ( auto index = uint32_t{ 0 }; index < ids.size(); ++index )
+    {
+        ASSERT_EQ( ids[index], shard * 100000 + index );
+        ASSERT_EQ( weights[index], shard + index * 0.5 );
+    }
+
+    ASSERT_EQ( offsets.size(), 0 == shard ? 0 : 50 * shard + 1 );
+
+    for ( auto row = uint32_t{ 0 }; row + 1 < offsets.size(); ++row )
+    {
+        ASSERT_EQ( offsets[row + 1] - offsets[row], row % 7 );
+
+        for ( auto value = offsets[row]; value < offsets[row + 1]; ++value ) {
+            ASSERT_EQ( values[value], shard + row );
+        }
+    }
+}
+
+} // namespace
+
+DATA_SCHEMA( ShardData, ids, weights, rows );
+
+TEST( merge, shards )
+{
+    try
+    {
+        auto pool = ThreadPool{ 4 };
+
+        // • Shards built in parallel, the first with no vectors at all
+        //
+        const auto shard_count  = uint32_t{ 6 };
+        const auto shard_length = uint32_t{ 1 << 18 };
+
+        auto shard_contents = std::vector<std::unique_ptr<uint8_t[]>>{ };
+        auto sources        = std::vector<const Atom*>( shard_count );
+
+        for ( auto shard = uint32_t{ 0 }; shard < shard_count; ++shard ) {
+            shard_contents.push_back( std::make_unique<uint8_t[]>(shard_length) );
+        }
+
+        {
+            auto group = TaskGroup{ pool };
+
+            for ( auto shard = uint32_t{ 0 }; shard < shard_count; ++shard )
+            {
+                group.run( [&, shard]()
+                {
+                    auto [data, root] = format_for_data<ShardData>(shard_contents[shard].get(), shard_length);
+
+                    build_shard(data, root, shard);
+
+                    sources[shard] = data;
+                });
+            }
+
+            group.wait();
+        }
+
+        // • Merged after an atom already in the target
+        //
+        auto contents_length = uint32_t{ 1 << 22 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<IngestData>(contents.get(), contents_length);
+
+        auto header = Vector<uint8_t>{ root->header, data };
+
+        header.assign({ 'i', 'n', 'g', 'e', 's', 't' });
+
+        auto roots = merge_buffers<ShardData>( pool, data, sources );
+
+        auto shards = Vector<ShardData>{ root->shards, data };
+
+        shards.assign( roots.begin(), roots.end() );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+        EXPECT_THAT( VectorView(root->header, data), ElementsAre( 'i', 'n', 'g', 'e', 's', 't' ) );
+
+        ASSERT_EQ( shards.size(), shard_count );
+
+        for ( auto shard = uint32_t{ 0 }; shard < shard_count; ++shard ) {
+            expect_shard( shards[shard], data, shard );
+        }
+
+        // • The rebased vectors are the atoms of the target
+        //
+        EXPECT_EQ( roots[0].ids.offset, 0 );
+        EXPECT_EQ( detail::allocation_header(roots[1].ids, data)->identifier, AtomID::vector );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
+
+TEST( merge, empty )
+{
+    try
+    {
+        auto pool = ThreadPool{ 2 };
+
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto source          = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root]     = format_for_data<IngestData>(contents.get(), contents_length);
+        auto [source_data, _] = format_for_data<ShardData>(source.get(), contents_length);
+
+        const auto sources = std::array<const Atom*, 1>{ source_data };
+
+        auto roots = merge_buffers<ShardData>( pool, data, sources );
+
+        ASSERT_EQ( roots.size(), 1 );
+        EXPECT_EQ( roots[0].ids.offset, 0 );
+
+        EXPECT_TRUE( merge_buffers<ShardData>( pool, data, { } ).empty() );
+
+        // • Untouched
+        //
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+        EXPECT_EQ( detail::next(data)->identifier, AtomID::free );
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,173 @@
+//
+//  TestMetalEmulation.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/BitVector.hpp>
+#include <Data/FlatMap.hpp>
+#include <Data/PackedIntVector.hpp>
+#include <Data/Vector.hpp>
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include <Data/MetalEmulation.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+using namespace ::data::emulation;
+
+//===------------------------------------------------------------------------===
+//
+// • Metal emulation tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct KernelData
+{
+    VectorRef<float>            inputs;
+    VectorRef<float>            outputs;
+    FlatMapRef<uint32_t, float> weights;
+    BitVectorRef                mask;
+    PackedIntVectorRef          codes;
+    VectorRef<uint32_t>         results;
+};
+
+// • Kernels as they are written for Metal, over the contents of the buffer
+//
+void scale_kernel(constant KernelData& root, device uint8_t* base, uint32_t gid)
+{
+    const device float* inputs  = contents(root.inputs, static_cast<const device uint8_t*>(base));
+    device float*       outputs = contents(root.outputs, base);
+
+    const device float* weight = find(root.weights, static_cast<const device uint8_t*>(base), gid % 16);
+
+    outputs[gid] = inputs[gid] * ( nullptr != weight ? *weight : 1.0f );
+}
+
+void rank_kernel(constant KernelData& root, device uint8_t* base, uint32_t gid)
+{
+    device uint32_t* results = contents(root.results, base);
+
+    results[gid] = test_bit(root.mask, base, gid)
+                 ? rank(root.mask, base, gid)
+                 : packed_value(root.codes, base, gid);
+}
+
+} // namespace
+
+TEST( metal_emulation, kernels )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 18 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<KernelData>(contents.get(), contents_length);
+
+        const auto count = uint32_t{ 3000 };
+
+        auto engine = std::mt19937{ 5 };
+
+        auto inputs  = Vector<float>{ root->inputs, data };
+        auto outputs = Vector<float>{ root->outputs, data };
+        auto weights = FlatMap<uint32_t, float>{ root->weights, data };
+        auto mask    = BitVector{ root->mask, data };
+        auto codes   = PackedIntVector{ root->codes, data };
+        auto results = Vector<uint32_t>{ root->results, data };
+
+        auto code_values = std::vector<uint32_t>( count );
+
+        for ( auto index = uint32_t{ 0 }; index < count; ++index )
+        {
+            inputs.push_back( static_cast<float>(index) );
+            mask.push_back( 0 == engine() % 3 );
+            code_values[index] = engine() % 1000;
+        }
+
+        for ( auto key = uint32_t{ 0 }; key < 16; key += 2 ) {
+            weights.insert_or_assign( key, 0.5f * key );
+        }
+
+        codes.append(code_values);
+        mask.build_rank_index();
+
+        outputs.resize_for_overwrite(count);
+        results.resize_for_overwrite(count);
+
+        // • Dispatched over the contents, as the device sees them
+        //
+        auto pool = ThreadPool{ 4 };
+        auto base = reinterpret_cast<device uint8_t*>(data);
+
+        dispatch_threads( pool, count, 64, [&](uint32_t gid) { scale_kernel(*root, base, gid); } );
+        dispatch_threads( pool, count, 32, [&](uint32_t gid) { rank_kernel(*root, base, gid); } );
+
+        for ( auto index = uint32_t{ 0 }; index < count; ++index )
+        {
+            const auto key    = index % 16;
+            const auto weight = ( 0 == key % 2 ) ? 0.5f * key : 1.0f;
+
+            ASSERT_EQ( outputs[index], index * weight ) << index;
+            ASSERT_EQ( results[index], mask.test(index) ? mask.rank(index) : code_values[index] ) << index;
+        }
+    }
+    catch (...)
+    {
+        FAIL();
+    }
+}
+
+TEST( metal_emulation, thread_positions )
+{
+    auto pool = ThreadPool{ 4 };
+
+    // • Every thread once, with a partial last threadgroup
+    //
+    auto positions = std::vector<ThreadPosition>( 1000 );
+    auto calls     = std::atomic<uint32_t>{ 0 };
+
+    dispatch_threads( pool, 1000, 64, [&](const ThreadPosition& position)
+    {
+        positions[position.thread_position_in_grid] = position;
+        ++calls;
+    });
+
+    EXPECT_EQ( calls, 1000 );
+
+    for ( auto thread = uint32_t{ 0 }; thread < positions.size(); ++thread )
+    {
+        ASSERT_EQ( positions[thread].thread_position_in_grid, thread );
+        ASSERT_EQ( positions[thread].thread_position_in_threadgroup, thread % 64 );
+        ASSERT_EQ( positions[thread].threadgroup_position_in_grid, thread / 64 );
+    }
+
+    // • Empty grids run nothing, and exceptions reach the caller
+    //
+    dispatch_threads( pool, 0, 64, [&](uint32_t ) { ++calls; } );
+
+    EXPECT_EQ( calls, 1000 );
+
+    EXPECT_THROW( dispatch_threads( pool, 1000, 0, [](uint32_t ) { } ), bool );
+    EXPECT_THROW( dispatch_threads( pool, 1000, 10, [](uint32_t gid) { if ( 777 == gid ) throw false; } ), bool );
+}
@@ -0,0 +1,135 @@
+//
+//  TestPack.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Pack.hpp>
+#include <Data/Vector.hpp>
+
+#include <fstream>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Pack tests
+//
+//===------------------------------------------------------------------------===
+
+TEST( pack, write_and_map )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 256 };
+        auto first           = std::make_unique<uint8_t[]>(contents_length);
+        auto second          = std::make_unique<uint8_t[]>(2*contents_length);
+
+        auto [first_data, first_root] = format_for_data<VectorRef<int>>(first.get(), contents_length);
+        auto [second_data, second_root] = format_for_data<VectorRef<int>>(second.get(), 2*contents_length);
+
+        ASSERT_NO_THROW( make_vector(*first_root, first_data).assign({ 1, 2, 3 }) );
+        ASSERT_NO_THROW( make_vector(*second_root, second_data).assign({ 4, 5, 6, 7 }) );
+
+        const auto sources = std::array<PackSource, 2> { {
+            { .key = 72, .contents = second.get(), .contents_length = 2*contents_length },
+            { .key = 17, .contents = first.get(),  .contents_length = contents_length   },
+        } };
+
+        const auto path = ::testing::TempDir() + "TestPack.pack";
+
+        ASSERT_NO_THROW( write_pack(path.c_str(), sources) );
+
+        auto pack = Pack{ path.c_str() };
+
+        EXPECT_EQ( pack.size(), 2 );
+        EXPECT_EQ( pack.entries()[0].key, 17 );
+        EXPECT_EQ( pack.entries()[1].key, 72 );
+        EXPECT_EQ( nullptr, pack.find(18) );
+
+        EXPECT_TRUE( pack.validate_layout(17) );
+        EXPECT_TRUE( pack.validate_layout(72) );
+        EXPECT_FALSE( pack.validate_layout(18) );
+
+        // • Buffers are read in place
+        //
+        auto entry = pack.find(72);
+
+        ASSERT_NE( nullptr, entry );
+        EXPECT_TRUE( is_aligned(pack.contents(*entry)) );
+        EXPECT_EQ( 0, std::memcmp(pack.contents(*entry), second.get(), entry->length) );
+
+        auto data = pack.data_atom(72);
+        auto root = detail::contents<VectorRef<int>>(data);
+        auto ints = detail::offset_by<int>(data, root->offset);
+
+        EXPECT_EQ( root->count, 4 );
+        EXPECT_EQ( ints[0], 4 );
+        EXPECT_EQ( ints[3], 7 );
+
+        EXPECT_THROW( pack.data_atom(18), bool );
+
+        std::remove( path.c_str() );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( pack, invalid )
+{
+    auto contents_length = uint32_t{ 64 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    ASSERT_NO_THROW( format(contents.get(), contents_length) );
+
+    const auto path = ::testing::TempDir() + "TestPackInvalid.pack";
+
+    // • Duplicate keys
+    //
+    const auto duplicates = std::array<PackSource, 2> { {
+        { .key = 1, .contents = contents.get(), .contents_length = contents_length },
+        { .key = 1, .contents = contents.get(), .contents_length = contents_length },
+    } };
+
+    EXPECT_THROW( write_pack(path.c_str(), duplicates), bool );
+
+    // • Truncated pack
+    //
+    const auto unique = std::array<PackSource, 1> { {
+        { .key = 1, .contents = contents.get(), .contents_length = contents_length },
+    } };
+
+    ASSERT_NO_THROW( write_pack(path.c_str(), unique) );
+
+    auto file = std::ifstream( path, std::ios::binary );
+    auto pack = std::vector<uint8_t>( std::istreambuf_iterator<char>(file), {} );
+
+    EXPECT_EQ( pack.size(), 16 + 32 + contents_length );
+
+    auto truncated = std::make_unique<uint8_t[]>( pack.size() );
+
+    std::memcpy( truncated.get(), pack.data(), pack.size() );
+
+    EXPECT_NO_THROW( Pack(truncated.get(), pack.size()) );
+    EXPECT_THROW( Pack(truncated.get(), pack.size() - 16), bool );
+
+    std::remove( path.c_str() );
+}
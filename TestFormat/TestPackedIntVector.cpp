@@ -0,0 +1,210 @@
+//
+//  TestPackedIntVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/PackedIntVector.hpp>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • PackedIntVector tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct ColumnData
+{
+    PackedIntVectorRef  values;
+};
+
+void expect_values(const PackedIntVector& packed, const std::vector<uint32_t>& expected)
+{
+    ASSERT_EQ( packed.size(), expected.size() );
+
+    auto decoded = std::vector<uint32_t>( expected.size() );
+
+    packed.decode(decoded);
+
+    EXPECT_EQ( decoded, expected );
+
+    for ( auto index = uint32_t{ 0 }; index < expected.size(); ++index ) {
+        ASSERT_EQ( packed[index], expected[index] ) << index;
+    }
+}
+
+} // namespace
+
+TEST( packed_int_vector, widths )
+{
+    auto engine = std::mt19937{ 1 };
+
+    // • Every width, for frame of reference and for delta blocks
+    //
+    for ( auto width = uint32_t{ 0 }; width <= 32; ++width )
+    {
+        const auto max   = ( 32 == width ) ? ~uint32_t{ 0 } : ( uint32_t{ 1 } << width ) - 1;
+        auto dist        = std::uniform_int_distribution<uint32_t>{ 0, max };
+        auto values      = std::vector<uint32_t>( 128 );
+        auto words       = std::vector<uint32_t>( 128 );
+        auto unpacked    = std::vector<uint32_t>( 128 );
+
+        for ( auto& value : values ) {
+            value = 1000 + dist(engine);
+        }
+
+        values[7] = 1000;
+        values[9] = 1000 + max;
+
+        auto block = detail::pack_block(values.data(), 128, words.data());
+
+        EXPECT_EQ( block.encoding, PackedEncoding::frame );
+        EXPECT_EQ( block.width, width );
+
+        detail::unpack_block(block, words.data(), unpacked.data());
+
+        EXPECT_EQ( unpacked, values ) << width;
+
+        for ( auto index = uint32_t{ 0 }; index < 128; ++index ) {
+            ASSERT_EQ( detail::packed_value(block, words.data(), index), values[index] );
+        }
+
+        if ( 32 <= width ) {
+            continue;
+        }
+
+        auto sum = uint32_t{ 0 };
+
+        for ( auto& value : values ) {
+            value = ( sum += std::min<uint32_t>(dist(engine), 0x3fff'ffff / 128) );
+        }
+
+        block = detail::pack_block(values.data(), 128, words.data());
+
+        detail::unpack_block(block, words.data(), unpacked.data());
+
+        EXPECT_EQ( unpacked, values ) << width;
+        EXPECT_EQ( detail::packed_value(block, words.data(), 127), values[127] );
+    }
+}
+
+TEST( packed_int_vector, append )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 18 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<ColumnData>(contents.get(), contents_length);
+
+        auto packed   = PackedIntVector{ root->values, data };
+        auto expected = std::vector<uint32_t>{ };
+
+        EXPECT_TRUE( packed.empty() );
+
+        // • Timestamps, appended in batches that split blocks
+        //
+        auto engine    = std::mt19937{ 2 };
+        auto dist      = std::uniform_int_distribution<uint32_t>{ 0, 30 };
+        auto timestamp = uint32_t{ 1'700'000'000 };
+
+        for ( auto batch : { 1, 50, 77, 128, 300, 1, 1000 } )
+        {
+            auto values = std::vector<uint32_t>( batch );
+
+            for ( auto& value : values ) {
+                value = ( timestamp += dist(engine) );
+            }
+
+            ASSERT_NO_THROW( packed.append(values) );
+
+            expected.insert( expected.end(), values.begin(), values.end() );
+
+            expect_values(packed, expected);
+        }
+
+        EXPECT_EQ( packed.block_count(), 13 );
+        EXPECT_TRUE( std::all_of( packed.blocks().begin(), packed.blocks().end(), [](const auto& block) {
+            return PackedEncoding::delta == block.encoding;
+        }));
+
+        // • About 1 byte per value, against 4
+        //
+        EXPECT_LT( packed.packed_length() * 3, expected.size() * sizeof(uint32_t) );
+
+        auto sum = uint64_t{ 0 };
+
+        packed.for_each_block( [&](auto values, auto first) {
+            EXPECT_EQ( values.size(), std::min<size_t>(128, expected.size() - first) );
+
+            for ( auto value : values ) {
+                sum += value;
+            }
+        });
+
+        EXPECT_EQ( sum, std::accumulate( expected.begin(), expected.end(), uint64_t{ 0 } ) );
+
+        // • Reopened from the buffer
+        //
+        auto reopened = PackedIntVector{ root->values, data };
+
+        expect_values(reopened, expected);
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        ASSERT_NO_THROW( packed.assign( std::vector<uint32_t>( 200, 7 ) ) );
+
+        EXPECT_EQ( packed.size(), 200 );
+        EXPECT_EQ( packed.packed_length(), 2 * sizeof(PackedBlock) );
+        EXPECT_EQ( packed[199], 7 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( packed_int_vector, validation )
+{
+    auto contents_length = uint32_t{ 1 << 16 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<ColumnData>(contents.get(), contents_length);
+
+    {
+        auto packed = PackedIntVector{ root->values, data };
+
+        packed.append( std::vector<uint32_t>{ 5, 1, 9, 3 } );
+    }
+
+    EXPECT_EQ( root->values.blocks.count, 1 );
+    EXPECT_EQ( root->values.words.count, 16 );
+
+    root->values.count = 129;
+
+    EXPECT_THROW( PackedIntVector( root->values, data ), bool );
+}
@@ -0,0 +1,191 @@
+//
+//  TestParallel.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Parallel.hpp>
+
+#include <random>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadPool tests
+//
+//===------------------------------------------------------------------------===
+
+TEST( thread_pool, task_group )
+{
+    auto pool  = ThreadPool{ 4 };
+    auto count = std::atomic<uint32_t>{ 0 };
+
+    EXPECT_EQ( pool.size(), 4 );
+
+    // • Nested groups, waited for from within tasks
+    //
+    auto group = TaskGroup{ pool };
+
+    for ( auto task = 0; task < 16; ++task )
+    {
+        group.run( [&]()
+        {
+            auto nested = TaskGroup{ pool };
+
+            for ( auto nested_task = 0; nested_task < 16; ++nested_task ) {
+                nested.run( [&]() { ++count; } );
+            }
+
+            nested.wait();
+        });
+    }
+
+    ASSERT_NO_THROW( group.wait() );
+    EXPECT_EQ( count, 256 );
+
+    // • Exceptions are rethrown by wait
+    //
+    group.run( []() { throw false; } );
+    group.run( [&]() { ++count; } );
+
+    EXPECT_THROW( group.wait(), bool );
+    EXPECT_EQ( count, 257 );
+}
+
+//===------------------------------------------------------------------------===
+//
+// • Parallel algorithm tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+std::vector<uint32_t> make_values(uint32_t count)
+{
+    auto engine = std::mt19937{ count };
+    auto values = std::vector<uint32_t>( count );
+
+    for ( auto& value : values ) {
+        value = engine();
+    }
+
+    return values;
+}
+
+} // namespace
+
+TEST( parallel, partition )
+{
+    alignas(64) static uint32_t values[100003];
+
+    const auto partition = parallel::detail::partition( values + 3, 100000, 4 );
+
+    EXPECT_LT( 1, partition.chunks );
+    EXPECT_EQ( partition.end(partition.chunks - 1), 100000 );
+
+    // • Every chunk but the first begins on a cache line
+    //
+    for ( auto chunk = size_t{ 1 }; chunk < partition.chunks; ++chunk )
+    {
+        EXPECT_LT( partition.begin(chunk), partition.end(chunk) );
+        EXPECT_EQ( reinterpret_cast<uintptr_t>(values + 3 + partition.begin(chunk)) % 64, 0 );
+    }
+}
+
+TEST( parallel, algorithms )
+{
+    auto pool = ThreadPool{ 4 };
+
+    for ( auto count : { 0u, 1u, 1000u, 100003u, 1u << 20 } )
+    {
+        auto values = make_values(count);
+
+        // • for_each and transform
+        //
+        auto expected = values;
+
+        std::transform( expected.begin(), expected.end(), expected.begin(), [](auto value) { return value ^ 0x5a5a5a5a; } );
+
+        auto actual = values;
+
+        parallel::for_each( pool, actual, [](auto& value) { value ^= 0x5a5a5a5a; } );
+
+        EXPECT_EQ( actual, expected );
+
+        parallel::transform( pool, values, actual, [](auto value) { return value ^ 0x5a5a5a5a; } );
+
+        EXPECT_EQ( actual, expected );
+
+        // • reduce and inclusive_scan
+        //
+        EXPECT_EQ( parallel::reduce(pool, values, uint64_t{ 7 }),
+                   std::accumulate(values.begin(), values.end(), uint64_t{ 7 }) );
+
+        std::inclusive_scan( values.begin(), values.end(), expected.begin() );
+        parallel::inclusive_scan( pool, values, actual );
+
+        EXPECT_EQ( actual, expected );
+
+        // • sort
+        //
+        expected = values;
+        actual   = values;
+
+        std::sort( expected.begin(), expected.end(), std::greater<>{ } );
+        parallel::sort( pool, actual, std::greater<>{ } );
+
+        EXPECT_EQ( actual, expected );
+    }
+}
+
+TEST( parallel, vector_contents )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 22 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto data            = data::format(contents.get(), contents_length);
+
+        auto ref    = VectorRef<float>{ };
+        auto vector = Vector<float>{ ref, data };
+
+        auto values = make_values(500000);
+
+        for ( auto value : values ) {
+            vector.push_back( static_cast<float>(value % 1000) );
+        }
+
+        auto& pool = ThreadPool::shared();
+
+        parallel::sort( pool, contents_of(ref, data) );
+
+        EXPECT_TRUE( std::is_sorted(vector.begin(), vector.end()) );
+
+        parallel::for_each( pool, vector, [](auto& value) { value *= 0.5f; } );
+
+        EXPECT_EQ( parallel::reduce(pool, vector, 0.0), std::accumulate(vector.begin(), vector.end(), 0.0) );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
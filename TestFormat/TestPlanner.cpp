@@ -0,0 +1,115 @@
+//
+//  TestPlanner.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/JaggedVector.hpp>
+#include <Data/Planner.hpp>
+
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Planner tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct TrackData
+{
+    uint32_t                    frame_count;
+    VectorRef<double>           times;
+    VectorRef<uint8_t>          flags;
+    JaggedVectorRef<uint32_t>   points;
+    VectorRef<float>            unused;
+};
+
+} // namespace
+
+DATA_SCHEMA( TrackData, times, flags, points, unused );
+
+// • Planned at compile time
+//
+static_assert( 16 + 48 + 16 == plan_length<TrackData>({ 0, 0, 0, 0, 0 }) );
+static_assert( 16 + 48 + ( 16 + 80 ) + ( 16 + 16 ) + 16 == plan_length<TrackData>({ 10, 3, 0, 0, 0 }) );
+
+TEST( planner, format_planned )
+{
+    try
+    {
+        const auto counts = VectorCounts<TrackData>{ 100, 7, 11, 60, 0 };
+        const auto length = plan_length<TrackData>(counts);
+
+        EXPECT_EQ( length, 16 + 48 + ( 16 + 800 ) + ( 16 + 16 ) + ( 16 + 48 ) + ( 16 + 240 ) + 16 );
+
+        auto contents = std::make_unique<uint8_t[]>(length);
+
+        auto [data, root] = format_planned<TrackData>(contents.get(), length, counts);
+
+        EXPECT_TRUE( validate_layout(contents.get(), length) );
+        EXPECT_TRUE( validate_vectors<TrackData>(data) );
+
+        // • Every atom is in use
+        //
+        for ( auto atom = detail::next(data); !detail::is_end(atom); atom = detail::next(atom) ) {
+            EXPECT_EQ( atom->identifier, AtomID::vector );
+        }
+
+        EXPECT_EQ( root->times.count, 100 );
+        EXPECT_EQ( root->points.values.count, 60 );
+        EXPECT_TRUE( detail::is_null(root->unused) );
+
+        auto times = Vector<double>{ root->times, data };
+
+        EXPECT_EQ( times.capacity(), 100 );
+        EXPECT_EQ( times[99], 0.0 );
+
+        // • Filled in place
+        //
+        auto offsets = Vector<uint32_t>{ root->points.offsets, data };
+
+        for ( auto index = uint32_t{ 0 }; index < offsets.size(); ++index ) {
+            offsets[index] = 6 * index;
+        }
+
+        auto points = JaggedVector<uint32_t>{ root->points, data };
+
+        EXPECT_EQ( points.size(), 10 );
+        EXPECT_EQ( points[9].size(), 6 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( planner, length_mismatch )
+{
+    const auto counts = VectorCounts<TrackData>{ 1, 1, 0, 0, 0 };
+    const auto length = plan_length<TrackData>(counts) + 16;
+
+    auto contents = std::make_unique<uint8_t[]>(length);
+
+    EXPECT_THROW( format_planned<TrackData>(contents.get(), length, counts), bool );
+}
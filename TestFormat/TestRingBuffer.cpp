@@ -0,0 +1,247 @@
+//
+//  TestRingBuffer.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/RingBuffer.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • RingBuffer tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct Frame
+{
+    uint64_t    sequence;
+    float       samples[6];
+};
+
+struct StreamData
+{
+    RingBufferRef<uint32_t>     values;
+    RingBufferRef<Frame>        frames;
+};
+
+} // namespace
+
+TEST( ring_buffer, format )
+{
+    auto contents_length = uint32_t{ 1 << 16 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<StreamData>(contents.get(), contents_length);
+
+    EXPECT_THROW( format_ring(root->values, data, 12), bool );
+    EXPECT_THROW( RingProducer<uint32_t>( root->values, data ), bool );
+
+    ASSERT_NO_THROW( format_ring(root->values, data, 16) );
+
+    EXPECT_EQ( root->values.capacity, 16 );
+    EXPECT_THROW( format_ring(root->values, data, 16), bool );
+    EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+}
+
+TEST( ring_buffer, copying )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<StreamData>(contents.get(), contents_length);
+
+        format_ring(root->values, data, 8);
+
+        auto producer = RingProducer<uint32_t>{ root->values, data };
+        auto consumer = RingConsumer<uint32_t>{ root->values, data };
+
+        EXPECT_EQ( producer.available(), 8 );
+        EXPECT_EQ( consumer.available(), 0 );
+
+        auto value = uint32_t{ 0 };
+
+        EXPECT_FALSE( consumer.try_pop(value) );
+
+        const auto values = std::vector<uint32_t>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+        EXPECT_EQ( producer.push( std::span{ values }.first(6) ), 6 );
+
+        auto read = std::vector<uint32_t>( 4 );
+
+        EXPECT_EQ( consumer.pop(read), 4 );
+        EXPECT_THAT( read, ElementsAre(1, 2, 3, 4) );
+
+        // • Writes and reads that wrap around the end of the ring
+        //
+        EXPECT_EQ( producer.push( std::span{ values }.subspan(6) ), 4 );
+        EXPECT_EQ( producer.push( std::span{ values }.first(3) ), 2 );
+        EXPECT_FALSE( producer.try_push(0) );
+        EXPECT_EQ( consumer.available(), 8 );
+
+        read.resize(10);
+
+        EXPECT_EQ( consumer.pop(read), 8 );
+        EXPECT_THAT( std::vector( read.begin(), read.begin() + 8 ), ElementsAre(5, 6, 7, 8, 9, 10, 1, 2) );
+
+        EXPECT_TRUE( producer.try_push(11) );
+        EXPECT_TRUE( consumer.try_pop(value) );
+        EXPECT_EQ( value, 11 );
+
+        // • A reopened side continues from the indices in the buffer
+        //
+        EXPECT_EQ( root->values.capacity, RingConsumer<uint32_t>( root->values, data ).capacity() );
+        EXPECT_EQ( RingConsumer<uint32_t>( root->values, data ).available(), 0 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( ring_buffer, in_place )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<StreamData>(contents.get(), contents_length);
+
+        format_ring(root->frames, data, 4);
+
+        auto producer = RingProducer<Frame>{ root->frames, data };
+        auto consumer = RingConsumer<Frame>{ root->frames, data };
+
+        auto frames = producer.prepare(3);
+
+        ASSERT_EQ( frames.size(), 3 );
+
+        for ( auto index = uint64_t{ 0 }; index < 3; ++index ) {
+            frames[index].sequence = index;
+        }
+
+        // • Nothing is visible until it is committed
+        //
+        EXPECT_TRUE( consumer.peek(3).empty() );
+
+        producer.commit(3);
+
+        EXPECT_EQ( consumer.peek(2).size(), 2 );
+        EXPECT_EQ( consumer.peek(2)[1].sequence, 1 );
+
+        consumer.release(2);
+
+        // • The free space wraps, so only the part before the end is returned
+        //
+        EXPECT_EQ( producer.prepare(3).size(), 1 );
+
+        producer.prepare(1)[0].sequence = 3;
+        producer.commit(1);
+
+        EXPECT_EQ( producer.prepare(3).size(), 2 );
+
+        const auto available = consumer.peek(4);
+
+        ASSERT_EQ( available.size(), 2 );
+        EXPECT_EQ( available[0].sequence, 2 );
+        EXPECT_EQ( available[1].sequence, 3 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( ring_buffer, threads )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<StreamData>(contents.get(), contents_length);
+
+        format_ring(root->values, data, 256);
+
+        constexpr auto count = uint32_t{ 1'000'000 };
+
+        auto producer = std::thread{ [&, data = data, root = root]{
+            auto ring  = RingProducer<uint32_t>{ root->values, data };
+            auto batch = std::vector<uint32_t>( 100 );
+
+            for ( auto next = uint32_t{ 0 }; next < count; )
+            {
+                auto length = std::min<uint32_t>(100, count - next);
+
+                for ( auto index = uint32_t{ 0 }; index < length; ++index ) {
+                    batch[index] = next + index;
+                }
+
+                auto pushed = std::span{ batch }.first(length);
+
+                while ( !pushed.empty() )
+                {
+                    pushed = pushed.subspan( ring.push(pushed) );
+
+                    std::this_thread::yield();
+                }
+
+                next += length;
+            }
+        }};
+
+        auto ring     = RingConsumer<uint32_t>{ root->values, data };
+        auto expected = uint32_t{ 0 };
+        auto ordered  = true;
+
+        while ( expected < count )
+        {
+            auto values = ring.peek(64);
+
+            for ( auto value : values ) {
+                ordered = ordered && value == expected++;
+            }
+
+            ring.release( static_cast<uint32_t>(values.size()) );
+
+            if ( values.empty() ) {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+
+        EXPECT_TRUE( ordered );
+        EXPECT_EQ( ring.available(), 0 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
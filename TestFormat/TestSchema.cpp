@@ -0,0 +1,167 @@
+//
+//  TestSchema.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Schema.hpp>
+#include <Data/StringPool.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Schema tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct Mesh
+{
+    VectorRef<float>        positions;
+    uint32_t                flags;
+    VectorRef<uint16_t>     indices;
+};
+
+struct SceneData
+{
+    uint32_t                    version;
+    VectorRef<double>           times;
+    Mesh                        meshes[2];
+    JaggedVectorRef<uint32_t>   edges;
+    StringPoolRef               names;
+};
+
+struct SceneDataV2
+{
+    uint32_t                    version;
+    VectorRef<double>           times;
+    Mesh                        meshes[2];
+    JaggedVectorRef<uint64_t>   edges;
+    StringPoolRef               names;
+};
+
+struct Samples
+{
+    SegmentedVectorRef<float>   values;
+};
+
+struct SamplesV2
+{
+    SegmentedVectorRef<double>  values;
+};
+
+struct Plain
+{
+    uint32_t    count;
+};
+
+} // namespace
+
+DATA_SCHEMA( Mesh, positions, indices );
+DATA_SCHEMA( SceneData, times, meshes, edges, names );
+DATA_SCHEMA( SceneDataV2, times, meshes, edges, names );
+DATA_SCHEMA( Samples, values );
+DATA_SCHEMA( SamplesV2, values );
+
+static_assert( HasSchema<SceneData> );
+static_assert( !HasSchema<Plain> );
+
+static_assert( 10 == vector_fields<SceneData>.size() );
+static_assert( layout_hash<SceneData> == layout_hash<SceneData> );
+static_assert( layout_hash<SceneData> != layout_hash<SceneDataV2> );
+static_assert( layout_hash<Mesh> != layout_hash<SceneData> );
+
+// • The chunks of a segmented vector are not a listed VectorRef, but their
+//   element type is still hashed
+//
+static_assert( 1 == vector_fields<Samples>.size() );
+static_assert( layout_hash<Samples> != layout_hash<SamplesV2> );
+
+TEST( schema, vector_fields )
+{
+    const auto& fields = vector_fields<SceneData>;
+
+    auto offsets = std::vector<uint32_t>{ };
+    auto sizes   = std::vector<uint32_t>{ };
+
+    for ( const auto& field : fields )
+    {
+        offsets.push_back(field.offset);
+        sizes.push_back(field.element_size);
+    }
+
+    const auto meshes = offsetof(SceneData, meshes);
+    const auto edges  = offsetof(SceneData, edges);
+    const auto names  = offsetof(SceneData, names);
+
+    EXPECT_THAT( offsets, ElementsAre( offsetof(SceneData, times),
+                                       meshes + offsetof(Mesh, positions),
+                                       meshes + offsetof(Mesh, indices),
+                                       meshes + sizeof(Mesh) + offsetof(Mesh, positions),
+                                       meshes + sizeof(Mesh) + offsetof(Mesh, indices),
+                                       edges + offsetof(JaggedVectorRef<uint32_t>, offsets),
+                                       edges + offsetof(JaggedVectorRef<uint32_t>, values),
+                                       names + offsetof(StringPoolRef, bytes),
+                                       names + offsetof(StringPoolRef, ends),
+                                       names + offsetof(StringPoolRef, index) ) );
+
+    EXPECT_THAT( sizes, ElementsAre(8, 4, 2, 4, 2, 4, 4, 1, 4, sizeof(StringSlot)) );
+    EXPECT_EQ( fields[0].alignment, alignof(double) );
+}
+
+TEST( schema, validate_vectors )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 14 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<SceneData>(contents.get(), contents_length);
+
+        EXPECT_TRUE( validate_vectors<SceneData>(data) );
+
+        auto indices = Vector<uint16_t>{ root->meshes[1].indices, data };
+
+        indices.assign({ 0, 1, 2, 2, 1, 3 });
+
+        auto names = StringPool{ root->names, data };
+
+        names.intern("origin");
+
+        EXPECT_TRUE( validate_vectors<SceneData>(data) );
+
+        const auto& field = vector_fields<SceneData>[4];
+
+        EXPECT_EQ( vector_at(root, field).offset, root->meshes[1].indices.offset );
+        EXPECT_EQ( vector_at(root, field).count, 6 );
+
+        // • A count past the end of the atom is found
+        //
+        root->meshes[1].indices.count = 1000;
+
+        EXPECT_FALSE( validate_vectors<SceneData>(data) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,184 @@
+//
+//  TestSegmentedVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/SegmentedVector.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • SegmentedVector tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct SampleData
+{
+    SegmentedVectorRef<uint32_t>    samples;
+};
+
+static_assert( std::random_access_iterator<SegmentedVector<uint32_t>::iterator> );
+static_assert( std::random_access_iterator<SegmentedVector<uint32_t>::const_iterator> );
+
+} // namespace
+
+TEST( segmented_vector, growth )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<SampleData>(contents.get(), contents_length);
+
+        auto samples = SegmentedVector<uint32_t>{ root->samples, data, 64 };
+
+        EXPECT_TRUE( samples.empty() );
+        EXPECT_EQ( samples.chunk_length(), 64 );
+        EXPECT_EQ( root->samples.shift, 6 );
+
+        ASSERT_NO_THROW( samples.push_back(0) );
+
+        const auto first = &samples.front();
+
+        for ( auto value = uint32_t{ 1 }; value < 1000; ++value ) {
+            ASSERT_NO_THROW( samples.push_back(value) );
+        }
+
+        // • Elements never move as the vector grows
+        //
+        EXPECT_EQ( &samples.front(), first );
+        EXPECT_EQ( samples.size(), 1000 );
+        EXPECT_EQ( samples.chunk_count(), 16 );
+        EXPECT_EQ( samples.capacity(), 1024 );
+
+        for ( auto index = uint32_t{ 0 }; index < 1000; ++index ) {
+            ASSERT_EQ( samples[index], index );
+        }
+
+        EXPECT_EQ( samples.chunk(15).size(), 1000 - 15 * 64 );
+        EXPECT_EQ( samples.chunk(3).front(), 3 * 64 );
+
+        const auto values = std::vector<uint32_t>( 200, 7 );
+
+        ASSERT_NO_THROW( samples.append(values) );
+
+        EXPECT_EQ( samples.size(), 1200 );
+        EXPECT_EQ( samples[999], 999 );
+        EXPECT_EQ( samples[1000], 7 );
+        EXPECT_EQ( samples.back(), 7 );
+        EXPECT_EQ( &samples.front(), first );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+
+        // • Reopened with the chunk length in the buffer
+        //
+        auto reopened = SegmentedVector<uint32_t>{ root->samples, data };
+
+        EXPECT_EQ( reopened.chunk_length(), 64 );
+        EXPECT_EQ( reopened[500], 500 );
+        EXPECT_THROW( SegmentedVector<uint32_t>( root->samples, data, 128 ), bool );
+
+        // • A corrupt shift is rejected before it is used
+        //
+        for ( auto shift : { 30u, 32u, 200u } )
+        {
+            auto corrupt = root->samples;
+
+            corrupt.shift = shift;
+
+            EXPECT_THROW( SegmentedVector<uint32_t>( corrupt, data ), bool );
+        }
+
+        // • Chunks are kept on clear and freed on shrink_to_fit
+        //
+        samples.resize(100);
+        samples.shrink_to_fit();
+
+        EXPECT_EQ( samples.chunk_count(), 2 );
+        EXPECT_EQ( samples[99], 99 );
+
+        samples.clear();
+
+        EXPECT_EQ( samples.chunk_count(), 2 );
+
+        samples.shrink_to_fit();
+
+        EXPECT_EQ( samples.chunk_count(), 0 );
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( segmented_vector, iterators )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<SampleData>(contents.get(), contents_length);
+
+        auto samples = SegmentedVector<uint32_t>{ root->samples, data, 16 };
+
+        ASSERT_NO_THROW( samples.resize(100) );
+
+        EXPECT_TRUE( std::all_of( samples.begin(), samples.end(), [](auto value) { return 0 == value; } ) );
+
+        std::iota( samples.begin(), samples.end(), 0 );
+        std::reverse( samples.begin(), samples.end() );
+
+        EXPECT_EQ( samples[0], 99 );
+        EXPECT_EQ( samples[99], 0 );
+
+        std::sort( samples.begin(), samples.end() );
+
+        auto expected = std::vector<uint32_t>( 100 );
+
+        std::iota( expected.begin(), expected.end(), 0 );
+
+        EXPECT_TRUE( std::ranges::equal(samples, expected) );
+        EXPECT_EQ( std::accumulate( samples.cbegin(), samples.cend(), 0u ), 4950 );
+
+        const auto& const_samples = samples;
+
+        auto it = std::lower_bound( const_samples.begin(), const_samples.end(), 42u );
+
+        EXPECT_EQ( it - const_samples.begin(), 42 );
+        EXPECT_EQ( it[16], 58 );
+        EXPECT_EQ( *( it - 40 ), 2 );
+        EXPECT_EQ( SegmentedVector<uint32_t>::const_iterator{ samples.end() }, const_samples.end() );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -0,0 +1,153 @@
+//
+//  TestSoAVector.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Algorithm.hpp>
+#include <Data/SoAVector.hpp>
+
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • SoAVector tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct Particle
+{
+    float       mass;
+    uint32_t    flags;
+    double      energy;
+};
+
+struct ParticleData
+{
+    ColumnsRef<3>   particles;
+};
+
+bool operator == (const Particle& lhs, const Particle& rhs)
+{
+    return lhs.mass == rhs.mass && lhs.flags == rhs.flags && lhs.energy == rhs.energy;
+}
+
+} // namespace
+
+static_assert( 3 == field_count<Particle>, "Unexpected field count" );
+static_assert( std::is_same_v<double, field_type<Particle, 2>>, "Unexpected field type" );
+
+TEST( soa_vector, append )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<ParticleData>(contents.get(), contents_length);
+
+        auto particles = SoAVector<Particle>{ root->particles, data };
+
+        EXPECT_TRUE( particles.empty() );
+        EXPECT_EQ( particles.capacity(), 0 );
+
+        auto records = std::vector<Particle>{ };
+
+        for ( auto index = uint32_t{ 0 }; index < 100; ++index ) {
+            records.push_back({ .mass = 0.5f * index, .flags = index, .energy = 2.0 * index });
+        }
+
+        ASSERT_NO_THROW( particles.push_back(records[0]) );
+        ASSERT_NO_THROW( particles.append( std::span{ records }.subspan(1) ) );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+        EXPECT_EQ( particles.size(), 100 );
+        EXPECT_LE( particles.size(), particles.capacity() );
+
+        for ( auto index = uint32_t{ 0 }; index < 100; ++index )
+        {
+            EXPECT_EQ( particles.load(index), records[index] );
+            EXPECT_EQ( particles.column<0>()[index], records[index].mass );
+            EXPECT_EQ( particles.column<1>()[index], records[index].flags );
+            EXPECT_EQ( particles.column<2>()[index], records[index].energy );
+        }
+
+        // • Each column is a 'vctr' atom addressed from the root
+        //
+        const auto stored = contents_of( column<uint32_t>(root->particles, 1), data );
+
+        EXPECT_THAT( std::vector( stored.begin(), stored.end() ), ElementsAreArray( particles.column<1>() ) );
+        EXPECT_EQ( data::sum( particles.column<1>() ), 4950 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( soa_vector, rows )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 16 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<ParticleData>(contents.get(), contents_length);
+
+        auto particles = SoAVector<Particle>{ root->particles, data };
+
+        ASSERT_NO_THROW( particles.resize(4) );
+
+        EXPECT_EQ( particles.size(), 4 );
+        EXPECT_EQ( particles.load(3), Particle{ } );
+
+        particles[1] = Particle{ .mass = 1.0f, .flags = 7, .energy = 3.0 };
+        particles[2].get<1>() = 9;
+
+        EXPECT_EQ( static_cast<Particle>(particles[1]), ( Particle{ .mass = 1.0f, .flags = 7, .energy = 3.0 } ) );
+        EXPECT_THAT( std::vector( particles.column<1>().begin(), particles.column<1>().end() ), ElementsAre(0, 7, 9, 0) );
+
+        particles.pop_back();
+
+        EXPECT_EQ( particles.size(), 3 );
+
+        // • Reserving relocates every column with the contents intact
+        //
+        ASSERT_NO_THROW( particles.reserve(1000) );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+        EXPECT_GE( particles.capacity(), 1000 );
+        EXPECT_THAT( std::vector( particles.column<1>().begin(), particles.column<1>().end() ), ElementsAre(0, 7, 9) );
+        EXPECT_THAT( std::vector( particles.column<2>().begin(), particles.column<2>().end() ), ElementsAre(0.0, 3.0, 0.0) );
+
+        particles.clear();
+
+        EXPECT_TRUE( particles.empty() );
+        EXPECT_GE( particles.capacity(), 1000 );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
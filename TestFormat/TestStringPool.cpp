@@ -0,0 +1,144 @@
+//
+//  TestStringPool.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/StringPool.hpp>
+
+#include <string>
+#include <unordered_map>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • StringPool tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct LabelData
+{
+    StringPoolRef       labels;
+    VectorRef<uint32_t> values;
+};
+
+} // namespace
+
+TEST( string_pool, intern )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 18 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<LabelData>(contents.get(), contents_length);
+
+        auto pool = StringPool{ root->labels, data };
+
+        EXPECT_TRUE( pool.empty() );
+        EXPECT_FALSE( pool.find("a").has_value() );
+
+        const auto alpha = pool.intern("alpha");
+        const auto empty = pool.intern("");
+        const auto beta  = pool.intern("beta");
+
+        EXPECT_EQ( pool.intern("alpha"), alpha );
+        EXPECT_EQ( pool.intern(""), empty );
+        EXPECT_NE( alpha, beta );
+        EXPECT_EQ( pool[alpha], "alpha" );
+        EXPECT_EQ( pool[empty], "" );
+        EXPECT_EQ( pool[beta], "beta" );
+        EXPECT_EQ( pool.size(), 3 );
+
+        // • Enough strings to grow the index and the atoms several times
+        //
+        auto expected = std::unordered_map<std::string, StringHandle>{ };
+
+        for ( auto index = 0; index < 3000; ++index )
+        {
+            const auto string = "label-" + std::to_string(index % 1000);
+            const auto handle = pool.intern(string);
+
+            if ( auto [entry, inserted] = expected.try_emplace(string, handle) ; !inserted ) {
+                EXPECT_EQ( entry->second, handle );
+            }
+        }
+
+        EXPECT_EQ( pool.size(), 1003 );
+
+        for ( const auto& [string, handle] : expected )
+        {
+            EXPECT_EQ( pool[handle], string );
+            EXPECT_EQ( pool.find(string), handle );
+        }
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( string_pool, bulk_intern )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 14 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<LabelData>(contents.get(), contents_length);
+
+        {
+            auto pool    = StringPool{ root->labels, data };
+            auto strings = std::vector<std::string_view>{ "red", "green", "red", "blue", "green", "red" };
+            auto handles = pool.intern(strings);
+
+            ASSERT_EQ( handles.size(), strings.size() );
+            EXPECT_EQ( pool.size(), 3 );
+            EXPECT_EQ( handles[0], handles[2] );
+            EXPECT_EQ( handles[1], handles[4] );
+            EXPECT_NE( handles[0], handles[3] );
+
+            for ( auto index = size_t{ 0 }; index < strings.size(); ++index ) {
+                EXPECT_EQ( pool[handles[index]], strings[index] );
+            }
+        }
+
+        // • The index is stored in the buffer and used as is
+        //
+        auto copy = std::make_unique<uint8_t[]>(contents_length);
+
+        std::memcpy( copy.get(), contents.get(), contents_length );
+
+        auto copy_data = data_atom(copy.get(), contents_length);
+        auto pool      = StringPool{ detail::contents<LabelData>(copy_data)->labels, copy_data };
+
+        EXPECT_EQ( pool.find("blue"), StringHandle{ 2 } );
+        EXPECT_FALSE( pool.find("violet").has_value() );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
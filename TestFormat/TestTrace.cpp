@@ -0,0 +1,255 @@
+//
+//  TestTrace.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Trace.hpp>
+#include <Data/Vector.hpp>
+
+#include <latch>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • Trace tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct TracedData
+{
+    VectorRef<uint32_t> values;
+};
+
+} // namespace
+
+#if DATA_TRACING
+
+TEST( trace, thread_buffer )
+{
+    auto buffer = trace::ThreadBuffer{ 7 };
+
+    EXPECT_EQ( buffer.thread_id(), 7 );
+    EXPECT_TRUE( buffer.snapshot().empty() );
+
+    buffer.record( "first", 10, 20 );
+    buffer.record( "second", 30, 45 );
+
+    const auto events = buffer.snapshot();
+
+    ASSERT_EQ( events.size(), 2 );
+    EXPECT_STREQ( events[0].name, "first" );
+    EXPECT_EQ( events[0].begin, 10 );
+    EXPECT_EQ( events[1].end, 45 );
+    EXPECT_EQ( buffer.recorded(), 2 );
+}
+
+TEST( trace, thread_buffer_overwrite )
+{
+    auto buffer = trace::ThreadBuffer{ 1 };
+
+    const auto count = uint64_t{ trace::ThreadBuffer::capacity } + 100;
+
+    for ( auto index = uint64_t{ 0 }; index < count; ++index ) {
+        buffer.record( "event", index, index + 1 );
+    }
+
+    // • Only the latest events, oldest first
+    //
+    const auto events = buffer.snapshot();
+
+    ASSERT_EQ( events.size(), trace::ThreadBuffer::capacity );
+    EXPECT_EQ( events.front().begin, 100 );
+    EXPECT_EQ( events.back().begin, count - 1 );
+    EXPECT_EQ( buffer.recorded(), count );
+}
+
+TEST( trace, concurrent_snapshot )
+{
+    auto buffer = trace::ThreadBuffer{ 1 };
+    auto done   = std::atomic<bool>{ false };
+
+    // • Each event has end = begin + 1, so a torn event shows
+    //
+    auto writer = std::thread{ [&] {
+        for ( auto index = uint64_t{ 0 }; index < 8 * trace::ThreadBuffer::capacity; ++index ) {
+            buffer.record( "event", index, index + 1 );
+        }
+
+        done = true;
+    } };
+
+    while ( !done )
+    {
+        const auto events = buffer.snapshot();
+
+        for ( auto index = size_t{ 0 }; index < events.size(); ++index )
+        {
+            ASSERT_EQ( events[index].end, events[index].begin + 1 );
+
+            if ( 0 < index ) {
+                ASSERT_EQ( events[index].begin, events[index - 1].begin + 1 );
+            }
+        }
+    }
+
+    writer.join();
+}
+
+TEST( trace, thread_registration )
+{
+    auto thread = std::thread{ [] {
+
+        // • Events are dropped until the thread is registered
+        //
+        EXPECT_EQ( trace::thread_buffer(), nullptr );
+        {
+            DATA_TRACE_SCOPE("dropped");
+        }
+
+        {
+            DATA_TRACE_THREAD();
+
+            const auto buffer = trace::thread_buffer();
+
+            ASSERT_NE( buffer, nullptr );
+
+            // • Nested registrations keep the first buffer
+            //
+            {
+                DATA_TRACE_THREAD();
+
+                EXPECT_EQ( trace::thread_buffer(), buffer );
+            }
+
+            EXPECT_EQ( trace::thread_buffer(), buffer );
+
+            {
+                DATA_TRACE_SCOPE("recorded");
+            }
+
+            EXPECT_EQ( buffer->recorded(), 1 );
+        }
+
+        EXPECT_EQ( trace::thread_buffer(), nullptr );
+    } };
+
+    thread.join();
+}
+
+TEST( trace, chrome_trace )
+{
+    DATA_TRACE_THREAD();
+
+    {
+        DATA_TRACE_SCOPE("test_scope");
+    }
+
+    // • The other thread stays registered until its events are exported
+    //
+    auto recorded = std::latch{ 1 };
+    auto exported = std::latch{ 1 };
+
+    auto thread = std::thread{ [&] {
+        DATA_TRACE_THREAD();
+        {
+            DATA_TRACE_SCOPE("other_thread");
+        }
+
+        recorded.count_down();
+        exported.wait();
+    } };
+
+    recorded.wait();
+
+    auto stream = std::ostringstream{ };
+
+    trace::write_chrome_trace(stream);
+
+    exported.count_down();
+    thread.join();
+
+    const auto json = stream.str();
+
+    EXPECT_THAT( json, StartsWith( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" ) );
+    EXPECT_THAT( json, EndsWith( "]}\n" ) );
+    EXPECT_THAT( json, HasSubstr( "{\"name\":\"test_scope\",\"cat\":\"data\",\"ph\":\"X\"" ) );
+    EXPECT_THAT( json, HasSubstr( "\"name\":\"other_thread\"" ) );
+    EXPECT_THAT( json, HasSubstr( "\"ph\":\"M\"" ) );
+
+    // • The buffer of a thread is released when it exits
+    //
+    auto after = std::ostringstream{ };
+
+    trace::write_chrome_trace(after);
+
+    EXPECT_THAT( after.str(), Not( HasSubstr( "\"name\":\"other_thread\"" ) ) );
+}
+
+TEST( trace, allocator_tracepoints )
+{
+    DATA_TRACE_THREAD();
+
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<TracedData>(contents.get(), contents_length);
+
+    auto values = Vector<uint32_t>{ root->values, data };
+
+    const auto recorded = trace::thread_buffer()->recorded();
+
+    values.push_back(1);
+    values.insert( values.begin(), 0 );
+
+    // • Vector::reserve, reserve_new and divide for the first push_back, then
+    //   prepare_insert
+    //
+    EXPECT_LE( recorded + 4, trace::thread_buffer()->recorded() );
+    EXPECT_THAT( values, ElementsAre( 0, 1 ) );
+}
+
+#else
+
+TEST( trace, disabled )
+{
+    DATA_TRACE_THREAD();
+    DATA_TRACE_SCOPE("compiled_out");
+
+    auto contents_length = uint32_t{ 4096 };
+    auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+    auto [data, root] = format_for_data<TracedData>(contents.get(), contents_length);
+
+    auto values = Vector<uint32_t>{ root->values, data };
+
+    values.push_back(1);
+    values.insert( values.begin(), 0 );
+
+    EXPECT_THAT( values, ElementsAre( 0, 1 ) );
+}
+
+#endif
@@ -0,0 +1,95 @@
+//
+//  TestVectorView.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <gmock/gmock.h>
+
+#include <Data/Algorithm.hpp>
+#include <Data/VectorView.hpp>
+
+using namespace ::testing;
+using namespace ::data;
+
+//===------------------------------------------------------------------------===
+//
+// • VectorView tests
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+
+struct QueryData
+{
+    VectorRef<float>    values;
+    VectorRef<float>    unused;
+};
+
+} // namespace
+
+static_assert( std::is_nothrow_constructible_v<VectorView<float>, const VectorRef<float>&, const Atom*> );
+static_assert( std::ranges::contiguous_range<VectorView<float>> );
+
+TEST( vector_view, contents )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1 << 12 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+
+        auto [data, root] = format_for_data<QueryData>(contents.get(), contents_length);
+
+        auto values = Vector<float>{ root->values, data };
+
+        values.assign({ 1.0f, 2.0f, 4.0f, 8.0f });
+
+        const auto& const_root = *root;
+
+        auto view = VectorView<float>{ const_root.values, data };
+
+        EXPECT_EQ( view.size(), 4 );
+        EXPECT_EQ( view.data(), values.data() );
+        EXPECT_EQ( view.front(), 1.0f );
+        EXPECT_EQ( view.back(), 8.0f );
+        EXPECT_EQ( view[2], 4.0f );
+        EXPECT_THAT( view, ElementsAre(1.0f, 2.0f, 4.0f, 8.0f) );
+        EXPECT_EQ( data::sum(view), 15.0f );
+
+        // • From the base address, as given to Metal
+        //
+        auto base_view = VectorView<float>{ const_root.values, reinterpret_cast<const uint8_t*>(data) };
+
+        EXPECT_EQ( base_view.span().data(), view.data() );
+
+        std::span<const float> span = base_view;
+
+        EXPECT_EQ( span.size(), 4 );
+
+        // • An unallocated vector is empty
+        //
+        EXPECT_TRUE( VectorView<float>( const_root.unused, data ).empty() );
+
+        EXPECT_TRUE( detail::is_valid_allocation(const_root.values, data) );
+        EXPECT_FALSE( detail::is_valid_allocation( VectorRef<float>{ const_root.values.offset, 1000 }, data ) );
+        EXPECT_FALSE( detail::is_valid_allocation( VectorRef<float>{ 8, 1 }, data ) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
@@ -21,6 +21,8 @@
 
 #include <Data/Vector.hpp>
 
+#include <numeric>
+
 using namespace ::testing;
 using namespace ::data;
 
@@ -40,7 +42,7 @@ TEST( vector, reservation )
 
         EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
 
-        auto ref    = VectorRef<int>{ 0 };
+        auto ref    = VectorRef<int>{ 0, 0 };
         auto vector = Vector<int>{ ref, data };
 
         EXPECT_EQ( vector.size(), 0 );
@@ -279,3 +281,80 @@ TEST( vector, insert )
         FAIL();
     }
 }
+
+TEST( vector, append_uninitialized )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto data            = data::format(contents.get(), contents_length);
+
+        auto ref    = VectorRef<int>{ };
+        auto vector = Vector<int>{ ref, data };
+
+        ASSERT_NO_THROW( vector.assign({ 0, 1, 2 }) );
+
+        auto append = vector.append_uninitialized(7);
+
+        EXPECT_EQ( append.size(), 7 );
+        EXPECT_EQ( append.data(), vector.data() + 3 );
+        EXPECT_EQ( vector.size(), 10 );
+        EXPECT_EQ( vector.capacity(), 12 );
+
+        std::iota( append.begin(), append.end(), 3 );
+
+        auto expected_value = 0;
+
+        for ( auto val : vector )
+        {
+            EXPECT_EQ( val, expected_value++ );
+        }
+
+        EXPECT_TRUE( vector.append_uninitialized(0).empty() );
+        EXPECT_EQ( vector.size(), 10 );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}
+
+TEST( vector, resize_for_overwrite )
+{
+    try
+    {
+        auto contents_length = uint32_t{ 1024 };
+        auto contents        = std::make_unique<uint8_t[]>(contents_length);
+        auto data            = data::format(contents.get(), contents_length);
+
+        auto ref    = VectorRef<int>{ };
+        auto vector = Vector<int>{ ref, data };
+
+        auto contents_span = vector.resize_for_overwrite(17);
+
+        EXPECT_EQ( contents_span.size(), 17 );
+        EXPECT_EQ( contents_span.data(), vector.data() );
+        EXPECT_EQ( vector.size(), 17 );
+        EXPECT_EQ( vector.capacity(), 20 );
+        EXPECT_EQ( ref.count, 17 );
+
+        std::iota( contents_span.begin(), contents_span.end(), 0 );
+
+        // • Shrinking keeps the capacity and the leading elements
+        //
+        contents_span = vector.resize_for_overwrite(5);
+
+        EXPECT_EQ( contents_span.size(), 5 );
+        EXPECT_EQ( vector.capacity(), 20 );
+        EXPECT_EQ( vector.back(), 4 );
+
+        EXPECT_TRUE( validate_layout(contents.get(), contents_length) );
+    }
+    catch ( ... )
+    {
+        FAIL();
+    }
+}